@@ -0,0 +1,89 @@
+#include "../src/lib/base16.h"
+#include "../src/lib/base32.h"
+#include "bench.h"
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+typedef struct base_bench_t {
+	uint8_t binary[64];
+	uint8_t decoded[64];
+	size_t binary_len;
+	char text[128];
+	size_t text_len;
+	int status;
+} base_bench_t;
+
+void base_bench_16_encode(void *arg) {
+	base_bench_t *bench = arg;
+	bench->status = base16_encode(bench->text, bench->text_len, bench->binary, bench->binary_len);
+}
+
+void base_bench_16_decode(void *arg) {
+	base_bench_t *bench = arg;
+	bench->status = base16_decode(bench->decoded, bench->binary_len, bench->text, bench->text_len);
+}
+
+void base_bench_32_encode(void *arg) {
+	base_bench_t *bench = arg;
+	bench->status = base32_encode(bench->text, bench->text_len, bench->binary, bench->binary_len);
+}
+
+void base_bench_32_decode(void *arg) {
+	base_bench_t *bench = arg;
+	bench->status = base32_decode(bench->decoded, bench->binary_len, bench->text, bench->text_len);
+}
+
+int bench_base(void) {
+	base_bench_t *bench = calloc(1, sizeof(*bench));
+	if (bench == NULL) {
+		return 1;
+	}
+	for (uint8_t index = 0; index < sizeof(bench->binary); index++) {
+		bench->binary[index] = (uint8_t)(index * 37 + 11);
+	}
+
+	struct {
+		const char *name;
+		void (*encode)(void *arg);
+		void (*decode)(void *arg);
+		size_t binary_len;
+		size_t text_len;
+	} cases[] = {
+			{"base16.8", &base_bench_16_encode, &base_bench_16_decode, 8, 16},
+			{"base16.64", &base_bench_16_encode, &base_bench_16_decode, 64, 128},
+			{"base32.8", &base_bench_32_encode, &base_bench_32_decode, 8, 13},
+			{"base32.64", &base_bench_32_encode, &base_bench_32_decode, 64, 103},
+	};
+
+	int errors = 0;
+	for (uint8_t index = 0; index < sizeof(cases) / sizeof(*cases); index++) {
+		bench->binary_len = cases[index].binary_len;
+		bench->text_len = cases[index].text_len;
+		memset(bench->decoded, 0, sizeof(bench->decoded));
+
+		cases[index].encode(bench);
+		int encoded = bench->status;
+		cases[index].decode(bench);
+		if (encoded == -1 || bench->status == -1 || memcmp(bench->binary, bench->decoded, bench->binary_len) != 0) {
+			fprintf(stderr, "%s does not round trip\n", cases[index].name);
+			errors++;
+			continue;
+		}
+
+		char label[64];
+		uint64_t start = bench_clock();
+		uint64_t ops = bench_run(cases[index].encode, bench);
+		sprintf(label, "%s_encode", cases[index].name);
+		bench_report(label, ops, bench_clock() - start, ops * bench->binary_len, 0);
+
+		start = bench_clock();
+		ops = bench_run(cases[index].decode, bench);
+		sprintf(label, "%s_decode", cases[index].name);
+		bench_report(label, ops, bench_clock() - start, ops * bench->binary_len, 0);
+	}
+
+	free(bench);
+	return errors;
+}
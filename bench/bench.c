@@ -0,0 +1,66 @@
+#include "bench.h"
+#include "../src/lib/logger.h"
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <unistd.h>
+
+const uint64_t bench_budget = 200000000;
+
+uint64_t bench_clock(void) {
+	struct timespec now;
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	return (uint64_t)now.tv_sec * 1000000000 + (uint64_t)now.tv_nsec;
+}
+
+uint64_t bench_run(void (*op)(void *arg), void *arg) {
+	uint64_t ops = 0;
+	uint64_t batch = 1;
+	uint64_t start = bench_clock();
+	while (bench_clock() - start < bench_budget) {
+		for (uint64_t index = 0; index < batch; index++) {
+			op(arg);
+		}
+		ops += batch;
+		batch *= 2;
+	}
+	return ops;
+}
+
+void bench_report(const char *name, uint64_t ops, uint64_t elapsed, uint64_t bytes, uint64_t rows) {
+	double seconds = (double)elapsed / 1e9;
+	printf("%s ns/op=%.1f", name, (double)elapsed / (double)ops);
+	if (rows > 0) {
+		printf(" rows/s=%.0f", (double)rows / seconds);
+	}
+	if (bytes > 0) {
+		printf(" bytes/s=%.0f", (double)bytes / seconds);
+	}
+	printf("\n");
+}
+
+int main(void) {
+	logger_init();
+	log_level = 2;
+
+	char directory[] = "/tmp/warden-bench-XXXXXX";
+	if (mkdtemp(directory) == NULL) {
+		fprintf(stderr, "failed to create %s\n", directory);
+		return 1;
+	}
+
+	printf("warden version=%s commit=%s\n", version, commit);
+
+	int errors = 0;
+	errors += bench_octet(directory);
+	errors += bench_reading(directory);
+	errors += bench_request();
+	errors += bench_bwt();
+	errors += bench_sha256();
+	errors += bench_hydrate();
+	errors += bench_base();
+
+	rmdir(directory);
+	return errors == 0 ? 0 : 1;
+}
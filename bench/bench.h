@@ -0,0 +1,15 @@
+#pragma once
+
+#include <stdint.h>
+
+uint64_t bench_clock(void);
+uint64_t bench_run(void (*op)(void *arg), void *arg);
+void bench_report(const char *name, uint64_t ops, uint64_t elapsed, uint64_t bytes, uint64_t rows);
+
+int bench_octet(const char *directory);
+int bench_reading(const char *directory);
+int bench_request(void);
+int bench_bwt(void);
+int bench_sha256(void);
+int bench_hydrate(void);
+int bench_base(void);
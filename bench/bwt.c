@@ -0,0 +1,78 @@
+#include "../src/lib/bwt.h"
+#include "bench.h"
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+typedef struct bwt_bench_t {
+	char cookies[4096][108];
+	uint16_t cookie;
+	char token[103];
+	bwt_t bwt;
+	int status;
+} bwt_bench_t;
+
+void bwt_bench_cached(void *arg) {
+	bwt_bench_t *bench = arg;
+	bench->status = bwt_verify(bench->cookies[0], sizeof(bench->cookies[0]), &bench->bwt);
+}
+
+void bwt_bench_cold(void *arg) {
+	bwt_bench_t *bench = arg;
+	bench->cookie = (uint16_t)((bench->cookie + 1) % (sizeof(bench->cookies) / sizeof(*bench->cookies)));
+	bench->status = bwt_verify(bench->cookies[bench->cookie], sizeof(bench->cookies[0]), &bench->bwt);
+}
+
+void bwt_bench_sign(void *arg) {
+	bwt_bench_t *bench = arg;
+	uint8_t id[8] = {0};
+	uint8_t data[8] = {0};
+	bench->status = bwt_sign(&bench->token, &id, &data);
+}
+
+int bench_bwt(void) {
+	bwt_bench_t *bench = calloc(1, sizeof(*bench));
+	if (bench == NULL) {
+		return 1;
+	}
+
+	int errors = 0;
+	for (uint16_t index = 0; index < sizeof(bench->cookies) / sizeof(*bench->cookies); index++) {
+		uint8_t id[8];
+		uint8_t data[8];
+		memcpy(id, (uint64_t[]){index}, sizeof(id));
+		memset(data, 0xff, sizeof(data));
+		if (bwt_sign(&bench->token, &id, &data) == -1) {
+			fprintf(stderr, "failed to sign bwt %hu\n", index);
+			errors++;
+			goto cleanup;
+		}
+		memcpy(bench->cookies[index], "auth=", 5);
+		memcpy(&bench->cookies[index][5], bench->token, sizeof(bench->token));
+	}
+
+	bwt_bench_cached(bench);
+	if (bench->status != 0) {
+		fprintf(stderr, "bwt_verify rejected a freshly signed token\n");
+		errors++;
+		goto cleanup;
+	}
+
+	uint64_t start = bench_clock();
+	uint64_t ops = bench_run(&bwt_bench_sign, bench);
+	bench_report("bwt_sign", ops, bench_clock() - start, 0, 0);
+
+	bwt_bench_cached(bench);
+	start = bench_clock();
+	ops = bench_run(&bwt_bench_cached, bench);
+	bench_report("bwt_verify.cached", ops, bench_clock() - start, 0, 0);
+
+	start = bench_clock();
+	ops = bench_run(&bwt_bench_cold, bench);
+	bench_report("bwt_verify.cold", ops, bench_clock() - start, 0, 0);
+
+cleanup:
+	free(bench);
+	return errors;
+}
@@ -0,0 +1,75 @@
+#include "../src/app/assemble.h"
+#include "../src/app/file.h"
+#include "../src/app/hydrate.h"
+#include "../src/app/page.h"
+#include "bench.h"
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+typedef struct hydrate_bench_t {
+	file_t *page;
+	file_t scratch;
+	class_t classes[1024];
+	uint16_t classes_len;
+	int status;
+} hydrate_bench_t;
+
+void hydrate_bench_page(void *arg) {
+	hydrate_bench_t *bench = arg;
+	bench->scratch.ptr = malloc(bench->page->len);
+	if (bench->scratch.ptr == NULL) {
+		bench->status = -1;
+		return;
+	}
+	memcpy(bench->scratch.ptr, bench->page->ptr, bench->page->len);
+	bench->scratch.len = bench->page->len;
+	bench->classes_len = 0;
+	bench->status = extract(&bench->scratch, &bench->classes, &bench->classes_len);
+	if (bench->status == 0) {
+		bench->status = hydrate(&bench->scratch, &bench->classes, &bench->classes_len);
+	}
+	free(bench->scratch.ptr);
+	bench->scratch.ptr = NULL;
+}
+
+int bench_hydrate(void) {
+	hydrate_bench_t *bench = calloc(1, sizeof(*bench));
+	if (bench == NULL) {
+		return 1;
+	}
+
+	page_init();
+
+	int errors = 0;
+	file_t *targets[] = {&page_home, &page_devices, &page_device_readings, &page_signin};
+	for (uint8_t index = 0; index < sizeof(targets) / sizeof(*targets); index++) {
+		bench->page = targets[index];
+		if (file(bench->page) == -1 || assemble(bench->page) == -1) {
+			fprintf(stderr, "failed to assemble %s\n", bench->page->path);
+			errors++;
+			continue;
+		}
+		bench->scratch.path = bench->page->path;
+
+		hydrate_bench_page(bench);
+		if (bench->status != 0) {
+			fprintf(stderr, "failed to hydrate %s\n", bench->page->path);
+			errors++;
+			continue;
+		}
+
+		const char *base = strrchr(bench->page->path, '/') + 1;
+		char label[64];
+		uint64_t start = bench_clock();
+		uint64_t ops = bench_run(&hydrate_bench_page, bench);
+		sprintf(label, "hydrate.%.*s", (int)strcspn(base, "."), base);
+		bench_report(label, ops, bench_clock() - start, ops * bench->page->len, 0);
+	}
+
+	page_close();
+	page_free();
+	free(bench);
+	return errors;
+}
@@ -0,0 +1,92 @@
+#include "../src/lib/octet.h"
+#include "bench.h"
+#include <fcntl.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+typedef struct octet_bench_t {
+	octet_stmt_t stmt;
+	char file[64];
+	uint8_t table[12 * 64];
+	off_t offset;
+	off_t size;
+	int64_t sink;
+} octet_bench_t;
+
+void octet_bench_read_all(void *arg) {
+	octet_bench_t *bench = arg;
+	if (bench->offset + (off_t)sizeof(bench->table) > bench->size) {
+		bench->offset = 0;
+	}
+	octet_row_read_all(&bench->stmt, bench->file, bench->offset, bench->table, 12, 64);
+	bench->offset += (off_t)sizeof(bench->table);
+}
+
+void octet_bench_uint(void *arg) {
+	octet_bench_t *bench = arg;
+	for (uint8_t index = 0; index < 64; index++) {
+		uint8_t *row = &bench->table[index * 12];
+		bench->sink += octet_uint16_read(row, 2) + octet_uint32_read(row, 0) + (int64_t)octet_uint64_read(row, 4);
+	}
+}
+
+void octet_bench_int(void *arg) {
+	octet_bench_t *bench = arg;
+	for (uint8_t index = 0; index < 64; index++) {
+		uint8_t *row = &bench->table[index * 12];
+		bench->sink += octet_int16_read(row, 0) + octet_int32_read(row, 0) + octet_int64_read(row, 4);
+	}
+}
+
+int bench_octet(const char *directory) {
+	octet_bench_t *bench = calloc(1, sizeof(*bench));
+	if (bench == NULL) {
+		return 1;
+	}
+
+	int errors = 0;
+	sprintf(bench->file, "%s/octet.data", directory);
+	FILE *file = fopen(bench->file, "w");
+	if (file == NULL) {
+		fprintf(stderr, "failed to create %s\n", bench->file);
+		free(bench);
+		return 1;
+	}
+	for (uint32_t index = 0; index < 65536; index++) {
+		uint8_t row[12];
+		octet_int16_write(row, 0, (int16_t)(index % 4000 - 1000));
+		octet_uint16_write(row, 2, (uint16_t)(index % 1000));
+		octet_uint64_write(row, 4, 1700000000 + index);
+		fwrite(row, sizeof(row), 1, file);
+	}
+	fclose(file);
+
+	if (octet_open(&bench->stmt, bench->file, O_RDONLY, F_RDLCK) == -1) {
+		fprintf(stderr, "failed to open %s\n", bench->file);
+		errors++;
+		goto cleanup;
+	}
+	bench->size = bench->stmt.stat.st_size;
+
+	uint64_t start = bench_clock();
+	uint64_t ops = bench_run(&octet_bench_read_all, bench);
+	bench_report("octet_row_read_all.64x12", ops, bench_clock() - start, ops * sizeof(bench->table), ops * 64);
+
+	start = bench_clock();
+	ops = bench_run(&octet_bench_uint, bench);
+	bench_report("octet_uint_read.64x3", ops, bench_clock() - start, 0, ops * 64);
+
+	start = bench_clock();
+	ops = bench_run(&octet_bench_int, bench);
+	bench_report("octet_int_read.64x3", ops, bench_clock() - start, 0, ops * 64);
+
+	octet_close(&bench->stmt, bench->file);
+
+cleanup:
+	unlink(bench->file);
+	free(bench);
+	return errors;
+}
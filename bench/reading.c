@@ -0,0 +1,119 @@
+#include "../src/api/device.h"
+#include "../src/api/reading.h"
+#include "../src/lib/arena.h"
+#include "../src/lib/base16.h"
+#include "../src/lib/config.h"
+#include "../src/lib/octet.h"
+#include "../src/lib/response.h"
+#include "bench.h"
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+typedef struct reading_bench_t {
+	octet_t db;
+	device_t device;
+	uint8_t id[8];
+	reading_query_t query;
+	response_t response;
+	char *buffer;
+	uint8_t arena[4096];
+	uint16_t readings_len;
+	uint16_t status;
+} reading_bench_t;
+
+void reading_bench_select(void *arg) {
+	reading_bench_t *bench = arg;
+	arena_reset(&bench->db.arena);
+	response_init(&bench->response, bench->buffer);
+	bench->readings_len = 0;
+	bench->status = reading_select_by_device(&bench->db, &bench->device, &bench->query, &bench->response, &bench->readings_len);
+}
+
+int reading_bench_seed(const char *file, uint32_t rows, time_t first) {
+	FILE *data = fopen(file, "w");
+	if (data == NULL) {
+		return -1;
+	}
+
+	uint8_t chunk[12 * 4096];
+	uint32_t index = 0;
+	while (index < rows) {
+		uint16_t chunk_len = 0;
+		while (chunk_len < 4096 && index < rows) {
+			uint8_t *row = &chunk[chunk_len * reading_row.size];
+			octet_int16_write(row, reading_row.temperature, (int16_t)(index % 4000 - 1000));
+			octet_uint16_write(row, reading_row.humidity, (uint16_t)(index % 1000));
+			octet_uint64_write(row, reading_row.captured_at, (uint64_t)first + index);
+			chunk_len++;
+			index++;
+		}
+		if (fwrite(chunk, reading_row.size, chunk_len, data) != chunk_len) {
+			fclose(data);
+			return -1;
+		}
+	}
+
+	return fclose(data);
+}
+
+int bench_reading(const char *directory) {
+	reading_bench_t *bench = calloc(1, sizeof(*bench));
+	if (bench == NULL) {
+		return 1;
+	}
+	bench->buffer = malloc(send_buffer);
+	if (bench->buffer == NULL) {
+		free(bench);
+		return 1;
+	}
+
+	bench->db.directory = directory;
+	arena_init(&bench->db.arena, bench->arena, sizeof(bench->arena));
+	for (uint8_t index = 0; index < sizeof(bench->id); index++) {
+		bench->id[index] = (uint8_t)(0xa0 + index);
+	}
+	bench->device.id = &bench->id;
+
+	char uuid[16];
+	char folder[128];
+	char file[160];
+	base16_encode(uuid, sizeof(uuid), bench->id, sizeof(bench->id));
+	sprintf(folder, "%s/%.*s", directory, (int)sizeof(uuid), uuid);
+	sprintf(file, "%s/%s.data", folder, reading_file);
+	mkdir(folder, 0755);
+
+	int errors = 0;
+	const time_t first = 1700000000;
+	const uint32_t sizes[] = {10000, 100000, 1000000, 10000000};
+	for (uint8_t size = 0; size < sizeof(sizes) / sizeof(*sizes); size++) {
+		if (reading_bench_seed(file, sizes[size], first) == -1) {
+			fprintf(stderr, "failed to seed %u readings into %s\n", sizes[size], file);
+			errors++;
+			break;
+		}
+
+		bench->query = (reading_query_t){.from = first, .to = first + sizes[size], .bucket = 3600};
+		reading_bench_select(bench);
+		if (bench->status != 0 || bench->readings_len == 0) {
+			fprintf(stderr, "reading_select_by_device returned %hu with %hu readings for %u rows\n", bench->status,
+							bench->readings_len, sizes[size]);
+			errors++;
+			continue;
+		}
+
+		char label[64];
+		uint64_t start = bench_clock();
+		uint64_t ops = bench_run(&reading_bench_select, bench);
+		sprintf(label, "reading_select_by_device.%u", sizes[size]);
+		bench_report(label, ops, bench_clock() - start, ops * sizes[size] * reading_row.size, ops * sizes[size]);
+	}
+
+	unlink(file);
+	rmdir(folder);
+	free(bench->buffer);
+	free(bench);
+	return errors;
+}
@@ -0,0 +1,115 @@
+#include "../src/api/router.h"
+#include "../src/lib/config.h"
+#include "../src/lib/request.h"
+#include "../src/lib/response.h"
+#include "bench.h"
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+typedef struct request_bench_t {
+	char buffer[1024];
+	size_t buffer_len;
+	request_t request;
+	response_t response;
+	char *response_buffer;
+	const char *pathname;
+	const route_t *found;
+} request_bench_t;
+
+void request_bench_parse(void *arg) {
+	request_bench_t *bench = arg;
+	request_init(&bench->request);
+	bench->response.status = 0;
+	request(bench->buffer, bench->buffer_len, &bench->request, &bench->response);
+}
+
+void request_bench_route(void *arg) {
+	request_bench_t *bench = arg;
+	bool pathname_found = false;
+	bench->found = route_find(&bench->request, &pathname_found);
+}
+
+int bench_request(void) {
+	request_bench_t *bench = calloc(1, sizeof(*bench));
+	if (bench == NULL) {
+		return 1;
+	}
+	bench->response_buffer = malloc(send_buffer);
+	if (bench->response_buffer == NULL) {
+		free(bench);
+		return 1;
+	}
+	response_init(&bench->response, bench->response_buffer);
+
+	int errors = 0;
+	if (route_init() == -1) {
+		errors++;
+		goto cleanup;
+	}
+
+	const char *requests[] = {
+			"GET / HTTP/1.1\r\nHost: localhost\r\n\r\n",
+			"GET /api/device/0123456789abcdef/readings?from=1700000000&to=1700086400&bucket=600 HTTP/1.1\r\n"
+			"Host: localhost:2254\r\nUser-Agent: Mozilla/5.0 (X11; Linux x86_64; rv:128.0) Gecko/20100101 Firefox/128.0\r\n"
+			"Accept: */*\r\nAccept-Language: en-US,en;q=0.5\r\nAccept-Encoding: gzip, deflate, br, zstd\r\n"
+			"Referer: http://localhost:2254/device/0123456789abcdef/readings\r\nConnection: keep-alive\r\n"
+			"Cookie: auth=ABCDEFGHIJKLMNOPQRSTUVWXYZ234567ABCDEFGHIJKLMNOPQRSTUVWXYZ234567ABCDEFGHIJKLMNOPQRSTUVWXYZ234567ABCD\r\n"
+			"Sec-Fetch-Dest: empty\r\nSec-Fetch-Mode: cors\r\nSec-Fetch-Site: same-origin\r\n\r\n",
+			"POST /api/uplink HTTP/1.1\r\nHost: localhost\r\nContent-Type: application/octet-stream\r\nContent-Length: 16\r\n\r\n"
+			"\x01\x23\x45\x67\x89\xab\xcd\xef\x10\x11\x12\x13\x14\x15\x16\x17",
+	};
+	const char *labels[] = {"small", "browser", "uplink"};
+	for (uint8_t index = 0; index < sizeof(requests) / sizeof(*requests); index++) {
+		bench->buffer_len = strlen(requests[index]);
+		memcpy(bench->buffer, requests[index], bench->buffer_len);
+
+		request_bench_parse(bench);
+		if (bench->response.status != 0) {
+			fprintf(stderr, "request %s failed to parse with %hu\n", labels[index], bench->response.status);
+			errors++;
+			continue;
+		}
+
+		char label[64];
+		uint64_t start = bench_clock();
+		uint64_t ops = bench_run(&request_bench_parse, bench);
+		sprintf(label, "request.%s", labels[index]);
+		bench_report(label, ops, bench_clock() - start, ops * bench->buffer_len, 0);
+	}
+
+	const char *pathnames[] = {
+			"/",
+			"/api/devices",
+			"/api/device/0123456789abcdef/readings",
+			"/api/zone/0123456789abcdef/signals",
+			"/api/nope",
+	};
+	const char *pathname_labels[] = {"root", "static", "param", "param_deep", "miss"};
+	bench->request.method.ptr = "get";
+	bench->request.method.len = 3;
+	for (uint8_t index = 0; index < sizeof(pathnames) / sizeof(*pathnames); index++) {
+		bench->request.pathname.ptr = (char *)pathnames[index];
+		bench->request.pathname.len = (uint8_t)strlen(pathnames[index]);
+
+		request_bench_route(bench);
+		if ((bench->found == NULL) != (index == 4)) {
+			fprintf(stderr, "route_find resolved %s unexpectedly\n", pathnames[index]);
+			errors++;
+			continue;
+		}
+
+		char label[64];
+		uint64_t start = bench_clock();
+		uint64_t ops = bench_run(&request_bench_route, bench);
+		sprintf(label, "route_find.%s", pathname_labels[index]);
+		bench_report(label, ops, bench_clock() - start, 0, 0);
+	}
+
+cleanup:
+	free(bench->response_buffer);
+	free(bench);
+	return errors;
+}
@@ -0,0 +1,141 @@
+#include "../src/lib/sha256.h"
+#include "bench.h"
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(__aarch64__)
+#include <sys/auxv.h>
+#endif
+
+typedef struct sha256_bench_t {
+	uint8_t data[65536];
+	size_t data_len;
+	const uint8_t *messages[64];
+	size_t messages_len[64];
+	uint8_t hashes[64][32];
+} sha256_bench_t;
+
+void sha256_bench_one(void *arg) {
+	sha256_bench_t *bench = arg;
+	sha256(bench->data, bench->data_len, &bench->hashes[0]);
+}
+
+void sha256_bench_hmac(void *arg) {
+	sha256_bench_t *bench = arg;
+	sha256_hmac((const uint8_t *)"w77a61r72d64e65n6e", 18, bench->data, bench->data_len, &bench->hashes[0]);
+}
+
+void sha256_bench_many(void *arg) {
+	sha256_bench_t *bench = arg;
+	sha256_many(bench->messages, bench->messages_len, bench->hashes, 64);
+}
+
+int bench_sha256(void) {
+	sha256_bench_t *bench = malloc(sizeof(*bench));
+	if (bench == NULL) {
+		return 1;
+	}
+	for (size_t index = 0; index < sizeof(bench->data); index++) {
+		bench->data[index] = (uint8_t)(index * 31 + 7);
+	}
+
+	struct {
+		const char *name;
+		void (*compress)(uint32_t (*state)[8], const uint8_t *data, size_t blocks);
+	} backends[3] = {{"scalar", &sha256_compress_scalar}};
+	uint8_t backends_len = 1;
+#if defined(__x86_64__)
+	if (__builtin_cpu_supports("sha") && __builtin_cpu_supports("sse4.1")) {
+		backends[backends_len].name = "shani";
+		backends[backends_len].compress = &sha256_compress_shani;
+		backends_len++;
+	}
+#endif
+#if defined(__aarch64__)
+	if (getauxval(AT_HWCAP) & HWCAP_SHA2) {
+		backends[backends_len].name = "armv8";
+		backends[backends_len].compress = &sha256_compress_armv8;
+		backends_len++;
+	}
+#endif
+
+	int errors = 0;
+	const size_t sizes[] = {32, 64, 1024, 65536};
+	for (uint8_t size = 0; size < sizeof(sizes) / sizeof(*sizes); size++) {
+		bench->data_len = sizes[size];
+
+		uint8_t reference[32];
+		for (uint8_t backend = 0; backend < backends_len; backend++) {
+			sha256_compress = backends[backend].compress;
+			sha256(bench->data, bench->data_len, &bench->hashes[0]);
+			if (backend == 0) {
+				memcpy(reference, bench->hashes[0], sizeof(reference));
+			} else if (memcmp(reference, bench->hashes[0], sizeof(reference)) != 0) {
+				fprintf(stderr, "sha256 %s differs from scalar for %zu bytes\n", backends[backend].name, bench->data_len);
+				errors++;
+				continue;
+			}
+
+			char name[64];
+			uint64_t start = bench_clock();
+			uint64_t ops = bench_run(&sha256_bench_one, bench);
+			sprintf(name, "sha256.%s.%zu", backends[backend].name, bench->data_len);
+			bench_report(name, ops, bench_clock() - start, ops * bench->data_len, 0);
+
+			start = bench_clock();
+			ops = bench_run(&sha256_bench_hmac, bench);
+			sprintf(name, "sha256_hmac.%s.%zu", backends[backend].name, bench->data_len);
+			bench_report(name, ops, bench_clock() - start, ops * bench->data_len, 0);
+		}
+	}
+
+	for (uint8_t index = 0; index < 64; index++) {
+		bench->messages[index] = &bench->data[index * 97];
+		bench->messages_len[index] = 8 + (size_t)index * 3;
+	}
+
+	struct {
+		const char *name;
+		void (*many)(const uint8_t *const *data, const size_t *data_len, uint8_t (*hashes)[32], size_t count);
+	} lanes[2] = {{"scalar", &sha256_many_scalar}};
+	uint8_t lanes_len = 1;
+#if defined(__x86_64__)
+	if (__builtin_cpu_supports("avx2")) {
+		lanes[lanes_len].name = "avx2";
+		lanes[lanes_len].many = &sha256_many_avx2;
+		lanes_len++;
+	}
+#endif
+
+	sha256_compress = &sha256_compress_scalar;
+	uint8_t expected[64][32];
+	for (uint8_t index = 0; index < 64; index++) {
+		sha256(bench->messages[index], bench->messages_len[index], &expected[index]);
+	}
+
+	uint64_t bytes = 0;
+	for (uint8_t index = 0; index < 64; index++) {
+		bytes += bench->messages_len[index];
+	}
+
+	for (uint8_t lane = 0; lane < lanes_len; lane++) {
+		sha256_many = lanes[lane].many;
+		sha256_many(bench->messages, bench->messages_len, bench->hashes, 64);
+		if (memcmp(expected, bench->hashes, sizeof(expected)) != 0) {
+			fprintf(stderr, "sha256_many %s differs from scalar\n", lanes[lane].name);
+			errors++;
+			continue;
+		}
+
+		char name[64];
+		uint64_t start = bench_clock();
+		uint64_t ops = bench_run(&sha256_bench_many, bench);
+		sprintf(name, "sha256_many.%s.64x", lanes[lane].name);
+		bench_report(name, ops * 64, bench_clock() - start, ops * bytes, 0);
+	}
+
+	free(bench);
+	return errors;
+}
@@ -0,0 +1,126 @@
+#include "../src/lib/config.h"
+#include "load.h"
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+char load_cookie[128] = "";
+
+int load_connect(void) {
+	int sock = socket(AF_INET, SOCK_STREAM, 0);
+	if (sock == -1) {
+		return -1;
+	}
+
+	struct sockaddr_in addr;
+	memset(&addr, 0, sizeof(addr));
+	addr.sin_family = AF_INET;
+	addr.sin_port = htons(port);
+	if (inet_pton(AF_INET, address, &addr.sin_addr) != 1) {
+		close(sock);
+		return -1;
+	}
+
+	if (connect(sock, (struct sockaddr *)&addr, sizeof(addr)) == -1) {
+		close(sock);
+		return -1;
+	}
+
+	setsockopt(sock, IPPROTO_TCP, TCP_NODELAY, &(int){1}, sizeof(int));
+	return sock;
+}
+
+int load_fetch(const char *method, const char *path, const void *body, size_t body_len, uint16_t *status, char *head,
+							 size_t head_len) {
+	char buffer[1024];
+	int len = snprintf(buffer, sizeof(buffer), "%s %s HTTP/1.1\r\nhost:%s:%hu\r\n%s%s%s", method, path, address, port,
+										 load_cookie[0] == '\0' ? "" : "cookie:", load_cookie, load_cookie[0] == '\0' ? "" : "\r\n");
+	if (body_len > 0) {
+		len += snprintf(&buffer[len], sizeof(buffer) - (size_t)len, "content-length:%zu\r\n", body_len);
+	}
+	len += snprintf(&buffer[len], sizeof(buffer) - (size_t)len, "\r\n");
+	if ((size_t)len + body_len >= sizeof(buffer)) {
+		return -1;
+	}
+	memcpy(&buffer[len], body, body_len);
+	len += (int)body_len;
+
+	int sock = load_connect();
+	if (sock == -1) {
+		return -1;
+	}
+
+	ssize_t sent = 0;
+	while (sent < len) {
+		ssize_t bytes = send(sock, &buffer[sent], (size_t)(len - sent), MSG_NOSIGNAL);
+		if (bytes <= 0) {
+			close(sock);
+			return -1;
+		}
+		sent += bytes;
+	}
+
+	size_t received = 0;
+	char chunk[16384];
+	while (true) {
+		ssize_t bytes = recv(sock, chunk, sizeof(chunk), 0);
+		if (bytes == -1) {
+			close(sock);
+			return -1;
+		}
+		if (bytes == 0) {
+			break;
+		}
+		if (head != NULL && received < head_len - 1) {
+			size_t copy = (size_t)bytes < head_len - 1 - received ? (size_t)bytes : head_len - 1 - received;
+			memcpy(&head[received], chunk, copy);
+			head[received + copy] = '\0';
+		}
+		if (received == 0) {
+			*status = bytes >= 12 && memcmp(chunk, "HTTP/1.1 ", 9) == 0 ? (uint16_t)atoi(&chunk[9]) : 0;
+		}
+		received += (size_t)bytes;
+	}
+
+	close(sock);
+	return received == 0 ? -1 : 0;
+}
+
+int load_signin(const char *user, const char *password) {
+	char body[160];
+	int body_len = snprintf(body, sizeof(body), "%s%c%s%c", user, '\0', password, '\0');
+
+	char head[1024];
+	uint16_t status = 0;
+	if (load_fetch("POST", "/api/signin", body, (size_t)body_len, &status, head, sizeof(head)) == -1) {
+		fprintf(stderr, "failed to reach warden on %s:%hu\n", address, port);
+		return -1;
+	}
+	if (status != 201 && status != 200) {
+		fprintf(stderr, "signin as %s failed with status %hu\n", user, status);
+		return -1;
+	}
+
+	const char *cookie = strstr(head, "set-cookie:");
+	if (cookie == NULL) {
+		fprintf(stderr, "signin as %s did not set a cookie\n", user);
+		return -1;
+	}
+	cookie += strlen("set-cookie:");
+	while (*cookie == ' ') {
+		cookie++;
+	}
+	size_t cookie_len = strcspn(cookie, ";\r\n");
+	if (cookie_len >= sizeof(load_cookie)) {
+		return -1;
+	}
+	memcpy(load_cookie, cookie, cookie_len);
+	load_cookie[cookie_len] = '\0';
+	return 0;
+}
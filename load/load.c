@@ -0,0 +1,432 @@
+#include "load.h"
+#include "../src/api/device.h"
+#include "../src/api/router.h"
+#include "../src/api/user-zone.h"
+#include "../src/api/user.h"
+#include "../src/lib/base16.h"
+#include "../src/lib/base32.h"
+#include "../src/lib/config.h"
+#include "../src/lib/endian.h"
+#include "../src/lib/logger.h"
+#include "../src/lib/octet.h"
+#include "../src/lib/stats.h"
+#include <errno.h>
+#include <pthread.h>
+#include <signal.h>
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+const char *load_user = "alice";
+const char *load_password = ".go4Alice";
+uint16_t load_devices_max = 16;
+uint32_t load_rate = 100;
+uint8_t load_gateways = 4;
+uint8_t load_dashboards = 2;
+uint32_t load_dashboard_rate = 20;
+uint16_t load_duration = 10;
+bool load_open_loop = true;
+
+target_t targets[5] = {{.name = "uplink"}, {.name = "readings"}, {.name = "zone"}, {.name = "zone_readings"}, {.name = "uplinks"}};
+
+uint8_t (*load_devices)[8] = NULL;
+uint16_t load_devices_len = 0;
+uint16_t *load_frames = NULL;
+uint8_t (*load_zones)[8] = NULL;
+uint16_t load_zones_len = 0;
+
+uint64_t load_started = 0;
+uint64_t load_deadline = 0;
+atomic_bool load_stopping = false;
+atomic_bool load_denied = false;
+
+void load_stop(int sig) {
+	(void)sig;
+	atomic_store_explicit(&load_stopping, true, memory_order_relaxed);
+}
+
+uint64_t load_clock(void) {
+	struct timespec now;
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	return (uint64_t)now.tv_sec * 1000000000 + (uint64_t)now.tv_nsec;
+}
+
+uint64_t load_random(uint64_t *state) {
+	*state ^= *state >> 12;
+	*state ^= *state << 25;
+	*state ^= *state >> 27;
+	return *state * 2685821657736338717lu;
+}
+
+void load_sleep(uint64_t until) {
+	struct timespec wake = {.tv_sec = (time_t)(until / 1000000000), .tv_nsec = (long)(until % 1000000000)};
+	while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &wake, NULL) == EINTR) {
+		if (atomic_load_explicit(&load_stopping, memory_order_relaxed) == true) {
+			return;
+		}
+	}
+}
+
+void load_record(target_t *target, int result, uint16_t status, uint64_t latency) {
+	if (result == -1) {
+		atomic_fetch_add_explicit(&target->failed, 1, memory_order_relaxed);
+		return;
+	}
+	atomic_fetch_add_explicit(&target->statuses[status >= 100 && status < 600 ? status / 100 - 1 : 4], 1, memory_order_relaxed);
+	uint64_t micros = latency / 1000;
+	atomic_fetch_add_explicit(&target->latency.buckets[histogram_bucket(micros)], 1, memory_order_relaxed);
+	atomic_fetch_add_explicit(&target->latency.count, 1, memory_order_relaxed);
+	atomic_fetch_add_explicit(&target->latency.sum, micros, memory_order_relaxed);
+	stats_max(&target->latency.max, micros);
+}
+
+uint8_t load_step(worker_t *worker, char (*path)[192]) {
+	time_t now = time(NULL);
+	uint8_t target = (uint8_t)(1 + worker->cursor % 4);
+	char uuid[17] = "";
+	if (load_zones_len > 0) {
+		base16_encode(uuid, sizeof(uuid) - 1, load_zones[load_random(&worker->state) % load_zones_len], 8);
+	} else if (target == 2 || target == 3) {
+		target = 1;
+	}
+
+	switch (target) {
+	case 1:
+		sprintf(*path, "/api/readings?from=%lu&to=%lu&bucket=600", now - 86400, now);
+		break;
+	case 2:
+		sprintf(*path, "/api/zone/%s", uuid);
+		break;
+	case 3:
+		sprintf(*path, "/api/zone/%s/readings?from=%lu&to=%lu&bucket=600", uuid, now - 86400, now);
+		break;
+	case 4:
+		sprintf(*path, "/api/uplinks?limit=16&offset=%u", (worker->cursor / 4 % 16) * 16);
+		break;
+	}
+	worker->cursor++;
+	return target;
+}
+
+void *load_work(void *arg) {
+	worker_t *worker = arg;
+	uint16_t device = worker->index;
+	uint64_t intended = load_started + (uint64_t)(worker->interval * 1e9 * (double)worker->index / (double)load_gateways);
+
+	while (atomic_load_explicit(&load_stopping, memory_order_relaxed) == false) {
+		if (load_open_loop == true) {
+			load_sleep(intended);
+		}
+		uint64_t sent = load_clock();
+		if (sent >= load_deadline) {
+			break;
+		}
+
+		int result;
+		uint16_t status = 0;
+		uint8_t target;
+		if (worker->gateway == true) {
+			uint8_t body[64];
+			uint8_t kind = uplink_kind(&worker->state);
+			uint8_t body_len = uplink_body(&body, kind, &load_devices[device], load_frames[device]++, time(NULL), &worker->state);
+			device = (uint16_t)(device + load_gateways);
+			if (device >= load_devices_len) {
+				device = worker->index;
+			}
+			target = 0;
+			result = load_fetch("POST", "/api/uplink", body, body_len, &status, NULL, 0);
+			if (result != -1 && (status == 401 || status == 403)) {
+				if (atomic_exchange_explicit(&load_denied, true, memory_order_relaxed) == false) {
+					fprintf(stderr, "uplink as %s was rejected with status %hu\n", load_user, status);
+				}
+				load_stop(0);
+				break;
+			}
+		} else {
+			char path[192];
+			target = load_step(worker, &path);
+			result = load_fetch("GET", path, NULL, 0, &status, NULL, 0);
+		}
+		uint64_t done = load_clock();
+
+		load_record(&targets[target], result, status, done - (load_open_loop == true ? intended : sent));
+		intended += (uint64_t)(worker->interval * 1e9);
+		if (load_open_loop == false) {
+			load_sleep(done + (uint64_t)(worker->interval * 1e9));
+		}
+	}
+
+	return NULL;
+}
+
+uint8_t *load_file(const char *file, size_t *len) {
+	char path[128];
+	sprintf(path, "%s/%s.data", database_directory, file);
+	FILE *data = fopen(path, "r");
+	if (data == NULL) {
+		fprintf(stderr, "failed to open %s\n", path);
+		return NULL;
+	}
+	fseek(data, 0, SEEK_END);
+	long size = ftell(data);
+	fseek(data, 0, SEEK_SET);
+	uint8_t *ptr = malloc(size > 0 ? (size_t)size : 1);
+	if (ptr == NULL || fread(ptr, 1, (size_t)size, data) != (size_t)size) {
+		fprintf(stderr, "failed to read %s\n", path);
+		free(ptr);
+		fclose(data);
+		return NULL;
+	}
+	fclose(data);
+	*len = (size_t)size;
+	return ptr;
+}
+
+int load_grant(void) {
+	size_t users_len;
+	uint8_t *users = load_file(user_file, &users_len);
+	if (users == NULL) {
+		return -1;
+	}
+
+	uint8_t id[8];
+	uint8_t permissions[8];
+	bool found = false;
+	size_t user_len = strlen(load_user);
+	for (size_t index = 0; index < users_len / user_row.size && found == false; index++) {
+		uint8_t *row = &users[index * user_row.size];
+		if (row[user_row.username_len] == user_len && memcmp(&row[user_row.username], load_user, user_len) == 0) {
+			memcpy(id, &row[user_row.id], sizeof(id));
+			memcpy(permissions, &row[user_row.permissions], sizeof(permissions));
+			found = true;
+		}
+	}
+	free(users);
+	if (found == false) {
+		fprintf(stderr, "user %s not found in %s\n", load_user, database_directory);
+		return -1;
+	}
+
+	uint64_t granted;
+	memcpy(&granted, permissions, sizeof(granted));
+	granted = ntoh64(granted);
+	if ((granted & permission_uplink_create) == permission_uplink_create) {
+		return 0;
+	}
+	granted = hton64(granted | permission_uplink_create);
+	memcpy(permissions, &granted, sizeof(permissions));
+
+	uint8_t row[255];
+	octet_t db = {.directory = database_directory, .row = row, .row_len = sizeof(row)};
+	user_t user = {.id = &id, .permissions = &permissions};
+	if (user_update_permissions(&db, &user) != 0) {
+		fprintf(stderr, "failed to grant uplink create to %s\n", load_user);
+		return -1;
+	}
+	fprintf(stderr, "granted uplink create to %s in %s\n", load_user, database_directory);
+	return 0;
+}
+
+int load_catalog(void) {
+	size_t devices_len;
+	uint8_t *devices = load_file(device_file, &devices_len);
+	if (devices == NULL) {
+		return -1;
+	}
+	load_devices_len = (uint16_t)(devices_len / device_row.size < load_devices_max ? devices_len / device_row.size : load_devices_max);
+	load_devices = malloc(load_devices_len * sizeof(*load_devices) + 1);
+	load_frames = calloc(load_devices_len + 1, sizeof(*load_frames));
+	if (load_devices == NULL || load_frames == NULL) {
+		free(devices);
+		return -1;
+	}
+	for (uint16_t index = 0; index < load_devices_len; index++) {
+		memcpy(load_devices[index], &devices[index * device_row.size + device_row.id], sizeof(*load_devices));
+	}
+	free(devices);
+
+	uint8_t token[64];
+	const char *auth = strchr(load_cookie, '=');
+	if (auth == NULL || base32_decode(token, sizeof(token), auth + 1, strlen(auth + 1)) == -1) {
+		fprintf(stderr, "failed to decode user from cookie\n");
+		return -1;
+	}
+
+	size_t user_zones_len;
+	uint8_t *user_zones = load_file(user_zone_file, &user_zones_len);
+	if (user_zones == NULL) {
+		return -1;
+	}
+	load_zones = malloc(user_zones_len / user_zone_row.size * sizeof(*load_zones) + 1);
+	if (load_zones == NULL) {
+		free(user_zones);
+		return -1;
+	}
+	for (size_t index = 0; index < user_zones_len / user_zone_row.size; index++) {
+		uint8_t *row = &user_zones[index * user_zone_row.size];
+		if (memcmp(&row[user_zone_row.user_id], token, 8) == 0) {
+			memcpy(load_zones[load_zones_len++], &row[user_zone_row.zone_id], sizeof(*load_zones));
+		}
+	}
+	free(user_zones);
+	return 0;
+}
+
+void load_report(const char *target_name, target_t *target, double seconds) {
+	summary_t summary;
+	memset(&summary, 0, sizeof(summary));
+	summary_merge(&summary, &target->latency);
+
+	uint64_t statuses[5];
+	for (uint8_t index = 0; index < 5; index++) {
+		statuses[index] = atomic_load_explicit(&target->statuses[index], memory_order_relaxed);
+	}
+	uint64_t failed = atomic_load_explicit(&target->failed, memory_order_relaxed);
+	uint64_t requests = statuses[0] + statuses[1] + statuses[2] + statuses[3] + statuses[4] + failed;
+	uint64_t errors = statuses[3] + statuses[4] + failed;
+
+	printf("%s requests=%lu rps=%.1f 2xx=%lu 3xx=%lu 4xx=%lu 5xx=%lu failed=%lu errors=%.3f", target_name, requests,
+				 (double)requests / seconds, statuses[1], statuses[2], statuses[3], statuses[4], failed,
+				 requests == 0 ? 0 : (double)errors / (double)requests);
+	printf(" p50_ms=%.3f p90_ms=%.3f p99_ms=%.3f p999_ms=%.3f max_ms=%.3f\n", (double)summary_quantile(&summary, 0.5) / 1000,
+				 (double)summary_quantile(&summary, 0.9) / 1000, (double)summary_quantile(&summary, 0.99) / 1000,
+				 (double)summary_quantile(&summary, 0.999) / 1000, (double)summary.max / 1000);
+}
+
+int load_configure(int argc, char *argv[]) {
+	int errors = 0;
+	for (int ind = 1; ind < argc; ind++) {
+		const char *flag = argv[ind];
+		if (match_arg(flag, "--address", "-a")) {
+			errors += parse_str(next_arg(argc, argv, &ind), "address", 4, 16, &address);
+		} else if (match_arg(flag, "--port", "-p")) {
+			errors += parse_uint16(next_arg(argc, argv, &ind), "port", 0, 65535, &port);
+		} else if (match_arg(flag, "--database-directory", "-dd")) {
+			errors += parse_str(next_arg(argc, argv, &ind), "database directory", 4, 64, &database_directory);
+		} else if (match_arg(flag, "--user", "-u")) {
+			errors += parse_str(next_arg(argc, argv, &ind), "user", 2, 16, &load_user);
+		} else if (match_arg(flag, "--password", "-pw")) {
+			errors += parse_str(next_arg(argc, argv, &ind), "password", 4, 64, &load_password);
+		} else if (match_arg(flag, "--devices", "-dv")) {
+			errors += parse_uint16(next_arg(argc, argv, &ind), "devices", 1, 65535, &load_devices_max);
+		} else if (match_arg(flag, "--rate", "-r")) {
+			errors += parse_uint32(next_arg(argc, argv, &ind), "rate", 1, 1000000, &load_rate);
+		} else if (match_arg(flag, "--gateways", "-g")) {
+			errors += parse_uint8(next_arg(argc, argv, &ind), "gateways", 1, 64, &load_gateways);
+		} else if (match_arg(flag, "--dashboards", "-db")) {
+			errors += parse_uint8(next_arg(argc, argv, &ind), "dashboards", 0, 64, &load_dashboards);
+		} else if (match_arg(flag, "--dashboard-rate", "-dr")) {
+			errors += parse_uint32(next_arg(argc, argv, &ind), "dashboard rate", 1, 1000000, &load_dashboard_rate);
+		} else if (match_arg(flag, "--duration", "-du")) {
+			errors += parse_uint16(next_arg(argc, argv, &ind), "duration", 1, 3600, &load_duration);
+		} else if (match_arg(flag, "--open-loop", "-ol")) {
+			errors += parse_bool(next_arg(argc, argv, &ind), "open loop", &load_open_loop);
+		} else {
+			error("unknown argument %s\n", flag);
+			errors++;
+		}
+	}
+	return errors;
+}
+
+int main(int argc, char *argv[]) {
+	signal(SIGINT, &load_stop);
+	signal(SIGTERM, &load_stop);
+
+	logger_init();
+
+	if (argc >= 2 && (strcmp(argv[1], "--help") == 0 || strcmp(argv[1], "-h") == 0)) {
+		info("available command line flags\n");
+		info("--address             -a   ip address of warden             (%s)\n", address);
+		info("--port                -p   port warden listens on           (%hu)\n", port);
+		info("--database-directory  -dd  path to database directory       (%s)\n", database_directory);
+		info("--user                -u   user to sign in as               (%s)\n", load_user);
+		info("--password            -pw  password of that user            (%s)\n", load_password);
+		info("--devices             -dv  most devices to send uplinks for (%hu)\n", load_devices_max);
+		info("--rate                -r   uplinks per second               (%u)\n", load_rate);
+		info("--gateways            -g   gateway threads sending uplinks  (%hhu)\n", load_gateways);
+		info("--dashboards          -db  dashboard threads fetching       (%hhu)\n", load_dashboards);
+		info("--dashboard-rate      -dr  dashboard fetches per second     (%u)\n", load_dashboard_rate);
+		info("--duration            -du  seconds to generate load         (%hu)\n", load_duration);
+		info("--open-loop           -ol  send on schedule not on reply    (%s)\n", load_open_loop ? "true" : "false");
+		exit(0);
+	}
+
+	if (load_configure(argc, argv) != 0) {
+		exit(1);
+	}
+
+	if (load_grant() == -1 || load_signin(load_user, load_password) == -1 || load_catalog() == -1) {
+		exit(1);
+	}
+	if (load_devices_len == 0) {
+		fprintf(stderr, "no devices found in %s\n", database_directory);
+		exit(1);
+	}
+	if (load_gateways > load_devices_len) {
+		load_gateways = (uint8_t)load_devices_len;
+	}
+
+	printf("load mode=%s duration=%hu devices=%hu gateways=%hhu rate=%u zones=%hu dashboards=%hhu dashboard_rate=%u\n",
+				 load_open_loop == true ? "open" : "closed", load_duration, load_devices_len, load_gateways, load_rate, load_zones_len,
+				 load_dashboards, load_dashboard_rate);
+	fflush(stdout);
+
+	uint8_t workers_len = (uint8_t)(load_gateways + load_dashboards);
+	worker_t workers[128];
+	pthread_t threads[128];
+
+	load_started = load_clock();
+	load_deadline = load_started + (uint64_t)load_duration * 1000000000;
+	for (uint8_t index = 0; index < workers_len; index++) {
+		worker_t *worker = &workers[index];
+		worker->gateway = index < load_gateways;
+		worker->index = worker->gateway == true ? index : (uint8_t)(index - load_gateways);
+		worker->interval = worker->gateway == true ? (double)load_gateways / load_rate : (double)load_dashboards / load_dashboard_rate;
+		worker->state = 0x9e3779b97f4a7c15lu * (index + 1);
+		worker->cursor = worker->index;
+		if ((errno = pthread_create(&threads[index], NULL, &load_work, worker)) != 0) {
+			fprintf(stderr, "failed to spawn worker %hhu\n", index);
+			workers_len = index;
+			load_stop(0);
+			break;
+		}
+	}
+
+	for (uint8_t index = 0; index < workers_len; index++) {
+		pthread_join(threads[index], NULL);
+	}
+	if (atomic_load_explicit(&load_denied, memory_order_relaxed) == true) {
+		fprintf(stderr, "aborted because %s may not create uplinks\n", load_user);
+		free(load_devices);
+		free(load_frames);
+		free(load_zones);
+		exit(1);
+	}
+
+	double seconds = (double)(load_clock() - load_started) / 1e9;
+	target_t total = {.name = "total"};
+	for (uint8_t index = 0; index < sizeof(targets) / sizeof(*targets); index++) {
+		load_report(targets[index].name, &targets[index], seconds);
+		for (uint8_t ind = 0; ind < 5; ind++) {
+			total.statuses[ind] += atomic_load_explicit(&targets[index].statuses[ind], memory_order_relaxed);
+		}
+		total.failed += atomic_load_explicit(&targets[index].failed, memory_order_relaxed);
+		for (uint8_t ind = 0; ind < sizeof(total.latency.buckets) / sizeof(*total.latency.buckets); ind++) {
+			total.latency.buckets[ind] += atomic_load_explicit(&targets[index].latency.buckets[ind], memory_order_relaxed);
+		}
+		total.latency.count += atomic_load_explicit(&targets[index].latency.count, memory_order_relaxed);
+		total.latency.sum += atomic_load_explicit(&targets[index].latency.sum, memory_order_relaxed);
+		stats_max(&total.latency.max, atomic_load_explicit(&targets[index].latency.max, memory_order_relaxed));
+	}
+	load_report(total.name, &total, seconds);
+
+	free(load_devices);
+	free(load_frames);
+	free(load_zones);
+	return 0;
+}
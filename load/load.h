@@ -0,0 +1,42 @@
+#pragma once
+
+#include "../src/lib/stats.h"
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <time.h>
+
+typedef struct target_t {
+	const char *name;
+	atomic_uint_fast64_t statuses[5];
+	atomic_uint_fast64_t failed;
+	histogram_t latency;
+} target_t;
+
+typedef struct worker_t {
+	uint8_t index;
+	bool gateway;
+	double interval;
+	uint64_t state;
+	uint32_t cursor;
+} worker_t;
+
+extern target_t targets[5];
+
+extern uint8_t (*load_devices)[8];
+extern uint16_t load_devices_len;
+extern uint16_t *load_frames;
+extern uint8_t (*load_zones)[8];
+extern uint16_t load_zones_len;
+extern char load_cookie[128];
+
+uint64_t load_clock(void);
+uint64_t load_random(uint64_t *state);
+
+int load_connect(void);
+int load_fetch(const char *method, const char *path, const void *body, size_t body_len, uint16_t *status, char *head,
+							 size_t head_len);
+int load_signin(const char *user, const char *password);
+
+uint8_t uplink_kind(uint64_t *state);
+uint8_t uplink_body(uint8_t (*body)[64], uint8_t kind, uint8_t (*device_id)[8], uint16_t frame, time_t now, uint64_t *state);
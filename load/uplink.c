@@ -0,0 +1,132 @@
+#include "../src/lib/endian.h"
+#include "load.h"
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+
+const uint8_t uplink_kinds[32] = {
+		0x00, 0x00, 0x01, 0x01, 0x01, 0x01, 0x02, 0x02, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03,
+		0x03, 0x03, 0x04, 0x05, 0x06, 0x80, 0x81, 0x81, 0x82, 0x83, 0x83, 0x83, 0x83, 0x84, 0x85, 0x86,
+};
+
+uint8_t uplink_kind(uint64_t *state) { return uplink_kinds[load_random(state) % sizeof(uplink_kinds)]; }
+
+uint8_t uplink_reading(uint8_t *data, uint64_t *state) {
+	float temperature = 18.0f + (float)(load_random(state) % 800) / 100.0f;
+	float humidity = 35.0f + (float)(load_random(state) % 3000) / 100.0f;
+	memcpy(&data[0], (uint16_t[]){hton16((uint16_t)((temperature + 46.85f) * 65536.0f / 175.72f))}, sizeof(uint16_t));
+	memcpy(&data[2], (uint16_t[]){hton16((uint16_t)((humidity + 6.0f) * 65536.0f / 125.0f))}, sizeof(uint16_t));
+	return 4;
+}
+
+uint8_t uplink_metric(uint8_t *data, uint64_t *state) {
+	uint16_t photovoltaic = (uint16_t)(load_random(state) % 3700);
+	uint16_t battery = (uint16_t)(3400 + load_random(state) % 650);
+	data[0] = (uint8_t)(photovoltaic >> 4);
+	data[1] = (uint8_t)((photovoltaic & 0x0f) << 4) | (uint8_t)(battery >> 8);
+	data[2] = (uint8_t)(battery & 0xff);
+	return 3;
+}
+
+uint8_t uplink_firmware(uint8_t *data, uint64_t *state) {
+	data[0] = (uint8_t)(0x10 | load_random(state) % 4);
+	data[1] = (uint8_t)((load_random(state) % 16) << 4);
+	data[2] = 0x21;
+	data[3] = 0x00;
+	return 4;
+}
+
+uint8_t uplink_config(uint8_t *data, uint64_t *state) {
+	data[0] = (uint8_t)(0x70 | (load_random(state) % 8 == 0 ? 0x80 : 0x00));
+	memcpy(&data[1], (uint16_t[]){hton16(60)}, sizeof(uint16_t));
+	memcpy(&data[3], (uint16_t[]){hton16(300)}, sizeof(uint16_t));
+	memcpy(&data[5], (uint16_t[]){hton16(900)}, sizeof(uint16_t));
+	return 7;
+}
+
+uint8_t uplink_radio(uint8_t *data, uint64_t *state) {
+	memcpy(&data[0], (uint32_t[]){hton32(433175000)}, sizeof(uint32_t));
+	data[4] = (uint8_t)(125000 >> 16);
+	data[5] = (uint8_t)(125000 >> 8);
+	data[6] = (uint8_t)(125000 & 0xff);
+	data[7] = 5;
+	data[8] = (uint8_t)(7 + load_random(state) % 3);
+	data[9] = 8;
+	data[10] = 14;
+	data[11] = 0x12;
+	data[12] = 0x01;
+	return 13;
+}
+
+uint8_t uplink_buffer(uint8_t *data, uint64_t *state) {
+	uint32_t delay = (uint32_t)(load_random(state) % 900);
+	uint16_t level = (uint16_t)(load_random(state) % 64);
+	data[0] = (uint8_t)(delay >> 16);
+	data[1] = (uint8_t)(delay >> 8);
+	data[2] = (uint8_t)(delay & 0xff);
+	memcpy(&data[3], (uint16_t[]){hton16(level)}, sizeof(level));
+	return 5;
+}
+
+uint8_t uplink_data(uint8_t *data, uint8_t kind, uint64_t *state) {
+	uint8_t data_len = 0;
+	switch (kind & 0x7f) {
+	case 0x01:
+		data_len = uplink_reading(data, state);
+		break;
+	case 0x02:
+		data_len = uplink_metric(data, state);
+		break;
+	case 0x03:
+		data_len = uplink_reading(data, state);
+		data_len += uplink_metric(&data[data_len], state);
+		break;
+	case 0x04:
+		data_len = uplink_firmware(data, state);
+		break;
+	case 0x05:
+		data_len = uplink_config(data, state);
+		break;
+	case 0x06:
+		data_len = uplink_radio(data, state);
+		break;
+	}
+	if (kind & 0x80) {
+		data_len += uplink_buffer(&data[data_len], state);
+	}
+	return data_len;
+}
+
+uint8_t uplink_body(uint8_t (*body)[64], uint8_t kind, uint8_t (*device_id)[8], uint16_t frame, time_t now, uint64_t *state) {
+	uint8_t *ptr = *body;
+	uint8_t len = 0;
+
+	memcpy(&ptr[len], (uint16_t[]){hton16(frame)}, sizeof(frame));
+	len += sizeof(frame);
+	ptr[len++] = kind;
+	uint8_t data_len = uplink_data(&ptr[len + 1], kind, state);
+	ptr[len++] = data_len;
+	len += data_len;
+
+	uint8_t sf = (uint8_t)(7 + load_random(state) % 3);
+	memcpy(&ptr[len], (uint16_t[]){hton16((uint16_t)(128 + (data_len + 13) * (1u << (sf - 6))))}, sizeof(uint16_t));
+	len += sizeof(uint16_t);
+	memcpy(&ptr[len], (uint32_t[]){hton32(433175000)}, sizeof(uint32_t));
+	len += sizeof(uint32_t);
+	memcpy(&ptr[len], (uint32_t[]){hton32(125000)}, sizeof(uint32_t));
+	len += sizeof(uint32_t);
+	memcpy(&ptr[len], (uint16_t[]){hton16((uint16_t)(int16_t)(-118 + (int16_t)(load_random(state) % 70)))}, sizeof(uint16_t));
+	len += sizeof(uint16_t);
+	ptr[len++] = (uint8_t)(int8_t)(-20 + (int8_t)(load_random(state) % 60));
+	ptr[len++] = sf;
+	ptr[len++] = 5;
+	ptr[len++] = 1;
+	ptr[len++] = 14;
+	ptr[len++] = 8;
+	memcpy(&ptr[len], (uint64_t[]){hton64((uint64_t)now)}, sizeof(uint64_t));
+	len += sizeof(uint64_t);
+	memcpy(&ptr[len], device_id, sizeof(*device_id));
+	len += sizeof(*device_id);
+
+	return len;
+}
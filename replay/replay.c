@@ -0,0 +1,424 @@
+#include "../src/lib/capture.h"
+#include "../src/lib/config.h"
+#include "../src/lib/endian.h"
+#include "../src/lib/logger.h"
+#include "../src/lib/stats.h"
+#include <arpa/inet.h>
+#include <dirent.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <pthread.h>
+#include <signal.h>
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <time.h>
+#include <unistd.h>
+
+typedef struct captured_t {
+	uint64_t arrived_at;
+	const char *ptr;
+	uint32_t len;
+} captured_t;
+
+const char *replay_capture = "";
+const char *replay_snapshot = "";
+const char *replay_binary = "./warden";
+uint16_t replay_speed = 1;
+uint8_t replay_connections = 16;
+
+captured_t *records = NULL;
+uint32_t records_len = 0;
+atomic_uint_fast32_t records_next = 0;
+
+atomic_uint_fast64_t replay_statuses[5];
+atomic_uint_fast64_t replay_failed = 0;
+atomic_uint_fast64_t replay_slip = 0;
+histogram_t replay_latency;
+
+uint64_t replay_started = 0;
+atomic_bool replay_stopping = false;
+
+void replay_stop(int sig) {
+	(void)sig;
+	atomic_store_explicit(&replay_stopping, true, memory_order_relaxed);
+}
+
+uint64_t replay_clock(void) {
+	struct timespec now;
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	return (uint64_t)now.tv_sec * 1000000000 + (uint64_t)now.tv_nsec;
+}
+
+int replay_connect(void) {
+	int sock = socket(AF_INET, SOCK_STREAM, 0);
+	if (sock == -1) {
+		return -1;
+	}
+
+	struct sockaddr_in addr;
+	memset(&addr, 0, sizeof(addr));
+	addr.sin_family = AF_INET;
+	addr.sin_port = htons(port);
+	if (inet_pton(AF_INET, address, &addr.sin_addr) != 1 || connect(sock, (struct sockaddr *)&addr, sizeof(addr)) == -1) {
+		close(sock);
+		return -1;
+	}
+
+	setsockopt(sock, IPPROTO_TCP, TCP_NODELAY, &(int){1}, sizeof(int));
+	return sock;
+}
+
+int replay_send(captured_t *record, uint16_t *status) {
+	int sock = replay_connect();
+	if (sock == -1) {
+		return -1;
+	}
+
+	uint32_t sent = 0;
+	while (sent < record->len) {
+		ssize_t bytes = send(sock, &record->ptr[sent], record->len - sent, MSG_NOSIGNAL);
+		if (bytes <= 0) {
+			close(sock);
+			return -1;
+		}
+		sent += (uint32_t)bytes;
+	}
+
+	size_t received = 0;
+	char chunk[16384];
+	while (true) {
+		ssize_t bytes = recv(sock, chunk, sizeof(chunk), 0);
+		if (bytes == -1) {
+			close(sock);
+			return -1;
+		}
+		if (bytes == 0) {
+			break;
+		}
+		if (received == 0) {
+			*status = bytes >= 12 && memcmp(chunk, "HTTP/1.1 ", 9) == 0 ? (uint16_t)atoi(&chunk[9]) : 0;
+		}
+		received += (size_t)bytes;
+	}
+
+	close(sock);
+	return received == 0 ? -1 : 0;
+}
+
+void *replay_work(void *arg) {
+	(void)arg;
+
+	while (atomic_load_explicit(&replay_stopping, memory_order_relaxed) == false) {
+		uint32_t index = (uint32_t)atomic_fetch_add_explicit(&records_next, 1, memory_order_relaxed);
+		if (index >= records_len) {
+			break;
+		}
+		captured_t *record = &records[index];
+
+		uint64_t offset = record->arrived_at - records[0].arrived_at;
+		uint64_t intended = replay_started + (replay_speed == 0 ? 0 : offset / replay_speed);
+		struct timespec wake = {.tv_sec = (time_t)(intended / 1000000000), .tv_nsec = (long)(intended % 1000000000)};
+		while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &wake, NULL) == EINTR) {
+		}
+
+		uint64_t sent = replay_clock();
+		if (replay_speed != 0) {
+			stats_max(&replay_slip, (sent - intended) / 1000);
+		}
+
+		uint16_t status = 0;
+		if (replay_send(record, &status) == -1) {
+			atomic_fetch_add_explicit(&replay_failed, 1, memory_order_relaxed);
+			continue;
+		}
+
+		uint64_t latency = (replay_clock() - (replay_speed == 0 ? sent : intended)) / 1000;
+		atomic_fetch_add_explicit(&replay_statuses[status >= 100 && status < 600 ? status / 100 - 1 : 4], 1, memory_order_relaxed);
+		atomic_fetch_add_explicit(&replay_latency.buckets[histogram_bucket(latency)], 1, memory_order_relaxed);
+		atomic_fetch_add_explicit(&replay_latency.count, 1, memory_order_relaxed);
+		atomic_fetch_add_explicit(&replay_latency.sum, latency, memory_order_relaxed);
+		stats_max(&replay_latency.max, latency);
+	}
+
+	return NULL;
+}
+
+char *replay_read(const char *path, size_t *len) {
+	FILE *file = fopen(path, "r");
+	if (file == NULL) {
+		error("failed to open %s because %s\n", path, strerror(errno));
+		return NULL;
+	}
+	fseek(file, 0, SEEK_END);
+	long size = ftell(file);
+	fseek(file, 0, SEEK_SET);
+	char *ptr = malloc(size > 0 ? (size_t)size : 1);
+	if (ptr == NULL || fread(ptr, 1, (size_t)size, file) != (size_t)size) {
+		error("failed to read %s\n", path);
+		free(ptr);
+		fclose(file);
+		return NULL;
+	}
+	fclose(file);
+	*len = (size_t)size;
+	return ptr;
+}
+
+int replay_index(const char *ptr, size_t len) {
+	if (len < sizeof(capture_magic) || memcmp(ptr, capture_magic, sizeof(capture_magic)) != 0) {
+		error("capture does not start with the expected magic\n");
+		return -1;
+	}
+
+	uint32_t cap = 1024;
+	records = malloc(cap * sizeof(*records));
+	if (records == NULL) {
+		return -1;
+	}
+
+	size_t offset = sizeof(capture_magic);
+	while (offset + 12 <= len) {
+		uint64_t arrived_at;
+		uint32_t record_len;
+		memcpy(&arrived_at, &ptr[offset], sizeof(arrived_at));
+		memcpy(&record_len, &ptr[offset + 8], sizeof(record_len));
+		arrived_at = ntoh64(arrived_at);
+		record_len = ntoh32(record_len);
+		if (offset + 12 + record_len > len) {
+			warn("capture is truncated after %u records\n", records_len);
+			break;
+		}
+		if (records_len == cap) {
+			cap *= 2;
+			captured_t *grown = realloc(records, cap * sizeof(*records));
+			if (grown == NULL) {
+				return -1;
+			}
+			records = grown;
+		}
+		records[records_len++] = (captured_t){.arrived_at = arrived_at, .ptr = &ptr[offset + 12], .len = record_len};
+		offset += 12 + record_len;
+	}
+
+	return 0;
+}
+
+int replay_copy(const char *source, const char *target) {
+	if (mkdir(target, 0755) == -1) {
+		error("failed to create %s because %s\n", target, strerror(errno));
+		return -1;
+	}
+
+	DIR *dir = opendir(source);
+	if (dir == NULL) {
+		error("failed to open %s because %s\n", source, strerror(errno));
+		return -1;
+	}
+
+	int status = 0;
+	struct dirent *entry;
+	while (status == 0 && (entry = readdir(dir)) != NULL) {
+		if (strcmp(entry->d_name, ".") == 0 || strcmp(entry->d_name, "..") == 0) {
+			continue;
+		}
+		char from[512];
+		char to[512];
+		snprintf(from, sizeof(from), "%s/%s", source, entry->d_name);
+		snprintf(to, sizeof(to), "%s/%s", target, entry->d_name);
+
+		struct stat from_stat;
+		if (stat(from, &from_stat) == -1) {
+			status = -1;
+		} else if (S_ISDIR(from_stat.st_mode)) {
+			status = replay_copy(from, to);
+		} else if (S_ISREG(from_stat.st_mode)) {
+			int from_fd = open(from, O_RDONLY);
+			int to_fd = open(to, O_WRONLY | O_CREAT | O_EXCL, 0644);
+			char buffer[65536];
+			ssize_t bytes;
+			while (from_fd != -1 && to_fd != -1 && (bytes = read(from_fd, buffer, sizeof(buffer))) > 0) {
+				if (write(to_fd, buffer, (size_t)bytes) != bytes) {
+					status = -1;
+					break;
+				}
+			}
+			if (from_fd == -1 || to_fd == -1) {
+				error("failed to copy %s because %s\n", from, strerror(errno));
+				status = -1;
+			}
+			if (from_fd != -1) {
+				close(from_fd);
+			}
+			if (to_fd != -1) {
+				close(to_fd);
+			}
+		}
+	}
+
+	closedir(dir);
+	return status;
+}
+
+pid_t replay_spawn(void) {
+	char port_buffer[8];
+	sprintf(port_buffer, "%hu", port);
+
+	pid_t pid = fork();
+	if (pid == 0) {
+		execl(replay_binary, replay_binary, "--database-directory", database_directory, "--address", address, "--port", port_buffer,
+					"--log-level", "warn", "--log-requests", "false", "--log-responses", "false", (char *)NULL);
+		_exit(127);
+	}
+	if (pid == -1) {
+		return -1;
+	}
+
+	for (uint8_t attempt = 0; attempt < 100; attempt++) {
+		int sock = replay_connect();
+		if (sock != -1) {
+			close(sock);
+			return pid;
+		}
+		if (waitpid(pid, NULL, WNOHANG) == pid) {
+			return -1;
+		}
+		usleep(50000);
+	}
+
+	kill(pid, SIGINT);
+	waitpid(pid, NULL, 0);
+	return -1;
+}
+
+int replay_configure(int argc, char *argv[]) {
+	int errors = 0;
+	for (int ind = 1; ind < argc; ind++) {
+		const char *flag = argv[ind];
+		if (match_arg(flag, "--capture", "-cp")) {
+			errors += parse_str(next_arg(argc, argv, &ind), "capture", 1, 128, &replay_capture);
+		} else if (match_arg(flag, "--address", "-a")) {
+			errors += parse_str(next_arg(argc, argv, &ind), "address", 4, 16, &address);
+		} else if (match_arg(flag, "--port", "-p")) {
+			errors += parse_uint16(next_arg(argc, argv, &ind), "port", 0, 65535, &port);
+		} else if (match_arg(flag, "--speed", "-s")) {
+			errors += parse_uint16(next_arg(argc, argv, &ind), "speed", 0, 1000, &replay_speed);
+		} else if (match_arg(flag, "--connections", "-c")) {
+			errors += parse_uint8(next_arg(argc, argv, &ind), "connections", 1, 128, &replay_connections);
+		} else if (match_arg(flag, "--snapshot", "-ss")) {
+			errors += parse_str(next_arg(argc, argv, &ind), "snapshot", 1, 128, &replay_snapshot);
+		} else if (match_arg(flag, "--database-directory", "-dd")) {
+			errors += parse_str(next_arg(argc, argv, &ind), "database directory", 4, 64, &database_directory);
+		} else if (match_arg(flag, "--binary", "-b")) {
+			errors += parse_str(next_arg(argc, argv, &ind), "binary", 1, 128, &replay_binary);
+		} else {
+			error("unknown argument %s\n", flag);
+			errors++;
+		}
+	}
+	if (replay_capture[0] == '\0') {
+		error("please provide a capture to replay\n");
+		errors++;
+	}
+	return errors;
+}
+
+int main(int argc, char *argv[]) {
+	signal(SIGINT, &replay_stop);
+	signal(SIGTERM, &replay_stop);
+
+	logger_init();
+
+	if (argc >= 2 && (strcmp(argv[1], "--help") == 0 || strcmp(argv[1], "-h") == 0)) {
+		info("available command line flags\n");
+		info("--capture             -cp  file recorded by warden --capture (%s)\n", replay_capture);
+		info("--address             -a   ip address of warden              (%s)\n", address);
+		info("--port                -p   port warden listens on            (%hu)\n", port);
+		info("--speed               -s   times faster than recorded or 0   (%hu)\n", replay_speed);
+		info("--connections         -c   requests in flight at most        (%hhu)\n", replay_connections);
+		info("--snapshot            -ss  database to restore before replay (%s)\n", replay_snapshot);
+		info("--database-directory  -dd  fresh directory to restore into   (%s)\n", database_directory);
+		info("--binary              -b   warden to spawn on the snapshot   (%s)\n", replay_binary);
+		exit(0);
+	}
+
+	if (replay_configure(argc, argv) != 0) {
+		exit(1);
+	}
+
+	size_t capture_len;
+	char *capture_ptr = replay_read(replay_capture, &capture_len);
+	if (capture_ptr == NULL || replay_index(capture_ptr, capture_len) == -1) {
+		exit(1);
+	}
+	if (records_len == 0) {
+		error("capture %s holds no requests\n", replay_capture);
+		exit(1);
+	}
+
+	pid_t pid = 0;
+	if (replay_snapshot[0] != '\0') {
+		if (replay_copy(replay_snapshot, database_directory) == -1) {
+			error("failed to restore %s into %s\n", replay_snapshot, database_directory);
+			exit(1);
+		}
+		pid = replay_spawn();
+		if (pid == -1) {
+			error("failed to spawn %s on %s\n", replay_binary, database_directory);
+			exit(1);
+		}
+	}
+
+	printf("replay capture=%s requests=%u recorded_s=%.3f speed=%hu connections=%hhu\n", replay_capture, records_len,
+				 (double)(records[records_len - 1].arrived_at - records[0].arrived_at) / 1e9, replay_speed, replay_connections);
+	fflush(stdout);
+
+	pthread_t threads[128];
+	uint8_t threads_len = 0;
+	replay_started = replay_clock();
+	for (uint8_t index = 0; index < replay_connections; index++) {
+		if ((errno = pthread_create(&threads[index], NULL, &replay_work, NULL)) != 0) {
+			error("failed to spawn worker %hhu because %s\n", index, strerror(errno));
+			break;
+		}
+		threads_len++;
+	}
+	for (uint8_t index = 0; index < threads_len; index++) {
+		pthread_join(threads[index], NULL);
+	}
+	double seconds = (double)(replay_clock() - replay_started) / 1e9;
+
+	if (pid > 0) {
+		kill(pid, SIGINT);
+		waitpid(pid, NULL, 0);
+	}
+
+	summary_t summary;
+	memset(&summary, 0, sizeof(summary));
+	summary_merge(&summary, &replay_latency);
+	uint64_t statuses[5];
+	uint64_t requests = atomic_load_explicit(&replay_failed, memory_order_relaxed);
+	for (uint8_t index = 0; index < 5; index++) {
+		statuses[index] = atomic_load_explicit(&replay_statuses[index], memory_order_relaxed);
+		requests += statuses[index];
+	}
+	printf("replayed requests=%lu seconds=%.3f rps=%.1f 2xx=%lu 3xx=%lu 4xx=%lu 5xx=%lu failed=%lu slip_ms=%.3f", requests,
+				 seconds, (double)requests / seconds, statuses[1], statuses[2], statuses[3], statuses[4],
+				 atomic_load_explicit(&replay_failed, memory_order_relaxed),
+				 (double)atomic_load_explicit(&replay_slip, memory_order_relaxed) / 1000);
+	printf(" p50_ms=%.3f p90_ms=%.3f p99_ms=%.3f p999_ms=%.3f max_ms=%.3f\n", (double)summary_quantile(&summary, 0.5) / 1000,
+				 (double)summary_quantile(&summary, 0.9) / 1000, (double)summary_quantile(&summary, 0.99) / 1000,
+				 (double)summary_quantile(&summary, 0.999) / 1000, (double)summary.max / 1000);
+
+	free(records);
+	free(capture_ptr);
+	return 0;
+}
@@ -1,4 +1,5 @@
 #include "alert.h"
+#include "../lib/arena.h"
 #include "../lib/base16.h"
 #include "../lib/bwt.h"
 #include "../lib/config.h"
@@ -7,6 +8,7 @@
 #include "../lib/octet.h"
 #include "../lib/request.h"
 #include "../lib/response.h"
+#include "../lib/span.h"
 #include "../lib/strn.h"
 #include "cache.h"
 #include "device.h"
@@ -33,24 +35,30 @@ const alert_row_t alert_row = {
 uint16_t alert_select(octet_t *db, bwt_t *bwt, alert_query_t *query, response_t *response, uint8_t *alerts_len) {
 	uint16_t status;
 
-	uint8_t devices_len;
+	uint8_t devices_len = 0;
 	user_t user = {.id = &bwt->id};
-	status = user_device_select_by_user(db, &user, &devices_len);
+	uint8_t *devices;
+	status = user_device_select_by_user(db, &user, &devices, &devices_len);
 	if (status != 0) {
 		return status;
 	}
 
 	debug("select alerts for user %02x%02x limit %hhu offset %u\n", bwt->id[0], bwt->id[1], query->limit, query->offset);
 
-	char (*uuids)[16] = (char (*)[16])db->alpha;
-	char (*files)[128] = (char (*)[128])db->bravo;
-	off_t *offsets = (off_t *)db->charlie;
-	time_t *issued_ats = (time_t *)db->delta;
-	octet_stmt_t *stmts = (octet_stmt_t *)db->echo;
+	char (*uuids)[16] = arena_alloc(&db->arena, devices_len * sizeof(*uuids));
+	char (*files)[128] = arena_alloc(&db->arena, devices_len * sizeof(*files));
+	off_t *offsets = arena_alloc(&db->arena, devices_len * sizeof(*offsets));
+	time_t *issued_ats = arena_alloc(&db->arena, devices_len * sizeof(*issued_ats));
+	octet_stmt_t *stmts = arena_alloc(&db->arena, devices_len * sizeof(*stmts));
+	uint8_t *table = arena_alloc(&db->arena, devices_len * alert_row.size);
+	if (uuids == NULL || files == NULL || offsets == NULL || issued_ats == NULL || stmts == NULL || table == NULL) {
+		return 500;
+	}
+
 	uint8_t stmts_len = 0;
 	for (uint8_t index = 0; index < devices_len; index++) {
 		uint8_t (*device_id)[8] =
-				(uint8_t (*)[8])octet_blob_read(&db->chunk[index * user_device_row.size], user_device_row.device_id);
+				(uint8_t (*)[8])octet_blob_read(&devices[index * user_device_row.size], user_device_row.device_id);
 
 		if (base16_encode(uuids[index], sizeof(uuids[index]), device_id, sizeof(*device_id)) == -1) {
 			error("failed to encode uuid to base 16\n");
@@ -77,11 +85,11 @@ uint16_t alert_select(octet_t *db, bwt_t *bwt, alert_query_t *query, response_t
 		if (offsets[index] < 0) {
 			continue;
 		}
-		if (octet_row_read(&stmts[index], files[index], offsets[index], &db->table[index * alert_row.size], alert_row.size) == -1) {
+		if (octet_row_read(&stmts[index], files[index], offsets[index], &table[index * alert_row.size], alert_row.size) == -1) {
 			status = octet_error();
 			goto cleanup;
 		}
-		issued_ats[index] = (time_t)octet_uint64_read(&db->table[index * alert_row.size], alert_row.issued_at);
+		issued_ats[index] = (time_t)octet_uint64_read(&table[index * alert_row.size], alert_row.issued_at);
 	}
 
 	while (*alerts_len < query->limit) {
@@ -100,15 +108,15 @@ uint16_t alert_select(octet_t *db, bwt_t *bwt, alert_query_t *query, response_t
 		}
 
 		if (query->offset == 0) {
-			uint8_t severity = octet_uint8_read(&db->table[index * alert_row.size], alert_row.severity);
-			uint8_t field = octet_uint8_read(&db->table[index * alert_row.size], alert_row.field);
-			uint8_t edge = octet_uint8_read(&db->table[index * alert_row.size], alert_row.edge);
-			int32_t value = octet_int32_read(&db->table[index * alert_row.size], alert_row.value);
-			time_t issued_at = (time_t)octet_uint64_read(&db->table[index * alert_row.size], alert_row.issued_at);
-			uint8_t resolved_at_null = octet_uint8_read(&db->table[index * alert_row.size], alert_row.resolved_at_null);
-			time_t resolved_at = (time_t)octet_uint64_read(&db->table[index * alert_row.size], alert_row.resolved_at);
+			uint8_t severity = octet_uint8_read(&table[index * alert_row.size], alert_row.severity);
+			uint8_t field = octet_uint8_read(&table[index * alert_row.size], alert_row.field);
+			uint8_t edge = octet_uint8_read(&table[index * alert_row.size], alert_row.edge);
+			int32_t value = octet_int32_read(&table[index * alert_row.size], alert_row.value);
+			time_t issued_at = (time_t)octet_uint64_read(&table[index * alert_row.size], alert_row.issued_at);
+			uint8_t resolved_at_null = octet_uint8_read(&table[index * alert_row.size], alert_row.resolved_at_null);
+			time_t resolved_at = (time_t)octet_uint64_read(&table[index * alert_row.size], alert_row.resolved_at);
 			uint8_t (*device_id)[8] =
-					(uint8_t (*)[8])octet_blob_read(&db->chunk[index * user_device_row.size], user_device_row.device_id);
+					(uint8_t (*)[8])octet_blob_read(&devices[index * user_device_row.size], user_device_row.device_id);
 			body_write(response, &severity, sizeof(severity));
 			body_write(response, &field, sizeof(field));
 			body_write(response, &edge, sizeof(edge));
@@ -128,11 +136,11 @@ uint16_t alert_select(octet_t *db, bwt_t *bwt, alert_query_t *query, response_t
 			continue;
 		}
 
-		if (octet_row_read(&stmts[index], files[index], offsets[index], &db->table[index * alert_row.size], alert_row.size) == -1) {
+		if (octet_row_read(&stmts[index], files[index], offsets[index], &table[index * alert_row.size], alert_row.size) == -1) {
 			status = octet_error();
 			goto cleanup;
 		}
-		issued_ats[index] = (time_t)octet_uint64_read(&db->table[index * alert_row.size], alert_row.issued_at);
+		issued_ats[index] = (time_t)octet_uint64_read(&table[index * alert_row.size], alert_row.issued_at);
 	}
 
 cleanup:
@@ -364,6 +372,7 @@ void alert_find(octet_t *db, bwt_t *bwt, request_t *request, response_t *respons
 
 	header_write(response, "content-type:application/octet-stream\r\n");
 	header_write(response, "content-length:%u\r\n", response->body.len);
+	span.emitted = alerts_len;
 	info("found %hhu alerts\n", alerts_len);
 	response->status = 200;
 }
@@ -441,6 +450,7 @@ void alert_find_by_device(octet_t *db, bwt_t *bwt, request_t *request, response_
 	}
 	header_write(response, "content-type:application/octet-stream\r\n");
 	header_write(response, "content-length:%u\r\n", response->body.len);
+	span.emitted = alerts_len;
 	info("found %hu alerts\n", alerts_len);
 	response->status = 200;
 }
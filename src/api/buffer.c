@@ -1,4 +1,5 @@
 #include "buffer.h"
+#include "../lib/arena.h"
 #include "../lib/base16.h"
 #include "../lib/bwt.h"
 #include "../lib/endian.h"
@@ -6,6 +7,7 @@
 #include "../lib/octet.h"
 #include "../lib/request.h"
 #include "../lib/response.h"
+#include "../lib/span.h"
 #include "../lib/strn.h"
 #include "cache.h"
 #include "device.h"
@@ -32,9 +34,15 @@ const buffer_row_t buffer_row = {
 uint16_t buffer_select(octet_t *db, bwt_t *bwt, buffer_query_t *query, response_t *response, uint16_t *buffers_len) {
 	uint16_t status;
 
+	uint8_t *table = arena_alloc(&db->arena, buffer_row.size * 64);
+	if (table == NULL) {
+		return 500;
+	}
+
 	uint8_t user_devices_len = 0;
 	user_t user = {.id = &bwt->id};
-	status = user_device_select_by_user(db, &user, &user_devices_len);
+	uint8_t *user_devices;
+	status = user_device_select_by_user(db, &user, &user_devices, &user_devices_len);
 	if (status != 0) {
 		return status;
 	}
@@ -47,7 +55,7 @@ uint16_t buffer_select(octet_t *db, bwt_t *bwt, buffer_query_t *query, response_
 	octet_stmt_t stmt;
 	for (uint8_t index = 0; index < user_devices_len; index++) {
 		uint8_t (*device_id)[8] =
-				(uint8_t (*)[8])octet_blob_read(&db->chunk[index * user_device_row.size], user_device_row.device_id);
+				(uint8_t (*)[8])octet_blob_read(&user_devices[index * user_device_row.size], user_device_row.device_id);
 
 		if (base16_encode(uuid, sizeof(uuid), device_id, sizeof(*device_id)) == -1) {
 			error("failed to encode uuid to base 16\n");
@@ -101,23 +109,23 @@ uint16_t buffer_select(octet_t *db, bwt_t *bwt, buffer_query_t *query, response_
 				break;
 			}
 			if (batch_index == 0) {
-				if (offset >= buffer_row.size * 63 && db->table_len >= buffer_row.size * 64) {
+				if (offset >= buffer_row.size * 63) {
 					batch_index = 63;
-					if (octet_row_read_all(&stmt, file, offset - buffer_row.size * 63, db->table, buffer_row.size, 64) == -1) {
+					if (octet_row_read_all(&stmt, file, offset - buffer_row.size * 63, table, buffer_row.size, 64) == -1) {
 						status = octet_error();
 						goto cleanup;
 					}
 				} else {
 					batch_index = 0;
-					if (octet_row_read(&stmt, file, offset, db->table, buffer_row.size) == -1) {
+					if (octet_row_read(&stmt, file, offset, table, buffer_row.size) == -1) {
 						status = octet_error();
 						goto cleanup;
 					}
 				}
 			}
-			uint32_t delay = octet_uint32_read(&db->table[batch_index * buffer_row.size], buffer_row.delay);
-			uint16_t level = octet_uint16_read(&db->table[batch_index * buffer_row.size], buffer_row.level);
-			time_t captured_at = (time_t)octet_uint64_read(&db->table[batch_index * buffer_row.size], buffer_row.captured_at);
+			uint32_t delay = octet_uint32_read(&table[batch_index * buffer_row.size], buffer_row.delay);
+			uint16_t level = octet_uint16_read(&table[batch_index * buffer_row.size], buffer_row.level);
+			time_t captured_at = (time_t)octet_uint64_read(&table[batch_index * buffer_row.size], buffer_row.captured_at);
 			if (response->body.len + sizeof(delay) + sizeof(level) + sizeof(captured_at) > response->body.cap) {
 				error("buffers amount %hu exceeds buffer length %u\n", *buffers_len, response->body.cap);
 				status = 500;
@@ -178,6 +186,11 @@ uint16_t buffer_select_by_device(octet_t *db, device_t *device, buffer_query_t *
 																 uint16_t *buffers_len) {
 	uint16_t status;
 
+	uint8_t *table = arena_alloc(&db->arena, buffer_row.size * 64);
+	if (table == NULL) {
+		return 500;
+	}
+
 	char uuid[16];
 	if (base16_encode(uuid, sizeof(uuid), device->id, sizeof(*device->id)) == -1) {
 		error("failed to encode uuid to base 16\n");
@@ -212,23 +225,23 @@ uint16_t buffer_select_by_device(octet_t *db, device_t *device, buffer_query_t *
 			break;
 		}
 		if (batch_index == 0) {
-			if (offset >= buffer_row.size * 63 && db->table_len >= buffer_row.size * 64) {
+			if (offset >= buffer_row.size * 63) {
 				batch_index = 63;
-				if (octet_row_read_all(&stmt, file, offset - buffer_row.size * 63, db->table, buffer_row.size, 64) == -1) {
+				if (octet_row_read_all(&stmt, file, offset - buffer_row.size * 63, table, buffer_row.size, 64) == -1) {
 					status = octet_error();
 					goto cleanup;
 				}
 			} else {
 				batch_index = 0;
-				if (octet_row_read(&stmt, file, offset, db->table, buffer_row.size) == -1) {
+				if (octet_row_read(&stmt, file, offset, table, buffer_row.size) == -1) {
 					status = octet_error();
 					goto cleanup;
 				}
 			}
 		}
-		uint32_t delay = octet_uint32_read(&db->table[batch_index * buffer_row.size], buffer_row.delay);
-		uint16_t level = octet_uint16_read(&db->table[batch_index * buffer_row.size], buffer_row.level);
-		time_t captured_at = (time_t)octet_uint64_read(&db->table[batch_index * buffer_row.size], buffer_row.captured_at);
+		uint32_t delay = octet_uint32_read(&table[batch_index * buffer_row.size], buffer_row.delay);
+		uint16_t level = octet_uint16_read(&table[batch_index * buffer_row.size], buffer_row.level);
+		time_t captured_at = (time_t)octet_uint64_read(&table[batch_index * buffer_row.size], buffer_row.captured_at);
 		if (response->body.len + sizeof(delay) + sizeof(level) + sizeof(captured_at) > response->body.cap) {
 			error("buffers amount %hu exceeds buffer length %u\n", *buffers_len, response->body.cap);
 			status = 500;
@@ -280,8 +293,14 @@ cleanup:
 uint16_t buffer_select_by_zone(octet_t *db, zone_t *zone, buffer_query_t *query, response_t *response, uint16_t *buffers_len) {
 	uint16_t status;
 
-	uint8_t devices_len;
-	status = device_select_by_zone(db, zone, &devices_len);
+	uint8_t *table = arena_alloc(&db->arena, buffer_row.size * 64);
+	if (table == NULL) {
+		return 500;
+	}
+
+	uint8_t devices_len = 0;
+	uint8_t *devices;
+	status = device_select_by_zone(db, zone, &devices, &devices_len);
 	if (status != 0) {
 		return status;
 	}
@@ -293,7 +312,7 @@ uint16_t buffer_select_by_zone(octet_t *db, zone_t *zone, buffer_query_t *query,
 	char file[128];
 	octet_stmt_t stmt;
 	for (uint8_t index = 0; index < devices_len; index++) {
-		uint8_t (*device_id)[8] = (uint8_t (*)[8])octet_blob_read(&db->chunk[index * device_row.size], device_row.id);
+		uint8_t (*device_id)[8] = (uint8_t (*)[8])octet_blob_read(&devices[index * device_row.size], device_row.id);
 
 		if (base16_encode(uuid, sizeof(uuid), device_id, sizeof(*device_id)) == -1) {
 			error("failed to encode uuid to base 16\n");
@@ -333,23 +352,23 @@ uint16_t buffer_select_by_zone(octet_t *db, zone_t *zone, buffer_query_t *query,
 				break;
 			}
 			if (batch_index == 0) {
-				if (offset >= buffer_row.size * 63 && db->table_len >= buffer_row.size * 64) {
+				if (offset >= buffer_row.size * 63) {
 					batch_index = 63;
-					if (octet_row_read_all(&stmt, file, offset - buffer_row.size * 63, db->table, buffer_row.size, 64) == -1) {
+					if (octet_row_read_all(&stmt, file, offset - buffer_row.size * 63, table, buffer_row.size, 64) == -1) {
 						status = octet_error();
 						goto cleanup;
 					}
 				} else {
 					batch_index = 0;
-					if (octet_row_read(&stmt, file, offset, db->table, buffer_row.size) == -1) {
+					if (octet_row_read(&stmt, file, offset, table, buffer_row.size) == -1) {
 						status = octet_error();
 						goto cleanup;
 					}
 				}
 			}
-			uint32_t delay = octet_uint32_read(&db->table[batch_index * buffer_row.size], buffer_row.delay);
-			uint16_t level = octet_uint16_read(&db->table[batch_index * buffer_row.size], buffer_row.level);
-			time_t captured_at = (time_t)octet_uint64_read(&db->table[batch_index * buffer_row.size], buffer_row.captured_at);
+			uint32_t delay = octet_uint32_read(&table[batch_index * buffer_row.size], buffer_row.delay);
+			uint16_t level = octet_uint16_read(&table[batch_index * buffer_row.size], buffer_row.level);
+			time_t captured_at = (time_t)octet_uint64_read(&table[batch_index * buffer_row.size], buffer_row.captured_at);
 			if (response->body.len + sizeof(delay) + sizeof(level) + sizeof(captured_at) > response->body.cap) {
 				error("buffers amount %hu exceeds buffer length %u\n", *buffers_len, response->body.cap);
 				status = 500;
@@ -406,86 +425,6 @@ uint16_t buffer_select_by_zone(octet_t *db, zone_t *zone, buffer_query_t *query,
 	return status;
 }
 
-uint16_t buffer_insert(octet_t *db, buffer_t *buffer) {
-	uint16_t status;
-
-	char uuid[16];
-	if (base16_encode(uuid, sizeof(uuid), buffer->device_id, sizeof(*buffer->device_id)) == -1) {
-		error("failed to encode uuid to base 16\n");
-		return 500;
-	}
-
-	char file[128];
-	if (sprintf(file, "%s/%.*s/%s.data", db->directory, (int)sizeof(uuid), uuid, buffer_file) == -1) {
-		error("failed to sprintf uuid to file\n");
-		return 500;
-	}
-
-	octet_stmt_t stmt;
-	if (octet_open(&stmt, file, O_RDWR, F_WRLCK) == -1) {
-		status = octet_error();
-		goto cleanup;
-	}
-
-	debug("insert buffer for device %02x%02x captured at %lu\n", (*buffer->device_id)[0], (*buffer->device_id)[1],
-				buffer->captured_at);
-
-	off_t offset = stmt.stat.st_size;
-	while (offset > 0) {
-		if (octet_row_read(&stmt, file, offset - buffer_row.size, db->row, buffer_row.size) == -1) {
-			status = octet_error();
-			goto cleanup;
-		}
-		time_t captured_at = (time_t)octet_uint64_read(db->row, buffer_row.captured_at);
-		if (captured_at <= buffer->captured_at) {
-			break;
-		}
-		if (octet_row_write(&stmt, file, offset, db->row, buffer_row.size) == -1) {
-			status = octet_error();
-			goto cleanup;
-		}
-		offset -= buffer_row.size;
-	}
-
-	octet_uint32_write(db->row, buffer_row.delay, buffer->delay);
-	octet_uint16_write(db->row, buffer_row.level, buffer->level);
-	octet_uint64_write(db->row, buffer_row.captured_at, (uint64_t)buffer->captured_at);
-
-	if (octet_row_write(&stmt, file, offset, db->row, buffer_row.size) == -1) {
-		status = octet_error();
-		goto cleanup;
-	}
-
-	uint8_t zone_id[8];
-	device_t device = {
-			.id = buffer->device_id,
-			.zone_id = &zone_id,
-			.reading = NULL,
-			.metric = NULL,
-			.buffer = buffer,
-			.uplink = NULL,
-			.downlink = NULL,
-	};
-	status = device_update_latest(db, &device);
-	if (status != 0) {
-		goto cleanup;
-	}
-
-	if (device.zone_id != NULL) {
-		zone_t zone = {.id = device.zone_id};
-		status = zone_update_latest(db, &zone);
-		if (status != 0) {
-			goto cleanup;
-		}
-	}
-
-	status = 0;
-
-cleanup:
-	octet_close(&stmt, file);
-	return status;
-}
-
 void buffer_find(octet_t *db, bwt_t *bwt, request_t *request, response_t *response) {
 	const char *from;
 	size_t from_len;
@@ -533,6 +472,7 @@ void buffer_find(octet_t *db, bwt_t *bwt, request_t *request, response_t *respon
 
 	header_write(response, "content-type:application/octet-stream\r\n");
 	header_write(response, "content-length:%u\r\n", response->body.len);
+	span.emitted = buffers_len;
 	info("found %hu buffers\n", buffers_len);
 	response->status = 200;
 }
@@ -620,6 +560,7 @@ void buffer_find_by_device(octet_t *db, bwt_t *bwt, request_t *request, response
 	}
 	header_write(response, "content-type:application/octet-stream\r\n");
 	header_write(response, "content-length:%u\r\n", response->body.len);
+	span.emitted = buffers_len;
 	info("found %hu buffers\n", buffers_len);
 	response->status = 200;
 }
@@ -704,6 +645,7 @@ void buffer_find_by_zone(octet_t *db, bwt_t *bwt, request_t *request, response_t
 	}
 	header_write(response, "content-type:application/octet-stream\r\n");
 	header_write(response, "content-length:%u\r\n", response->body.len);
+	span.emitted = buffers_len;
 	info("found %hu buffers\n", buffers_len);
 	response->status = 200;
 }
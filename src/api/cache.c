@@ -1,6 +1,7 @@
 #include "cache.h"
 #include "../lib/config.h"
 #include "../lib/logger.h"
+#include "../lib/stats.h"
 #include "device.h"
 #include "zone.h"
 #include <pthread.h>
@@ -30,6 +31,7 @@ int cache_device_read(cache_device_t *cache_device, device_t *device) {
 	}
 
 	pthread_rwlock_unlock(&cache.devices_lock);
+	stats_device_cache(status == 0);
 	return status;
 }
 
@@ -75,6 +77,7 @@ int cache_zone_read(cache_zone_t *cache_zone, zone_t *zone) {
 	}
 
 	pthread_rwlock_unlock(&cache.zones_lock);
+	stats_zone_cache(status == 0);
 	return status;
 }
 
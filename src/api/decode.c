@@ -3,6 +3,7 @@
 #include "../lib/octet.h"
 #include "buffer.h"
 #include "config.h"
+#include "ingest.h"
 #include "metric.h"
 #include "radio.h"
 #include "reading.h"
@@ -365,227 +366,132 @@ int decode_kind_86(uint8_t *data, uint8_t data_len, time_t received_at, radio_t
 	return 0;
 }
 
-uint16_t decode(octet_t *db, uplink_t *uplink) {
+int decode_ingest(uplink_t *uplink, ingest_t *ingest) {
 	trace("decoding uplink kind %02x length %hhu\n", uplink->kind, uplink->data_len);
+	reading_t reading = {.device_id = uplink->device_id};
+	metric_t metric = {.device_id = uplink->device_id};
+	buffer_t buffer = {.device_id = uplink->device_id};
+	config_t config = {.device_id = uplink->device_id};
+	radio_t radio = {.device_id = uplink->device_id};
+	int decoded;
 	switch (uplink->kind) {
-	case 0x00: {
-		if (decode_kind_00(uplink->data_len, uplink->received_at) == -1) {
-			warn("failed to decode uplink kind %02x length %hhu\n", uplink->kind, uplink->data_len);
-			return 400;
-		}
-		return 0;
-	}
-	case 0x01: {
-		reading_t reading = {.device_id = uplink->device_id};
-		if (decode_kind_01(uplink->data, uplink->data_len, uplink->received_at, &reading) == -1) {
-			warn("failed to decode uplink kind %02x length %hhu\n", uplink->kind, uplink->data_len);
-			return 400;
-		}
-		uint16_t status;
-		if ((status = reading_insert(db, &reading)) != 0) {
-			return status;
-		}
-		return 0;
-	}
-	case 0x02: {
-		metric_t metric = {.device_id = uplink->device_id};
-		if (decode_kind_02(uplink->data, uplink->data_len, uplink->received_at, &metric) == -1) {
-			warn("failed to decode uplink kind %02x length %hhu\n", uplink->kind, uplink->data_len);
-			return 400;
-		}
-		uint16_t status;
-		if ((status = metric_insert(db, &metric)) != 0) {
-			return status;
-		}
-		return 0;
-	}
-	case 0x03: {
-		reading_t reading = {.device_id = uplink->device_id};
-		metric_t metric = {.device_id = uplink->device_id};
-		if (decode_kind_03(uplink->data, uplink->data_len, uplink->received_at, &reading, &metric) == -1) {
-			warn("failed to decode uplink kind %02x length %hhu\n", uplink->kind, uplink->data_len);
-			return 400;
-		}
-		uint16_t status;
-		if ((status = reading_insert(db, &reading)) != 0) {
-			return status;
-		}
-		if ((status = metric_insert(db, &metric)) != 0) {
-			return status;
-		}
-		return 0;
-	}
-	case 0x04: {
-		char firmware[16];
-		char hardware[16];
-		time_t updated_at;
-		device_t device = {
-				.id = uplink->device_id,
-				.name = NULL,
-				.zone_id = NULL,
-				.firmware = (char *)&firmware,
-				.hardware = (char *)&hardware,
-				.updated_at = &updated_at,
-		};
-		if (decode_kind_04(uplink->data, uplink->data_len, uplink->received_at, &device) == -1) {
-			warn("failed to decode uplink kind %02x length %hhu\n", uplink->kind, uplink->data_len);
-			return 400;
-		}
-		uint16_t status;
-		if ((status = device_update(db, &device)) != 0) {
-			return status;
-		}
-		return 0;
-	}
-	case 0x05: {
-		config_t config = {.device_id = uplink->device_id};
-		if (decode_kind_05(uplink->data, uplink->data_len, uplink->received_at, &config) == -1) {
-			warn("failed to decode uplink kind %02x length %hhu\n", uplink->kind, uplink->data_len);
-			return 400;
-		}
-		uint16_t status;
-		if ((status = config_insert(db, &config)) != 0) {
-			return status;
-		}
-		return 0;
-	}
-	case 0x06: {
-		radio_t radio = {.device_id = uplink->device_id};
-		if (decode_kind_06(uplink->data, uplink->data_len, uplink->received_at, &radio) == -1) {
-			warn("failed to decode uplink kind %02x length %hhu\n", uplink->kind, uplink->data_len);
-			return 400;
-		}
-		uint16_t status;
-		if ((status = radio_insert(db, &radio)) != 0) {
-			return status;
-		}
-		return 0;
-	}
-	case 0x80: {
-		buffer_t buffer = {.device_id = uplink->device_id};
-		if (decode_kind_80(uplink->data, uplink->data_len, uplink->received_at, &buffer) == -1) {
-			warn("failed to decode uplink kind %02x length %hhu\n", uplink->kind, uplink->data_len);
-			return 400;
-		}
-		uint16_t status;
-		if ((status = buffer_insert(db, &buffer)) != 0) {
-			return status;
-		}
-		return 0;
-	}
-	case 0x81: {
-		reading_t reading = {.device_id = uplink->device_id};
-		buffer_t buffer = {.device_id = uplink->device_id};
-		if (decode_kind_81(uplink->data, uplink->data_len, uplink->received_at, &reading, &buffer) == -1) {
-			warn("failed to decode uplink kind %02x length %hhu\n", uplink->kind, uplink->data_len);
-			return 400;
-		}
-		uint16_t status;
-		if ((status = reading_insert(db, &reading)) != 0) {
-			return status;
-		}
-		if ((status = buffer_insert(db, &buffer)) != 0) {
-			return status;
-		}
-		return 0;
-	}
-	case 0x82: {
-		metric_t metric = {.device_id = uplink->device_id};
-		buffer_t buffer = {.device_id = uplink->device_id};
-		if (decode_kind_82(uplink->data, uplink->data_len, uplink->received_at, &metric, &buffer) == -1) {
-			warn("failed to decode uplink kind %02x length %hhu\n", uplink->kind, uplink->data_len);
-			return 400;
-		}
-		uint16_t status;
-		if ((status = metric_insert(db, &metric)) != 0) {
-			return status;
-		}
-		if ((status = buffer_insert(db, &buffer)) != 0) {
-			return status;
-		}
-		return 0;
-	}
-	case 0x83: {
-		reading_t reading = {.device_id = uplink->device_id};
-		metric_t metric = {.device_id = uplink->device_id};
-		buffer_t buffer = {.device_id = uplink->device_id};
-		if (decode_kind_83(uplink->data, uplink->data_len, uplink->received_at, &reading, &metric, &buffer) == -1) {
-			warn("failed to decode uplink kind %02x length %hhu\n", uplink->kind, uplink->data_len);
-			return 400;
-		}
-		uint16_t status;
-		if ((status = reading_insert(db, &reading)) != 0) {
-			return status;
-		}
-		if ((status = metric_insert(db, &metric)) != 0) {
-			return status;
-		}
-		if ((status = buffer_insert(db, &buffer)) != 0) {
-			return status;
-		}
-		return 0;
+	case 0x00:
+		decoded = decode_kind_00(uplink->data_len, uplink->received_at);
+		break;
+	case 0x01:
+		decoded = decode_kind_01(uplink->data, uplink->data_len, uplink->received_at, &reading);
+		if (decoded == 0) {
+			ingest->readings[ingest->readings_len++] = reading;
+		}
+		break;
+	case 0x02:
+		decoded = decode_kind_02(uplink->data, uplink->data_len, uplink->received_at, &metric);
+		if (decoded == 0) {
+			ingest->metrics[ingest->metrics_len++] = metric;
+		}
+		break;
+	case 0x03:
+		decoded = decode_kind_03(uplink->data, uplink->data_len, uplink->received_at, &reading, &metric);
+		if (decoded == 0) {
+			ingest->readings[ingest->readings_len++] = reading;
+			ingest->metrics[ingest->metrics_len++] = metric;
+		}
+		break;
+	case 0x04:
+		decoded = decode_kind_04(uplink->data, uplink->data_len, uplink->received_at, &ingest->device);
+		if (decoded == 0) {
+			ingest->updated = true;
+		}
+		break;
+	case 0x05:
+		decoded = decode_kind_05(uplink->data, uplink->data_len, uplink->received_at, &config);
+		if (decoded == 0) {
+			ingest->configs[ingest->configs_len++] = config;
+		}
+		break;
+	case 0x06:
+		decoded = decode_kind_06(uplink->data, uplink->data_len, uplink->received_at, &radio);
+		if (decoded == 0) {
+			ingest->radios[ingest->radios_len++] = radio;
+		}
+		break;
+	case 0x80:
+		decoded = decode_kind_80(uplink->data, uplink->data_len, uplink->received_at, &buffer);
+		if (decoded == 0) {
+			ingest->buffers[ingest->buffers_len++] = buffer;
+		}
+		break;
+	case 0x81:
+		decoded = decode_kind_81(uplink->data, uplink->data_len, uplink->received_at, &reading, &buffer);
+		if (decoded == 0) {
+			ingest->readings[ingest->readings_len++] = reading;
+			ingest->buffers[ingest->buffers_len++] = buffer;
+		}
+		break;
+	case 0x82:
+		decoded = decode_kind_82(uplink->data, uplink->data_len, uplink->received_at, &metric, &buffer);
+		if (decoded == 0) {
+			ingest->metrics[ingest->metrics_len++] = metric;
+			ingest->buffers[ingest->buffers_len++] = buffer;
+		}
+		break;
+	case 0x83:
+		decoded = decode_kind_83(uplink->data, uplink->data_len, uplink->received_at, &reading, &metric, &buffer);
+		if (decoded == 0) {
+			ingest->readings[ingest->readings_len++] = reading;
+			ingest->metrics[ingest->metrics_len++] = metric;
+			ingest->buffers[ingest->buffers_len++] = buffer;
+		}
+		break;
+	case 0x84:
+		decoded = decode_kind_84(uplink->data, uplink->data_len, uplink->received_at, &ingest->device, &buffer);
+		if (decoded == 0) {
+			ingest->updated = true;
+			ingest->buffers[ingest->buffers_len++] = buffer;
+		}
+		break;
+	case 0x85:
+		decoded = decode_kind_85(uplink->data, uplink->data_len, uplink->received_at, &config, &buffer);
+		if (decoded == 0) {
+			ingest->configs[ingest->configs_len++] = config;
+			ingest->buffers[ingest->buffers_len++] = buffer;
+		}
+		break;
+	case 0x86:
+		decoded = decode_kind_86(uplink->data, uplink->data_len, uplink->received_at, &radio, &buffer);
+		if (decoded == 0) {
+			ingest->radios[ingest->radios_len++] = radio;
+			ingest->buffers[ingest->buffers_len++] = buffer;
+		}
+		break;
+	default:
+		warn("unknown uplink kind %02x\n", uplink->kind);
+		return -1;
 	}
-	case 0x84: {
-		char firmware[16];
-		char hardware[16];
-		time_t updated_at;
-		device_t device = {
-				.id = uplink->device_id,
-				.name = NULL,
-				.zone_id = NULL,
-				.firmware = (char *)&firmware,
-				.hardware = (char *)&hardware,
-				.updated_at = &updated_at,
-		};
-		buffer_t buffer = {.device_id = uplink->device_id};
-		if (decode_kind_84(uplink->data, uplink->data_len, uplink->received_at, &device, &buffer) == -1) {
-			warn("failed to decode uplink kind %02x length %hhu\n", uplink->kind, uplink->data_len);
-			return 400;
-		}
-		uint16_t status;
-		if ((status = device_update(db, &device)) != 0) {
-			return status;
-		}
-		if ((status = buffer_insert(db, &buffer)) != 0) {
-			return status;
-		}
-		return 0;
+
+	if (decoded == -1) {
+		warn("failed to decode uplink kind %02x length %hhu\n", uplink->kind, uplink->data_len);
+		return -1;
 	}
-	case 0x85: {
-		config_t config = {.device_id = uplink->device_id};
-		buffer_t buffer = {.device_id = uplink->device_id};
-		if (decode_kind_85(uplink->data, uplink->data_len, uplink->received_at, &config, &buffer) == -1) {
-			warn("failed to decode uplink kind %02x length %hhu\n", uplink->kind, uplink->data_len);
-			return 400;
-		}
-		uint16_t status;
-		if ((status = config_insert(db, &config)) != 0) {
-			return status;
-		}
-		if ((status = buffer_insert(db, &buffer)) != 0) {
-			return status;
-		}
-		return 0;
+	return 0;
+}
+
+uint16_t decode(octet_t *db, uplink_t *uplink) {
+	ingest_t ingest;
+	if (ingest_init(&ingest, &db->arena, uplink->device_id, 1) == -1) {
+		return 500;
 	}
-	case 0x86: {
-		radio_t radio = {.device_id = uplink->device_id};
-		buffer_t buffer = {.device_id = uplink->device_id};
-		if (decode_kind_86(uplink->data, uplink->data_len, uplink->received_at, &radio, &buffer) == -1) {
-			warn("failed to decode uplink kind %02x length %hhu\n", uplink->kind, uplink->data_len);
-			return 400;
-		}
-		uint16_t status;
-		if ((status = radio_insert(db, &radio)) != 0) {
-			return status;
-		}
-		if ((status = buffer_insert(db, &buffer)) != 0) {
-			return status;
-		}
-		return 0;
+
+	ingest.uplinks[ingest.uplinks_len++] = *uplink;
+	int decoded = decode_ingest(uplink, &ingest);
+
+	uint16_t status = ingest_commit(db, &ingest);
+	if (status != 0) {
+		return status;
 	}
-	default: {
-		warn("unknown uplink kind %02x\n", uplink->kind);
+
+	if (decoded == -1) {
 		return 400;
 	}
-	}
+	return 0;
 }
@@ -1,7 +1,9 @@
 #pragma once
 
 #include "../lib/octet.h"
+#include "ingest.h"
 #include "uplink.h"
 #include <stdint.h>
 
+int decode_ingest(uplink_t *uplink, ingest_t *ingest);
 uint16_t decode(octet_t *db, uplink_t *uplink);
@@ -1,6 +1,7 @@
 #include "device.h"
 #include "../app/airtime.h"
 #include "../app/packet.h"
+#include "../lib/arena.h"
 #include "../lib/base16.h"
 #include "../lib/bwt.h"
 #include "../lib/endian.h"
@@ -8,6 +9,7 @@
 #include "../lib/octet.h"
 #include "../lib/request.h"
 #include "../lib/response.h"
+#include "../lib/span.h"
 #include "alert.h"
 #include "buffer.h"
 #include "cache.h"
@@ -346,7 +348,8 @@ uint16_t device_select(octet_t *db, bwt_t *bwt, device_query_t *query, response_
 
 	uint8_t user_devices_len = 0;
 	user_t user = {.id = &bwt->id};
-	status = user_device_select_by_user(db, &user, &user_devices_len);
+	uint8_t *user_devices;
+	status = user_device_select_by_user(db, &user, &user_devices, &user_devices_len);
 	if (status != 0) {
 		return status;
 	}
@@ -363,8 +366,8 @@ uint16_t device_select(octet_t *db, bwt_t *bwt, device_query_t *query, response_
 		goto cleanup;
 	}
 
-	if (stmt.stat.st_size > db->table_len) {
-		error("file length %zu exceeds buffer length %u\n", (size_t)stmt.stat.st_size, db->table_len);
+	uint8_t *table = arena_alloc(&db->arena, (size_t)stmt.stat.st_size);
+	if (table == NULL) {
 		status = 500;
 		goto cleanup;
 	}
@@ -379,14 +382,14 @@ uint16_t device_select(octet_t *db, bwt_t *bwt, device_query_t *query, response_
 			status = 0;
 			break;
 		}
-		if (octet_row_read(&stmt, file, offset, &db->table[table_len], device_row.size) == -1) {
+		if (octet_row_read(&stmt, file, offset, &table[table_len], device_row.size) == -1) {
 			status = octet_error();
 			goto cleanup;
 		}
-		uint8_t (*id)[8] = (uint8_t (*)[8])octet_blob_read(&db->table[table_len], device_row.id);
+		uint8_t (*id)[8] = (uint8_t (*)[8])octet_blob_read(&table[table_len], device_row.id);
 		for (uint8_t index = 0; index < user_devices_len; index++) {
 			uint8_t (*device_id)[8] =
-					(uint8_t (*)[8])octet_blob_read(&db->chunk[index * user_device_row.size], user_device_row.device_id);
+					(uint8_t (*)[8])octet_blob_read(&user_devices[index * user_device_row.size], user_device_row.device_id);
 			if (memcmp(id, device_id, sizeof(*device_id)) == 0) {
 				table_len += device_row.size;
 				break;
@@ -396,12 +399,12 @@ uint16_t device_select(octet_t *db, bwt_t *bwt, device_query_t *query, response_
 	}
 
 	if (table_len >= device_row.size * 2) {
-		for (uint8_t index = 0; index < table_len / device_row.size - 1; index++) {
-			for (uint8_t ind = index + 1; ind < table_len / device_row.size; ind++) {
-				if (device_rowcmp(&db->table[index * device_row.size], &db->table[ind * device_row.size], query) > 0) {
-					memcpy(db->row, &db->table[index * device_row.size], device_row.size);
-					memcpy(&db->table[index * device_row.size], &db->table[ind * device_row.size], device_row.size);
-					memcpy(&db->table[ind * device_row.size], db->row, device_row.size);
+		for (uint32_t index = 0; index < table_len / device_row.size - 1; index++) {
+			for (uint32_t ind = index + 1; ind < table_len / device_row.size; ind++) {
+				if (device_rowcmp(&table[index * device_row.size], &table[ind * device_row.size], query) > 0) {
+					memcpy(db->row, &table[index * device_row.size], device_row.size);
+					memcpy(&table[index * device_row.size], &table[ind * device_row.size], device_row.size);
+					memcpy(&table[ind * device_row.size], db->row, device_row.size);
 				}
 			}
 		}
@@ -413,30 +416,30 @@ uint16_t device_select(octet_t *db, bwt_t *bwt, device_query_t *query, response_
 			status = 0;
 			break;
 		}
-		uint8_t (*id)[8] = (uint8_t (*)[8])octet_blob_read(&db->table[index], device_row.id);
-		uint8_t name_len = octet_uint8_read(&db->table[index], device_row.name_len);
-		char *name = octet_text_read(&db->table[index], device_row.name);
-		time_t created_at = (time_t)octet_uint64_read(&db->table[index], device_row.created_at);
-		uint8_t updated_at_null = octet_uint8_read(&db->table[index], device_row.updated_at_null);
-		time_t updated_at = (time_t)octet_uint64_read(&db->table[index], device_row.updated_at);
-		uint8_t zone_null = octet_uint8_read(&db->table[index], device_row.zone_null);
-		uint8_t (*zone_id)[8] = (uint8_t (*)[8])octet_blob_read(&db->table[index], device_row.zone_id);
-		uint8_t zone_name_len = octet_uint8_read(&db->table[index], device_row.zone_name_len);
-		char *zone_name = octet_text_read(&db->table[index], device_row.zone_name);
-		uint8_t (*zone_color)[12] = (uint8_t (*)[12])octet_blob_read(&db->table[index], device_row.zone_color);
-		uint8_t reading_null = octet_uint8_read(&db->table[index], device_row.reading_null);
-		int16_t reading_temperature = octet_int16_read(&db->table[index], device_row.reading_temperature);
-		uint16_t reading_humidity = octet_uint16_read(&db->table[index], device_row.reading_humidity);
-		int16_t reading_dewpoint = octet_int16_read(&db->table[index], device_row.reading_dewpoint);
-		time_t reading_captured_at = (time_t)octet_uint64_read(&db->table[index], device_row.reading_captured_at);
-		uint8_t metric_null = octet_uint8_read(&db->table[index], device_row.metric_null);
-		uint16_t metric_photovoltaic = octet_uint16_read(&db->table[index], device_row.metric_photovoltaic);
-		uint16_t metric_battery = octet_uint16_read(&db->table[index], device_row.metric_battery);
-		time_t metric_captured_at = (time_t)octet_uint64_read(&db->table[index], device_row.metric_captured_at);
-		uint8_t buffer_null = octet_uint8_read(&db->table[index], device_row.buffer_null);
-		uint32_t buffer_delay = octet_uint32_read(&db->table[index], device_row.buffer_delay);
-		uint16_t buffer_level = octet_uint16_read(&db->table[index], device_row.buffer_level);
-		time_t buffer_captured_at = (time_t)octet_uint64_read(&db->table[index], device_row.buffer_captured_at);
+		uint8_t (*id)[8] = (uint8_t (*)[8])octet_blob_read(&table[index], device_row.id);
+		uint8_t name_len = octet_uint8_read(&table[index], device_row.name_len);
+		char *name = octet_text_read(&table[index], device_row.name);
+		time_t created_at = (time_t)octet_uint64_read(&table[index], device_row.created_at);
+		uint8_t updated_at_null = octet_uint8_read(&table[index], device_row.updated_at_null);
+		time_t updated_at = (time_t)octet_uint64_read(&table[index], device_row.updated_at);
+		uint8_t zone_null = octet_uint8_read(&table[index], device_row.zone_null);
+		uint8_t (*zone_id)[8] = (uint8_t (*)[8])octet_blob_read(&table[index], device_row.zone_id);
+		uint8_t zone_name_len = octet_uint8_read(&table[index], device_row.zone_name_len);
+		char *zone_name = octet_text_read(&table[index], device_row.zone_name);
+		uint8_t (*zone_color)[12] = (uint8_t (*)[12])octet_blob_read(&table[index], device_row.zone_color);
+		uint8_t reading_null = octet_uint8_read(&table[index], device_row.reading_null);
+		int16_t reading_temperature = octet_int16_read(&table[index], device_row.reading_temperature);
+		uint16_t reading_humidity = octet_uint16_read(&table[index], device_row.reading_humidity);
+		int16_t reading_dewpoint = octet_int16_read(&table[index], device_row.reading_dewpoint);
+		time_t reading_captured_at = (time_t)octet_uint64_read(&table[index], device_row.reading_captured_at);
+		uint8_t metric_null = octet_uint8_read(&table[index], device_row.metric_null);
+		uint16_t metric_photovoltaic = octet_uint16_read(&table[index], device_row.metric_photovoltaic);
+		uint16_t metric_battery = octet_uint16_read(&table[index], device_row.metric_battery);
+		time_t metric_captured_at = (time_t)octet_uint64_read(&table[index], device_row.metric_captured_at);
+		uint8_t buffer_null = octet_uint8_read(&table[index], device_row.buffer_null);
+		uint32_t buffer_delay = octet_uint32_read(&table[index], device_row.buffer_delay);
+		uint16_t buffer_level = octet_uint16_read(&table[index], device_row.buffer_level);
+		time_t buffer_captured_at = (time_t)octet_uint64_read(&table[index], device_row.buffer_captured_at);
 		body_write(response, id, sizeof(*id));
 		body_write(response, name, name_len);
 		body_write(response, (char[]){0x00}, sizeof(char));
@@ -660,7 +663,8 @@ uint16_t device_select_by_user(octet_t *db, user_t *user, device_query_t *query,
 	uint16_t status;
 
 	uint8_t user_devices_len = 0;
-	status = user_device_select_by_user(db, user, &user_devices_len);
+	uint8_t *user_devices;
+	status = user_device_select_by_user(db, user, &user_devices, &user_devices_len);
 	if (status != 0) {
 		return status;
 	}
@@ -677,8 +681,8 @@ uint16_t device_select_by_user(octet_t *db, user_t *user, device_query_t *query,
 		goto cleanup;
 	}
 
-	if (stmt.stat.st_size > db->table_len) {
-		error("file length %zu exceeds buffer length %u\n", (size_t)stmt.stat.st_size, db->table_len);
+	uint8_t *table = arena_alloc(&db->arena, (size_t)stmt.stat.st_size);
+	if (table == NULL) {
 		status = 500;
 		goto cleanup;
 	}
@@ -693,14 +697,14 @@ uint16_t device_select_by_user(octet_t *db, user_t *user, device_query_t *query,
 			status = 0;
 			break;
 		}
-		if (octet_row_read(&stmt, file, offset, &db->table[table_len], device_row.size) == -1) {
+		if (octet_row_read(&stmt, file, offset, &table[table_len], device_row.size) == -1) {
 			status = octet_error();
 			goto cleanup;
 		}
-		uint8_t (*id)[8] = (uint8_t (*)[8])octet_blob_read(&db->table[table_len], device_row.id);
+		uint8_t (*id)[8] = (uint8_t (*)[8])octet_blob_read(&table[table_len], device_row.id);
 		for (uint8_t index = 0; index < user_devices_len; index++) {
 			uint8_t (*device_id)[8] =
-					(uint8_t (*)[8])octet_blob_read(&db->chunk[index * user_device_row.size], user_device_row.device_id);
+					(uint8_t (*)[8])octet_blob_read(&user_devices[index * user_device_row.size], user_device_row.device_id);
 			if (memcmp(id, device_id, sizeof(*device_id)) == 0) {
 				table_len += device_row.size;
 				break;
@@ -710,12 +714,12 @@ uint16_t device_select_by_user(octet_t *db, user_t *user, device_query_t *query,
 	}
 
 	if (table_len >= device_row.size * 2) {
-		for (uint8_t index = 0; index < table_len / device_row.size - 1; index++) {
-			for (uint8_t ind = index + 1; ind < table_len / device_row.size; ind++) {
-				if (device_rowcmp(&db->table[index * device_row.size], &db->table[ind * device_row.size], query) > 0) {
-					memcpy(db->row, &db->table[index * device_row.size], device_row.size);
-					memcpy(&db->table[index * device_row.size], &db->table[ind * device_row.size], device_row.size);
-					memcpy(&db->table[ind * device_row.size], db->row, device_row.size);
+		for (uint32_t index = 0; index < table_len / device_row.size - 1; index++) {
+			for (uint32_t ind = index + 1; ind < table_len / device_row.size; ind++) {
+				if (device_rowcmp(&table[index * device_row.size], &table[ind * device_row.size], query) > 0) {
+					memcpy(db->row, &table[index * device_row.size], device_row.size);
+					memcpy(&table[index * device_row.size], &table[ind * device_row.size], device_row.size);
+					memcpy(&table[ind * device_row.size], db->row, device_row.size);
 				}
 			}
 		}
@@ -727,19 +731,19 @@ uint16_t device_select_by_user(octet_t *db, user_t *user, device_query_t *query,
 			status = 0;
 			break;
 		}
-		uint8_t (*id)[8] = (uint8_t (*)[8])octet_blob_read(&db->table[index], device_row.id);
-		uint8_t name_len = octet_uint8_read(&db->table[index], device_row.name_len);
-		char *name = octet_text_read(&db->table[index], device_row.name);
-		time_t created_at = (time_t)octet_uint64_read(&db->table[index], device_row.created_at);
-		uint8_t updated_at_null = octet_uint8_read(&db->table[index], device_row.updated_at_null);
-		time_t updated_at = (time_t)octet_uint64_read(&db->table[index], device_row.updated_at);
-		uint8_t zone_null = octet_uint8_read(&db->table[index], device_row.zone_null);
-		uint8_t (*zone_id)[8] = (uint8_t (*)[8])octet_blob_read(&db->table[index], device_row.zone_id);
-		uint8_t zone_name_len = octet_uint8_read(&db->table[index], device_row.zone_name_len);
-		char *zone_name = octet_text_read(&db->table[index], device_row.zone_name);
-		uint8_t (*zone_color)[12] = (uint8_t (*)[12])octet_blob_read(&db->table[index], device_row.zone_color);
-		uint8_t uplink_null = octet_uint8_read(&db->table[index], device_row.uplink_null);
-		time_t uplink_received_at = (time_t)octet_uint64_read(&db->table[index], device_row.uplink_received_at);
+		uint8_t (*id)[8] = (uint8_t (*)[8])octet_blob_read(&table[index], device_row.id);
+		uint8_t name_len = octet_uint8_read(&table[index], device_row.name_len);
+		char *name = octet_text_read(&table[index], device_row.name);
+		time_t created_at = (time_t)octet_uint64_read(&table[index], device_row.created_at);
+		uint8_t updated_at_null = octet_uint8_read(&table[index], device_row.updated_at_null);
+		time_t updated_at = (time_t)octet_uint64_read(&table[index], device_row.updated_at);
+		uint8_t zone_null = octet_uint8_read(&table[index], device_row.zone_null);
+		uint8_t (*zone_id)[8] = (uint8_t (*)[8])octet_blob_read(&table[index], device_row.zone_id);
+		uint8_t zone_name_len = octet_uint8_read(&table[index], device_row.zone_name_len);
+		char *zone_name = octet_text_read(&table[index], device_row.zone_name);
+		uint8_t (*zone_color)[12] = (uint8_t (*)[12])octet_blob_read(&table[index], device_row.zone_color);
+		uint8_t uplink_null = octet_uint8_read(&table[index], device_row.uplink_null);
+		time_t uplink_received_at = (time_t)octet_uint64_read(&table[index], device_row.uplink_received_at);
 		body_write(response, id, sizeof(*id));
 		body_write(response, name, name_len);
 		body_write(response, (char[]){0x00}, sizeof(char));
@@ -768,7 +772,7 @@ cleanup:
 	return status;
 }
 
-uint16_t device_select_by_zone(octet_t *db, zone_t *zone, uint8_t *devices_len) {
+uint16_t device_select_by_zone(octet_t *db, zone_t *zone, uint8_t **devices, uint8_t *devices_len) {
 	uint16_t status;
 
 	char file[128];
@@ -783,24 +787,30 @@ uint16_t device_select_by_zone(octet_t *db, zone_t *zone, uint8_t *devices_len)
 		goto cleanup;
 	}
 
+	*devices = arena_alloc(&db->arena, (size_t)stmt.stat.st_size);
+	if (*devices == NULL) {
+		status = 500;
+		goto cleanup;
+	}
+
 	debug("select devices for zone %02x%02x\n", (*zone->id)[0], (*zone->id)[1]);
 
 	off_t offset = 0;
-	uint16_t chunk_len = 0;
+	uint32_t devices_size = 0;
 	while (true) {
 		if (offset >= stmt.stat.st_size) {
 			status = 0;
 			break;
 		}
-		if (octet_row_read(&stmt, file, offset, &db->chunk[chunk_len], device_row.size) == -1) {
+		if (octet_row_read(&stmt, file, offset, &(*devices)[devices_size], device_row.size) == -1) {
 			status = octet_error();
 			goto cleanup;
 		}
-		uint8_t zone_null = octet_uint8_read(&db->chunk[chunk_len], device_row.zone_null);
-		uint8_t (*zone_id)[8] = (uint8_t (*)[8])octet_blob_read(&db->chunk[chunk_len], device_row.zone_id);
+		uint8_t zone_null = octet_uint8_read(&(*devices)[devices_size], device_row.zone_null);
+		uint8_t (*zone_id)[8] = (uint8_t (*)[8])octet_blob_read(&(*devices)[devices_size], device_row.zone_id);
 		if (zone_null != 0x00 && memcmp(zone_id, zone->id, sizeof(*zone->id)) == 0) {
 			*devices_len += 1;
-			chunk_len += device_row.size;
+			devices_size += device_row.size;
 		}
 		offset += device_row.size;
 	}
@@ -1185,6 +1195,92 @@ cleanup:
 	return status;
 }
 
+void device_latest(uint8_t *row, device_t *device) {
+	uint8_t zone_null = octet_uint8_read(row, device_row.zone_null);
+	uint8_t (*zone_id)[8] = (uint8_t (*)[8])octet_blob_read(row, device_row.zone_id);
+	if (zone_null != 0x00) {
+		memcpy(device->zone_id, zone_id, sizeof(*zone_id));
+	} else {
+		device->zone_id = NULL;
+	}
+	if (device->firmware != NULL) {
+		octet_uint8_write(row, device_row.firmware_len, device->firmware_len);
+		octet_text_write(row, device_row.firmware, device->firmware, device->firmware_len);
+	}
+	if (device->hardware != NULL) {
+		octet_uint8_write(row, device_row.hardware_len, device->hardware_len);
+		octet_text_write(row, device_row.hardware, device->hardware, device->hardware_len);
+	}
+	if (device->updated_at != NULL) {
+		octet_uint8_write(row, device_row.updated_at_null, 0x01);
+		octet_uint64_write(row, device_row.updated_at, (uint64_t)*device->updated_at);
+	}
+	uint8_t reading_null = octet_uint8_read(row, device_row.reading_null);
+	time_t reading_captured_at = (time_t)octet_uint64_read(row, device_row.reading_captured_at);
+	if (device->reading != NULL && (reading_null == 0x00 || device->reading->captured_at >= reading_captured_at)) {
+		octet_uint8_write(row, device_row.reading_null, 0x01);
+		octet_int16_write(row, device_row.reading_temperature, (int16_t)(device->reading->temperature * 100));
+		octet_uint16_write(row, device_row.reading_humidity, (uint16_t)(device->reading->humidity * 100));
+		octet_int16_write(row, device_row.reading_dewpoint, (int16_t)(device->reading->dewpoint * 100));
+		octet_uint64_write(row, device_row.reading_captured_at, (uint64_t)device->reading->captured_at);
+	}
+	uint8_t metric_null = octet_uint8_read(row, device_row.metric_null);
+	time_t metric_captured_at = (time_t)octet_uint64_read(row, device_row.metric_captured_at);
+	if (device->metric != NULL && (metric_null == 0x00 || device->metric->captured_at >= metric_captured_at)) {
+		octet_uint8_write(row, device_row.metric_null, 0x01);
+		octet_uint16_write(row, device_row.metric_photovoltaic, (uint16_t)(device->metric->photovoltaic * 1000));
+		octet_uint16_write(row, device_row.metric_battery, (uint16_t)(device->metric->battery * 1000));
+		octet_uint64_write(row, device_row.metric_captured_at, (uint64_t)device->metric->captured_at);
+	}
+	uint8_t buffer_null = octet_uint8_read(row, device_row.buffer_null);
+	time_t buffer_captured_at = (time_t)octet_uint64_read(row, device_row.buffer_captured_at);
+	if (device->buffer != NULL && (buffer_null == 0x00 || device->buffer->captured_at >= buffer_captured_at)) {
+		octet_uint8_write(row, device_row.buffer_null, 0x01);
+		octet_uint32_write(row, device_row.buffer_delay, device->buffer->delay);
+		octet_uint16_write(row, device_row.buffer_level, device->buffer->level);
+		octet_uint64_write(row, device_row.buffer_captured_at, (uint64_t)device->buffer->captured_at);
+	}
+	for (uint16_t index = 0; device->uplink != NULL && index < device->uplinks_len; index++) {
+		uplink_t *uplink = &device->uplink[index];
+		uint8_t uplink_null = octet_uint8_read(row, device_row.uplink_null);
+		time_t uplink_received_at = (time_t)octet_uint64_read(row, device_row.uplink_received_at);
+		if (uplink_null != 0x00 && uplink->received_at < uplink_received_at) {
+			continue;
+		}
+		uint16_t (*airtime)[8] = (uint16_t (*)[8])octet_blob_read(row, device_row.airtime);
+		time_t airtime_bucket = (time_t)octet_uint64_read(row, device_row.airtime_bucket);
+		airtime_account(airtime, &airtime_bucket, uplink);
+		octet_blob_write(row, device_row.airtime, (uint8_t *)airtime, sizeof(*airtime));
+		octet_uint64_write(row, device_row.airtime_bucket, (uint64_t)airtime_bucket);
+		uint8_t (*packet_rx)[8] = (uint8_t (*)[8])octet_blob_read(row, device_row.packet_rx);
+		uint8_t (*packet_lost)[8] = (uint8_t (*)[8])octet_blob_read(row, device_row.packet_lost);
+		time_t packet_bucket = (time_t)octet_uint64_read(row, device_row.packet_bucket);
+		uint16_t last_frame = octet_uint16_read(row, device_row.uplink_frame);
+		packet_account(packet_rx, packet_lost, &packet_bucket, &last_frame, uplink);
+		octet_blob_write(row, device_row.packet_rx, (uint8_t *)packet_rx, sizeof(*packet_rx));
+		octet_blob_write(row, device_row.packet_lost, (uint8_t *)packet_lost, sizeof(*packet_lost));
+		octet_uint64_write(row, device_row.packet_bucket, (uint64_t)packet_bucket);
+		octet_uint8_write(row, device_row.uplink_null, 0x01);
+		octet_uint16_write(row, device_row.uplink_frame, uplink->frame);
+		octet_uint8_write(row, device_row.uplink_kind, uplink->kind);
+		octet_int16_write(row, device_row.uplink_rssi, uplink->rssi);
+		octet_int8_write(row, device_row.uplink_snr, uplink->snr);
+		octet_uint8_write(row, device_row.uplink_sf, uplink->sf);
+		octet_uint64_write(row, device_row.uplink_received_at, (uint64_t)uplink->received_at);
+	}
+	uint8_t downlink_null = octet_uint8_read(row, device_row.downlink_null);
+	time_t downlink_sent_at = (time_t)octet_uint64_read(row, device_row.downlink_sent_at);
+	if (device->downlink != NULL && (downlink_null == 0x00 || device->downlink->sent_at >= downlink_sent_at)) {
+		octet_uint8_write(row, device_row.downlink_null, 0x01);
+		octet_uint16_write(row, device_row.downlink_frame, device->downlink->frame);
+		octet_uint8_write(row, device_row.downlink_kind, device->downlink->kind);
+		octet_uint8_write(row, device_row.downlink_sf, device->downlink->sf);
+		octet_uint8_write(row, device_row.downlink_cr, device->downlink->cr);
+		octet_uint8_write(row, device_row.downlink_tx_power, device->downlink->tx_power);
+		octet_uint64_write(row, device_row.downlink_sent_at, (uint64_t)device->downlink->sent_at);
+	}
+}
+
 uint16_t device_update_latest(octet_t *db, device_t *device) {
 	uint16_t status;
 
@@ -1213,73 +1309,7 @@ uint16_t device_update_latest(octet_t *db, device_t *device) {
 		}
 		uint8_t (*id)[8] = (uint8_t (*)[8])octet_blob_read(db->row, device_row.id);
 		if (memcmp(id, device->id, sizeof(*device->id)) == 0) {
-			uint8_t zone_null = octet_uint8_read(db->row, device_row.zone_null);
-			uint8_t (*zone_id)[8] = (uint8_t (*)[8])octet_blob_read(db->row, device_row.zone_id);
-			if (zone_null != 0x00) {
-				memcpy(device->zone_id, zone_id, sizeof(*zone_id));
-			} else {
-				device->zone_id = NULL;
-			}
-			uint8_t reading_null = octet_uint8_read(db->row, device_row.reading_null);
-			time_t reading_captured_at = (time_t)octet_uint64_read(db->row, device_row.reading_captured_at);
-			if (device->reading != NULL && (reading_null == 0x00 || device->reading->captured_at >= reading_captured_at)) {
-				octet_uint8_write(db->row, device_row.reading_null, 0x01);
-				octet_int16_write(db->row, device_row.reading_temperature, (int16_t)(device->reading->temperature * 100));
-				octet_uint16_write(db->row, device_row.reading_humidity, (uint16_t)(device->reading->humidity * 100));
-				octet_int16_write(db->row, device_row.reading_dewpoint, (int16_t)(device->reading->dewpoint * 100));
-				octet_uint64_write(db->row, device_row.reading_captured_at, (uint64_t)device->reading->captured_at);
-			}
-			uint8_t metric_null = octet_uint8_read(db->row, device_row.metric_null);
-			time_t metric_captured_at = (time_t)octet_uint64_read(db->row, device_row.metric_captured_at);
-			if (device->metric != NULL && (metric_null == 0x00 || device->metric->captured_at >= metric_captured_at)) {
-				octet_uint8_write(db->row, device_row.metric_null, 0x01);
-				octet_uint16_write(db->row, device_row.metric_photovoltaic, (uint16_t)(device->metric->photovoltaic * 1000));
-				octet_uint16_write(db->row, device_row.metric_battery, (uint16_t)(device->metric->battery * 1000));
-				octet_uint64_write(db->row, device_row.metric_captured_at, (uint64_t)device->metric->captured_at);
-			}
-			uint8_t buffer_null = octet_uint8_read(db->row, device_row.buffer_null);
-			time_t buffer_captured_at = (time_t)octet_uint64_read(db->row, device_row.buffer_captured_at);
-			if (device->buffer != NULL && (buffer_null == 0x00 || device->buffer->captured_at >= buffer_captured_at)) {
-				octet_uint8_write(db->row, device_row.buffer_null, 0x01);
-				octet_uint32_write(db->row, device_row.buffer_delay, device->buffer->delay);
-				octet_uint16_write(db->row, device_row.buffer_level, device->buffer->level);
-				octet_uint64_write(db->row, device_row.buffer_captured_at, (uint64_t)device->buffer->captured_at);
-			}
-			uint8_t uplink_null = octet_uint8_read(db->row, device_row.uplink_null);
-			time_t uplink_received_at = (time_t)octet_uint64_read(db->row, device_row.uplink_received_at);
-			if (device->uplink != NULL && (uplink_null == 0x00 || device->uplink->received_at >= uplink_received_at)) {
-				uint16_t (*airtime)[8] = (uint16_t (*)[8])octet_blob_read(db->row, device_row.airtime);
-				time_t airtime_bucket = (time_t)octet_uint64_read(db->row, device_row.airtime_bucket);
-				airtime_account(airtime, &airtime_bucket, device->uplink);
-				octet_blob_write(db->row, device_row.airtime, (uint8_t *)airtime, sizeof(*airtime));
-				octet_uint64_write(db->row, device_row.airtime_bucket, (uint64_t)airtime_bucket);
-				uint8_t (*packet_rx)[8] = (uint8_t (*)[8])octet_blob_read(db->row, device_row.packet_rx);
-				uint8_t (*packet_lost)[8] = (uint8_t (*)[8])octet_blob_read(db->row, device_row.packet_lost);
-				time_t packet_bucket = (time_t)octet_uint64_read(db->row, device_row.packet_bucket);
-				uint16_t last_frame = octet_uint16_read(db->row, device_row.uplink_frame);
-				packet_account(packet_rx, packet_lost, &packet_bucket, &last_frame, device->uplink);
-				octet_blob_write(db->row, device_row.packet_rx, (uint8_t *)packet_rx, sizeof(*packet_rx));
-				octet_blob_write(db->row, device_row.packet_lost, (uint8_t *)packet_lost, sizeof(*packet_lost));
-				octet_uint64_write(db->row, device_row.packet_bucket, (uint64_t)packet_bucket);
-				octet_uint8_write(db->row, device_row.uplink_null, 0x01);
-				octet_uint16_write(db->row, device_row.uplink_frame, device->uplink->frame);
-				octet_uint8_write(db->row, device_row.uplink_kind, device->uplink->kind);
-				octet_int16_write(db->row, device_row.uplink_rssi, device->uplink->rssi);
-				octet_int8_write(db->row, device_row.uplink_snr, device->uplink->snr);
-				octet_uint8_write(db->row, device_row.uplink_sf, device->uplink->sf);
-				octet_uint64_write(db->row, device_row.uplink_received_at, (uint64_t)device->uplink->received_at);
-			}
-			uint8_t downlink_null = octet_uint8_read(db->row, device_row.downlink_null);
-			time_t downlink_sent_at = (time_t)octet_uint64_read(db->row, device_row.downlink_sent_at);
-			if (device->downlink != NULL && (downlink_null == 0x00 || device->downlink->sent_at >= downlink_sent_at)) {
-				octet_uint8_write(db->row, device_row.downlink_null, 0x01);
-				octet_uint16_write(db->row, device_row.downlink_frame, device->downlink->frame);
-				octet_uint8_write(db->row, device_row.downlink_kind, device->downlink->kind);
-				octet_uint8_write(db->row, device_row.downlink_sf, device->downlink->sf);
-				octet_uint8_write(db->row, device_row.downlink_cr, device->downlink->cr);
-				octet_uint8_write(db->row, device_row.downlink_tx_power, device->downlink->tx_power);
-				octet_uint64_write(db->row, device_row.downlink_sent_at, (uint64_t)device->downlink->sent_at);
-			}
+			device_latest(db->row, device);
 			if (octet_row_write(&stmt, file, offset, db->row, device_row.size) == -1) {
 				status = octet_error();
 				goto cleanup;
@@ -1317,6 +1347,7 @@ void device_find(octet_t *db, bwt_t *bwt, request_t *request, response_t *respon
 
 	header_write(response, "content-type:application/octet-stream\r\n");
 	header_write(response, "content-length:%u\r\n", response->body.len);
+	span.emitted = devices_len;
 	info("found %hhu devices\n", devices_len);
 	response->status = 200;
 }
@@ -1418,6 +1449,7 @@ void device_find_by_user(octet_t *db, request_t *request, response_t *response)
 
 	header_write(response, "content-type:application/octet-stream\r\n");
 	header_write(response, "content-length:%u\r\n", response->body.len);
+	span.emitted = devices_len;
 	info("found %hhu devices\n", devices_len);
 	response->status = 200;
 }
@@ -35,6 +35,7 @@ typedef struct device_t {
 	metric_t *metric;
 	buffer_t *buffer;
 	uplink_t *uplink;
+	uint16_t uplinks_len;
 	downlink_t *downlink;
 } device_t;
 
@@ -107,10 +108,11 @@ uint16_t device_existing(octet_t *db, device_t *device);
 uint16_t device_select(octet_t *db, bwt_t *bwt, device_query_t *query, response_t *response, uint8_t *devices_len);
 uint16_t device_select_one(octet_t *db, bwt_t *bwt, device_t *device, response_t *response);
 uint16_t device_select_by_user(octet_t *db, user_t *user, device_query_t *query, response_t *response, uint8_t *devices_len);
-uint16_t device_select_by_zone(octet_t *db, zone_t *zone, uint8_t *devices_len);
+uint16_t device_select_by_zone(octet_t *db, zone_t *zone, uint8_t **devices, uint8_t *devices_len);
 uint16_t device_insert(octet_t *db, device_t *device);
 uint16_t device_update(octet_t *db, device_t *device);
 uint16_t device_update_zones(octet_t *db, zone_t *zone);
+void device_latest(uint8_t *row, device_t *device);
 uint16_t device_update_latest(octet_t *db, device_t *device);
 
 void device_find(octet_t *db, bwt_t *bwt, request_t *request, response_t *response);
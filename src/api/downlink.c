@@ -1,4 +1,5 @@
 #include "downlink.h"
+#include "../lib/arena.h"
 #include "../lib/base16.h"
 #include "../lib/bwt.h"
 #include "../lib/endian.h"
@@ -6,6 +7,7 @@
 #include "../lib/octet.h"
 #include "../lib/request.h"
 #include "../lib/response.h"
+#include "../lib/span.h"
 #include "../lib/strn.h"
 #include "cache.h"
 #include "device.h"
@@ -39,25 +41,31 @@ const downlink_row_t downlink_row = {
 uint16_t downlink_select(octet_t *db, bwt_t *bwt, downlink_query_t *query, response_t *response, uint8_t *downlinks_len) {
 	uint16_t status;
 
-	uint8_t devices_len;
+	uint8_t devices_len = 0;
 	user_t user = {.id = &bwt->id};
-	status = user_device_select_by_user(db, &user, &devices_len);
+	uint8_t *devices;
+	status = user_device_select_by_user(db, &user, &devices, &devices_len);
 	if (status != 0) {
 		return status;
 	}
 
 	debug("select downlinks for user %02x%02x limit %hhu offset %u\n", bwt->id[0], bwt->id[1], query->limit, query->offset);
 
-	char (*uuids)[16] = (char (*)[16])db->alpha;
-	char (*files)[128] = (char (*)[128])db->bravo;
-	off_t *offsets = (off_t *)db->charlie;
-	time_t *sent_ats = (time_t *)db->delta;
-	octet_stmt_t *stmts = (octet_stmt_t *)db->echo;
+	char (*uuids)[16] = arena_alloc(&db->arena, devices_len * sizeof(*uuids));
+	char (*files)[128] = arena_alloc(&db->arena, devices_len * sizeof(*files));
+	off_t *offsets = arena_alloc(&db->arena, devices_len * sizeof(*offsets));
+	time_t *sent_ats = arena_alloc(&db->arena, devices_len * sizeof(*sent_ats));
+	octet_stmt_t *stmts = arena_alloc(&db->arena, devices_len * sizeof(*stmts));
+	uint8_t *table = arena_alloc(&db->arena, devices_len * downlink_row.size);
+	if (uuids == NULL || files == NULL || offsets == NULL || sent_ats == NULL || stmts == NULL || table == NULL) {
+		return 500;
+	}
+
 	uint8_t stmts_len = 0;
 
 	for (uint8_t index = 0; index < devices_len; index++) {
 		uint8_t (*device_id)[8] =
-				(uint8_t (*)[8])octet_blob_read(&db->chunk[index * user_device_row.size], user_device_row.device_id);
+				(uint8_t (*)[8])octet_blob_read(&devices[index * user_device_row.size], user_device_row.device_id);
 
 		if (base16_encode(uuids[index], sizeof(uuids[index]), device_id, sizeof(*device_id)) == -1) {
 			error("failed to encode uuid to base 16\n");
@@ -84,12 +92,12 @@ uint16_t downlink_select(octet_t *db, bwt_t *bwt, downlink_query_t *query, respo
 		if (offsets[index] < 0) {
 			continue;
 		}
-		if (octet_row_read(&stmts[index], files[index], offsets[index], &db->table[index * downlink_row.size], downlink_row.size) ==
+		if (octet_row_read(&stmts[index], files[index], offsets[index], &table[index * downlink_row.size], downlink_row.size) ==
 				-1) {
 			status = octet_error();
 			goto cleanup;
 		}
-		sent_ats[index] = (time_t)octet_uint64_read(&db->table[index * downlink_row.size], downlink_row.sent_at);
+		sent_ats[index] = (time_t)octet_uint64_read(&table[index * downlink_row.size], downlink_row.sent_at);
 	}
 
 	while (*downlinks_len < query->limit) {
@@ -108,21 +116,21 @@ uint16_t downlink_select(octet_t *db, bwt_t *bwt, downlink_query_t *query, respo
 		}
 
 		if (query->offset == 0) {
-			uint16_t frame = octet_uint16_read(&db->table[index * downlink_row.size], downlink_row.frame);
-			uint8_t kind = octet_uint8_read(&db->table[index * downlink_row.size], downlink_row.kind);
-			uint8_t data_len = octet_uint8_read(&db->table[index * downlink_row.size], downlink_row.data_len);
-			uint8_t (*data)[32] = (uint8_t (*)[32])octet_blob_read(&db->table[index * downlink_row.size], downlink_row.data);
-			uint16_t airtime = octet_uint16_read(&db->table[index * downlink_row.size], downlink_row.airtime);
-			uint32_t frequency = octet_uint32_read(&db->table[index * downlink_row.size], downlink_row.frequency);
-			uint32_t bandwidth = octet_uint32_read(&db->table[index * downlink_row.size], downlink_row.bandwidth);
-			uint8_t sf = octet_uint8_read(&db->table[index * downlink_row.size], downlink_row.sf);
-			uint8_t cr = octet_uint8_read(&db->table[index * downlink_row.size], downlink_row.cr);
-			bool crc = octet_bool_read(&db->table[index * downlink_row.size], downlink_row.crc);
-			uint8_t tx_power = octet_uint8_read(&db->table[index * downlink_row.size], downlink_row.tx_power);
-			uint8_t preamble_len = octet_uint8_read(&db->table[index * downlink_row.size], downlink_row.preamble_len);
-			time_t sent_at = (time_t)octet_uint64_read(&db->table[index * downlink_row.size], downlink_row.sent_at);
+			uint16_t frame = octet_uint16_read(&table[index * downlink_row.size], downlink_row.frame);
+			uint8_t kind = octet_uint8_read(&table[index * downlink_row.size], downlink_row.kind);
+			uint8_t data_len = octet_uint8_read(&table[index * downlink_row.size], downlink_row.data_len);
+			uint8_t (*data)[32] = (uint8_t (*)[32])octet_blob_read(&table[index * downlink_row.size], downlink_row.data);
+			uint16_t airtime = octet_uint16_read(&table[index * downlink_row.size], downlink_row.airtime);
+			uint32_t frequency = octet_uint32_read(&table[index * downlink_row.size], downlink_row.frequency);
+			uint32_t bandwidth = octet_uint32_read(&table[index * downlink_row.size], downlink_row.bandwidth);
+			uint8_t sf = octet_uint8_read(&table[index * downlink_row.size], downlink_row.sf);
+			uint8_t cr = octet_uint8_read(&table[index * downlink_row.size], downlink_row.cr);
+			bool crc = octet_bool_read(&table[index * downlink_row.size], downlink_row.crc);
+			uint8_t tx_power = octet_uint8_read(&table[index * downlink_row.size], downlink_row.tx_power);
+			uint8_t preamble_len = octet_uint8_read(&table[index * downlink_row.size], downlink_row.preamble_len);
+			time_t sent_at = (time_t)octet_uint64_read(&table[index * downlink_row.size], downlink_row.sent_at);
 			uint8_t (*device_id)[8] =
-					(uint8_t (*)[8])octet_blob_read(&db->chunk[index * user_device_row.size], user_device_row.device_id);
+					(uint8_t (*)[8])octet_blob_read(&devices[index * user_device_row.size], user_device_row.device_id);
 			body_write(response, (uint16_t[]){hton16(frame)}, sizeof(frame));
 			body_write(response, &kind, sizeof(kind));
 			body_write(response, &data_len, sizeof(data_len));
@@ -146,12 +154,12 @@ uint16_t downlink_select(octet_t *db, bwt_t *bwt, downlink_query_t *query, respo
 			continue;
 		}
 
-		if (octet_row_read(&stmts[index], files[index], offsets[index], &db->table[index * downlink_row.size], downlink_row.size) ==
+		if (octet_row_read(&stmts[index], files[index], offsets[index], &table[index * downlink_row.size], downlink_row.size) ==
 				-1) {
 			status = octet_error();
 			goto cleanup;
 		}
-		sent_ats[index] = (time_t)octet_uint64_read(&db->table[index * downlink_row.size], downlink_row.sent_at);
+		sent_ats[index] = (time_t)octet_uint64_read(&table[index * downlink_row.size], downlink_row.sent_at);
 	}
 
 cleanup:
@@ -494,6 +502,7 @@ void downlink_find(octet_t *db, bwt_t *bwt, request_t *request, response_t *resp
 
 	header_write(response, "content-type:application/octet-stream\r\n");
 	header_write(response, "content-length:%u\r\n", response->body.len);
+	span.emitted = downlinks_len;
 	info("found %hhu downlinks\n", downlinks_len);
 	response->status = 200;
 }
@@ -571,6 +580,7 @@ void downlink_find_by_device(octet_t *db, bwt_t *bwt, request_t *request, respon
 	}
 	header_write(response, "content-type:application/octet-stream\r\n");
 	header_write(response, "content-length:%u\r\n", response->body.len);
+	span.emitted = downlinks_len;
 	info("found %hu downlinks\n", downlinks_len);
 	response->status = 200;
 }
@@ -0,0 +1,346 @@
+#include "ingest.h"
+#include "../lib/arena.h"
+#include "../lib/base16.h"
+#include "../lib/logger.h"
+#include "../lib/octet.h"
+#include "buffer.h"
+#include "config.h"
+#include "device.h"
+#include "metric.h"
+#include "radio.h"
+#include "reading.h"
+#include "uplink.h"
+#include "zone.h"
+#include <fcntl.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+int ingest_init(ingest_t *ingest, arena_t *arena, uint8_t (*device_id)[8], uint16_t cap) {
+	ingest->device_id = device_id;
+	ingest->uplinks = arena_alloc(arena, cap * sizeof(*ingest->uplinks));
+	ingest->readings = arena_alloc(arena, cap * sizeof(*ingest->readings));
+	ingest->metrics = arena_alloc(arena, cap * sizeof(*ingest->metrics));
+	ingest->buffers = arena_alloc(arena, cap * sizeof(*ingest->buffers));
+	ingest->configs = arena_alloc(arena, cap * sizeof(*ingest->configs));
+	ingest->radios = arena_alloc(arena, cap * sizeof(*ingest->radios));
+	if (ingest->uplinks == NULL || ingest->readings == NULL || ingest->metrics == NULL || ingest->buffers == NULL ||
+			ingest->configs == NULL || ingest->radios == NULL) {
+		return -1;
+	}
+
+	ingest->uplinks_len = 0;
+	ingest->readings_len = 0;
+	ingest->metrics_len = 0;
+	ingest->buffers_len = 0;
+	ingest->configs_len = 0;
+	ingest->radios_len = 0;
+	ingest->updated_at = 0;
+	ingest->updated = false;
+	ingest->appended = false;
+	ingest->device = (device_t){
+			.id = device_id,
+			.name = NULL,
+			.zone_id = NULL,
+			.firmware = (char *)&ingest->firmware,
+			.hardware = (char *)&ingest->hardware,
+			.updated_at = &ingest->updated_at,
+	};
+	return 0;
+}
+
+void ingest_sort(uint8_t *rows, uint8_t row_size, uint16_t rows_len, uint8_t time_ind, uint8_t *swap) {
+	for (uint16_t index = 1; index < rows_len; index++) {
+		uint64_t time = octet_uint64_read(&rows[index * row_size], time_ind);
+		uint16_t ind = index;
+		while (ind > 0 && octet_uint64_read(&rows[(ind - 1) * row_size], time_ind) > time) {
+			ind--;
+		}
+		if (ind != index) {
+			memcpy(swap, &rows[index * row_size], row_size);
+			memmove(&rows[(ind + 1) * row_size], &rows[ind * row_size], (size_t)(index - ind) * row_size);
+			memcpy(&rows[ind * row_size], swap, row_size);
+		}
+	}
+}
+
+uint16_t ingest_rows(octet_t *db, uint8_t (*device_id)[8], const char *series, uint8_t *rows, uint8_t row_size,
+										 uint16_t rows_len, uint8_t time_ind) {
+	uint16_t status;
+
+	ingest_sort(rows, row_size, rows_len, time_ind, db->row);
+
+	char uuid[16];
+	if (base16_encode(uuid, sizeof(uuid), device_id, sizeof(*device_id)) == -1) {
+		error("failed to encode uuid to base 16\n");
+		return 500;
+	}
+
+	char file[128];
+	if (sprintf(file, "%s/%.*s/%s.data", db->directory, (int)sizeof(uuid), uuid, series) == -1) {
+		error("failed to sprintf uuid to file\n");
+		return 500;
+	}
+
+	octet_stmt_t stmt;
+	if (octet_open(&stmt, file, O_RDWR, F_WRLCK) == -1) {
+		status = octet_error();
+		goto cleanup;
+	}
+
+	debug("insert %hu %s rows for device %02x%02x\n", rows_len, series, (*device_id)[0], (*device_id)[1]);
+
+	off_t end = stmt.stat.st_size;
+	uint64_t tail = 0;
+	if (end > 0) {
+		if (octet_row_read(&stmt, file, end - row_size, db->row, row_size) == -1) {
+			status = octet_error();
+			goto cleanup;
+		}
+		tail = octet_uint64_read(db->row, time_ind);
+	}
+
+	uint16_t index = 0;
+	while (index < rows_len && octet_uint64_read(&rows[index * row_size], time_ind) < tail) {
+		uint8_t *row = &rows[index * row_size];
+		off_t offset = end;
+		while (offset > 0) {
+			if (octet_row_read(&stmt, file, offset - row_size, db->row, row_size) == -1) {
+				status = octet_error();
+				goto cleanup;
+			}
+			if (octet_uint64_read(db->row, time_ind) <= octet_uint64_read(row, time_ind)) {
+				break;
+			}
+			if (octet_row_write(&stmt, file, offset, db->row, row_size) == -1) {
+				status = octet_error();
+				goto cleanup;
+			}
+			offset -= row_size;
+		}
+		if (octet_row_write(&stmt, file, offset, row, row_size) == -1) {
+			status = octet_error();
+			goto cleanup;
+		}
+		end += row_size;
+		index++;
+	}
+
+	if (index < rows_len &&
+			octet_bulk_write(&stmt, file, end, &rows[index * row_size], (size_t)(rows_len - index) * row_size) == -1) {
+		status = octet_error();
+		goto cleanup;
+	}
+
+	status = 0;
+
+cleanup:
+	octet_close(&stmt, file);
+	return status;
+}
+
+uint16_t ingest_uplinks(octet_t *db, ingest_t *ingest) {
+	uint8_t *rows = arena_alloc(&db->arena, uplink_row.size * ingest->uplinks_len);
+	if (rows == NULL) {
+		return 500;
+	}
+
+	memset(rows, 0, uplink_row.size * ingest->uplinks_len);
+	for (uint16_t index = 0; index < ingest->uplinks_len; index++) {
+		uint8_t *row = &rows[index * uplink_row.size];
+		uplink_t *uplink = &ingest->uplinks[index];
+		octet_uint16_write(row, uplink_row.frame, uplink->frame);
+		octet_uint8_write(row, uplink_row.kind, uplink->kind);
+		octet_uint8_write(row, uplink_row.data_len, uplink->data_len);
+		octet_blob_write(row, uplink_row.data, uplink->data, uplink->data_len);
+		octet_uint16_write(row, uplink_row.airtime, uplink->airtime);
+		octet_uint32_write(row, uplink_row.frequency, uplink->frequency);
+		octet_uint32_write(row, uplink_row.bandwidth, uplink->bandwidth);
+		octet_int16_write(row, uplink_row.rssi, uplink->rssi);
+		octet_int8_write(row, uplink_row.snr, uplink->snr);
+		octet_uint8_write(row, uplink_row.sf, uplink->sf);
+		octet_uint8_write(row, uplink_row.cr, uplink->cr);
+		octet_bool_write(row, uplink_row.crc, uplink->crc);
+		octet_uint8_write(row, uplink_row.tx_power, uplink->tx_power);
+		octet_uint8_write(row, uplink_row.preamble_len, uplink->preamble_len);
+		octet_uint64_write(row, uplink_row.received_at, (uint64_t)uplink->received_at);
+	}
+
+	return ingest_rows(db, ingest->device_id, uplink_file, rows, uplink_row.size, ingest->uplinks_len, uplink_row.received_at);
+}
+
+uint16_t ingest_readings(octet_t *db, ingest_t *ingest) {
+	uint8_t *rows = arena_alloc(&db->arena, reading_row.size * ingest->readings_len);
+	if (rows == NULL) {
+		return 500;
+	}
+
+	for (uint16_t index = 0; index < ingest->readings_len; index++) {
+		uint8_t *row = &rows[index * reading_row.size];
+		reading_t *reading = &ingest->readings[index];
+		octet_int16_write(row, reading_row.temperature, (int16_t)(reading->temperature * 100));
+		octet_uint16_write(row, reading_row.humidity, (uint16_t)(reading->humidity * 100));
+		octet_uint64_write(row, reading_row.captured_at, (uint64_t)reading->captured_at);
+	}
+
+	return ingest_rows(db, ingest->device_id, reading_file, rows, reading_row.size, ingest->readings_len,
+										 reading_row.captured_at);
+}
+
+uint16_t ingest_metrics(octet_t *db, ingest_t *ingest) {
+	uint8_t *rows = arena_alloc(&db->arena, metric_row.size * ingest->metrics_len);
+	if (rows == NULL) {
+		return 500;
+	}
+
+	for (uint16_t index = 0; index < ingest->metrics_len; index++) {
+		uint8_t *row = &rows[index * metric_row.size];
+		metric_t *metric = &ingest->metrics[index];
+		octet_uint16_write(row, metric_row.photovoltaic, (uint16_t)(metric->photovoltaic * 1000));
+		octet_uint16_write(row, metric_row.battery, (uint16_t)(metric->battery * 1000));
+		octet_uint64_write(row, metric_row.captured_at, (uint64_t)metric->captured_at);
+	}
+
+	return ingest_rows(db, ingest->device_id, metric_file, rows, metric_row.size, ingest->metrics_len, metric_row.captured_at);
+}
+
+uint16_t ingest_buffers(octet_t *db, ingest_t *ingest) {
+	uint8_t *rows = arena_alloc(&db->arena, buffer_row.size * ingest->buffers_len);
+	if (rows == NULL) {
+		return 500;
+	}
+
+	for (uint16_t index = 0; index < ingest->buffers_len; index++) {
+		uint8_t *row = &rows[index * buffer_row.size];
+		buffer_t *buffer = &ingest->buffers[index];
+		octet_uint32_write(row, buffer_row.delay, buffer->delay);
+		octet_uint16_write(row, buffer_row.level, buffer->level);
+		octet_uint64_write(row, buffer_row.captured_at, (uint64_t)buffer->captured_at);
+	}
+
+	return ingest_rows(db, ingest->device_id, buffer_file, rows, buffer_row.size, ingest->buffers_len, buffer_row.captured_at);
+}
+
+uint16_t ingest_configs(octet_t *db, ingest_t *ingest) {
+	uint8_t *rows = arena_alloc(&db->arena, config_row.size * ingest->configs_len);
+	if (rows == NULL) {
+		return 500;
+	}
+
+	for (uint16_t index = 0; index < ingest->configs_len; index++) {
+		uint8_t *row = &rows[index * config_row.size];
+		config_t *config = &ingest->configs[index];
+		octet_bool_write(row, config_row.led_debug, config->led_debug);
+		octet_bool_write(row, config_row.reading_enable, config->reading_enable);
+		octet_bool_write(row, config_row.metric_enable, config->metric_enable);
+		octet_bool_write(row, config_row.buffer_enable, config->buffer_enable);
+		octet_uint16_write(row, config_row.reading_interval, config->reading_interval);
+		octet_uint16_write(row, config_row.metric_interval, config->metric_interval);
+		octet_uint16_write(row, config_row.buffer_interval, config->buffer_interval);
+		octet_uint64_write(row, config_row.captured_at, (uint64_t)config->captured_at);
+	}
+
+	return ingest_rows(db, ingest->device_id, config_file, rows, config_row.size, ingest->configs_len, config_row.captured_at);
+}
+
+uint16_t ingest_radios(octet_t *db, ingest_t *ingest) {
+	uint8_t *rows = arena_alloc(&db->arena, radio_row.size * ingest->radios_len);
+	if (rows == NULL) {
+		return 500;
+	}
+
+	for (uint16_t index = 0; index < ingest->radios_len; index++) {
+		uint8_t *row = &rows[index * radio_row.size];
+		radio_t *radio = &ingest->radios[index];
+		octet_uint32_write(row, radio_row.frequency, radio->frequency);
+		octet_uint32_write(row, radio_row.bandwidth, radio->bandwidth);
+		octet_uint8_write(row, radio_row.coding_rate, radio->coding_rate);
+		octet_uint8_write(row, radio_row.spreading_factor, radio->spreading_factor);
+		octet_uint8_write(row, radio_row.preamble_length, radio->preamble_length);
+		octet_uint8_write(row, radio_row.tx_power, radio->tx_power);
+		octet_uint8_write(row, radio_row.sync_word, radio->sync_word);
+		octet_bool_write(row, radio_row.checksum, radio->checksum);
+		octet_uint64_write(row, radio_row.captured_at, (uint64_t)radio->captured_at);
+	}
+
+	return ingest_rows(db, ingest->device_id, radio_file, rows, radio_row.size, ingest->radios_len, radio_row.captured_at);
+}
+
+uint16_t ingest_commit(octet_t *db, ingest_t *ingest) {
+	uint16_t status;
+
+	if (ingest->uplinks_len != 0 && ingest->appended == false && (status = ingest_uplinks(db, ingest)) != 0) {
+		return status;
+	}
+	if (ingest->readings_len != 0 && (status = ingest_readings(db, ingest)) != 0) {
+		return status;
+	}
+	if (ingest->metrics_len != 0 && (status = ingest_metrics(db, ingest)) != 0) {
+		return status;
+	}
+	if (ingest->buffers_len != 0 && (status = ingest_buffers(db, ingest)) != 0) {
+		return status;
+	}
+	if (ingest->configs_len != 0 && (status = ingest_configs(db, ingest)) != 0) {
+		return status;
+	}
+	if (ingest->radios_len != 0 && (status = ingest_radios(db, ingest)) != 0) {
+		return status;
+	}
+
+	reading_t *reading = NULL;
+	for (uint16_t index = 0; index < ingest->readings_len; index++) {
+		if (reading == NULL || ingest->readings[index].captured_at >= reading->captured_at) {
+			reading = &ingest->readings[index];
+		}
+	}
+	metric_t *metric = NULL;
+	for (uint16_t index = 0; index < ingest->metrics_len; index++) {
+		if (metric == NULL || ingest->metrics[index].captured_at >= metric->captured_at) {
+			metric = &ingest->metrics[index];
+		}
+	}
+	buffer_t *buffer = NULL;
+	for (uint16_t index = 0; index < ingest->buffers_len; index++) {
+		if (buffer == NULL || ingest->buffers[index].captured_at >= buffer->captured_at) {
+			buffer = &ingest->buffers[index];
+		}
+	}
+
+	if (ingest->uplinks_len == 0 && reading == NULL && metric == NULL && buffer == NULL && ingest->updated == false) {
+		return 0;
+	}
+
+	uint8_t zone_id[8];
+	device_t device = {
+			.id = ingest->device_id,
+			.zone_id = &zone_id,
+			.reading = reading,
+			.metric = metric,
+			.buffer = buffer,
+			.uplink = ingest->uplinks,
+			.uplinks_len = ingest->uplinks_len,
+			.downlink = NULL,
+	};
+	if (ingest->updated == true) {
+		device.firmware = ingest->device.firmware;
+		device.firmware_len = ingest->device.firmware_len;
+		device.hardware = ingest->device.hardware;
+		device.hardware_len = ingest->device.hardware_len;
+		device.updated_at = ingest->device.updated_at;
+	}
+	if ((status = device_update_latest(db, &device)) != 0) {
+		return status;
+	}
+
+	if (device.zone_id != NULL && (reading != NULL || metric != NULL || buffer != NULL)) {
+		zone_t zone = {.id = device.zone_id};
+		if ((status = zone_update_latest(db, &zone)) != 0) {
+			return status;
+		}
+	}
+
+	return 0;
+}
@@ -0,0 +1,40 @@
+#pragma once
+
+#include "../lib/arena.h"
+#include "../lib/octet.h"
+#include "buffer.h"
+#include "config.h"
+#include "device.h"
+#include "metric.h"
+#include "radio.h"
+#include "reading.h"
+#include "uplink.h"
+#include <stdbool.h>
+#include <stdint.h>
+#include <time.h>
+
+typedef struct ingest_t {
+	uint8_t (*device_id)[8];
+	uplink_t *uplinks;
+	uint16_t uplinks_len;
+	reading_t *readings;
+	uint16_t readings_len;
+	metric_t *metrics;
+	uint16_t metrics_len;
+	buffer_t *buffers;
+	uint16_t buffers_len;
+	config_t *configs;
+	uint16_t configs_len;
+	radio_t *radios;
+	uint16_t radios_len;
+	char firmware[16];
+	char hardware[16];
+	time_t updated_at;
+	device_t device;
+	bool updated;
+	bool appended;
+} ingest_t;
+
+int ingest_init(ingest_t *ingest, arena_t *arena, uint8_t (*device_id)[8], uint16_t cap);
+uint16_t ingest_uplinks(octet_t *db, ingest_t *ingest);
+uint16_t ingest_commit(octet_t *db, ingest_t *ingest);
@@ -1,4 +1,5 @@
 #include "metric.h"
+#include "../lib/arena.h"
 #include "../lib/base16.h"
 #include "../lib/bwt.h"
 #include "../lib/endian.h"
@@ -6,6 +7,7 @@
 #include "../lib/octet.h"
 #include "../lib/request.h"
 #include "../lib/response.h"
+#include "../lib/span.h"
 #include "../lib/strn.h"
 #include "cache.h"
 #include "device.h"
@@ -32,9 +34,15 @@ const metric_row_t metric_row = {
 uint16_t metric_select(octet_t *db, bwt_t *bwt, metric_query_t *query, response_t *response, uint16_t *metrics_len) {
 	uint16_t status;
 
+	uint8_t *table = arena_alloc(&db->arena, metric_row.size * 64);
+	if (table == NULL) {
+		return 500;
+	}
+
 	uint8_t user_devices_len = 0;
 	user_t user = {.id = &bwt->id};
-	status = user_device_select_by_user(db, &user, &user_devices_len);
+	uint8_t *user_devices;
+	status = user_device_select_by_user(db, &user, &user_devices, &user_devices_len);
 	if (status != 0) {
 		return status;
 	}
@@ -47,7 +55,7 @@ uint16_t metric_select(octet_t *db, bwt_t *bwt, metric_query_t *query, response_
 	octet_stmt_t stmt;
 	for (uint8_t index = 0; index < user_devices_len; index++) {
 		uint8_t (*device_id)[8] =
-				(uint8_t (*)[8])octet_blob_read(&db->chunk[index * user_device_row.size], user_device_row.device_id);
+				(uint8_t (*)[8])octet_blob_read(&user_devices[index * user_device_row.size], user_device_row.device_id);
 
 		if (base16_encode(uuid, sizeof(uuid), device_id, sizeof(*device_id)) == -1) {
 			error("failed to encode uuid to base 16\n");
@@ -101,23 +109,23 @@ uint16_t metric_select(octet_t *db, bwt_t *bwt, metric_query_t *query, response_
 				break;
 			}
 			if (batch_index == 0) {
-				if (offset >= metric_row.size * 63 && db->table_len >= metric_row.size * 64) {
+				if (offset >= metric_row.size * 63) {
 					batch_index = 63;
-					if (octet_row_read_all(&stmt, file, offset - metric_row.size * 63, db->table, metric_row.size, 64) == -1) {
+					if (octet_row_read_all(&stmt, file, offset - metric_row.size * 63, table, metric_row.size, 64) == -1) {
 						status = octet_error();
 						goto cleanup;
 					}
 				} else {
 					batch_index = 0;
-					if (octet_row_read(&stmt, file, offset, db->table, metric_row.size) == -1) {
+					if (octet_row_read(&stmt, file, offset, table, metric_row.size) == -1) {
 						status = octet_error();
 						goto cleanup;
 					}
 				}
 			}
-			uint16_t photovoltaic = octet_uint16_read(&db->table[batch_index * metric_row.size], metric_row.photovoltaic);
-			uint16_t battery = octet_uint16_read(&db->table[batch_index * metric_row.size], metric_row.battery);
-			time_t captured_at = (time_t)octet_uint64_read(&db->table[batch_index * metric_row.size], metric_row.captured_at);
+			uint16_t photovoltaic = octet_uint16_read(&table[batch_index * metric_row.size], metric_row.photovoltaic);
+			uint16_t battery = octet_uint16_read(&table[batch_index * metric_row.size], metric_row.battery);
+			time_t captured_at = (time_t)octet_uint64_read(&table[batch_index * metric_row.size], metric_row.captured_at);
 			if (response->body.len + sizeof(photovoltaic) + sizeof(battery) + sizeof(captured_at) > response->body.cap) {
 				error("metrics amount %hu exceeds buffer length %u\n", *metrics_len, response->body.cap);
 				status = 500;
@@ -174,6 +182,11 @@ uint16_t metric_select_by_device(octet_t *db, device_t *device, metric_query_t *
 																 uint16_t *metrics_len) {
 	uint16_t status;
 
+	uint8_t *table = arena_alloc(&db->arena, metric_row.size * 64);
+	if (table == NULL) {
+		return 500;
+	}
+
 	char uuid[16];
 	if (base16_encode(uuid, sizeof(uuid), device->id, sizeof(*device->id)) == -1) {
 		error("failed to encode uuid to base 16\n");
@@ -208,23 +221,23 @@ uint16_t metric_select_by_device(octet_t *db, device_t *device, metric_query_t *
 			break;
 		}
 		if (batch_index == 0) {
-			if (offset >= metric_row.size * 63 && db->table_len >= metric_row.size * 64) {
+			if (offset >= metric_row.size * 63) {
 				batch_index = 63;
-				if (octet_row_read_all(&stmt, file, offset - metric_row.size * 63, db->table, metric_row.size, 64) == -1) {
+				if (octet_row_read_all(&stmt, file, offset - metric_row.size * 63, table, metric_row.size, 64) == -1) {
 					status = octet_error();
 					goto cleanup;
 				}
 			} else {
 				batch_index = 0;
-				if (octet_row_read(&stmt, file, offset, db->table, metric_row.size) == -1) {
+				if (octet_row_read(&stmt, file, offset, table, metric_row.size) == -1) {
 					status = octet_error();
 					goto cleanup;
 				}
 			}
 		}
-		uint16_t photovoltaic = octet_uint16_read(&db->table[batch_index * metric_row.size], metric_row.photovoltaic);
-		uint16_t battery = octet_uint16_read(&db->table[batch_index * metric_row.size], metric_row.battery);
-		time_t captured_at = (time_t)octet_uint64_read(&db->table[batch_index * metric_row.size], metric_row.captured_at);
+		uint16_t photovoltaic = octet_uint16_read(&table[batch_index * metric_row.size], metric_row.photovoltaic);
+		uint16_t battery = octet_uint16_read(&table[batch_index * metric_row.size], metric_row.battery);
+		time_t captured_at = (time_t)octet_uint64_read(&table[batch_index * metric_row.size], metric_row.captured_at);
 		if (response->body.len + sizeof(photovoltaic) + sizeof(battery) + sizeof(captured_at) > response->body.cap) {
 			error("metrics amount %hu exceeds buffer length %u\n", *metrics_len, response->body.cap);
 			status = 500;
@@ -272,8 +285,14 @@ cleanup:
 uint16_t metric_select_by_zone(octet_t *db, zone_t *zone, metric_query_t *query, response_t *response, uint16_t *metrics_len) {
 	uint16_t status;
 
-	uint8_t devices_len;
-	status = device_select_by_zone(db, zone, &devices_len);
+	uint8_t *table = arena_alloc(&db->arena, metric_row.size * 64);
+	if (table == NULL) {
+		return 500;
+	}
+
+	uint8_t devices_len = 0;
+	uint8_t *devices;
+	status = device_select_by_zone(db, zone, &devices, &devices_len);
 	if (status != 0) {
 		return status;
 	}
@@ -285,7 +304,7 @@ uint16_t metric_select_by_zone(octet_t *db, zone_t *zone, metric_query_t *query,
 	char file[128];
 	octet_stmt_t stmt;
 	for (uint8_t index = 0; index < devices_len; index++) {
-		uint8_t (*device_id)[8] = (uint8_t (*)[8])octet_blob_read(&db->chunk[index * device_row.size], device_row.id);
+		uint8_t (*device_id)[8] = (uint8_t (*)[8])octet_blob_read(&devices[index * device_row.size], device_row.id);
 
 		if (base16_encode(uuid, sizeof(uuid), device_id, sizeof(*device_id)) == -1) {
 			error("failed to encode uuid to base 16\n");
@@ -325,23 +344,23 @@ uint16_t metric_select_by_zone(octet_t *db, zone_t *zone, metric_query_t *query,
 				break;
 			}
 			if (batch_index == 0) {
-				if (offset >= metric_row.size * 63 && db->table_len >= metric_row.size * 64) {
+				if (offset >= metric_row.size * 63) {
 					batch_index = 63;
-					if (octet_row_read_all(&stmt, file, offset - metric_row.size * 63, db->table, metric_row.size, 64) == -1) {
+					if (octet_row_read_all(&stmt, file, offset - metric_row.size * 63, table, metric_row.size, 64) == -1) {
 						status = octet_error();
 						goto cleanup;
 					}
 				} else {
 					batch_index = 0;
-					if (octet_row_read(&stmt, file, offset, db->table, metric_row.size) == -1) {
+					if (octet_row_read(&stmt, file, offset, table, metric_row.size) == -1) {
 						status = octet_error();
 						goto cleanup;
 					}
 				}
 			}
-			uint16_t photovoltaic = octet_uint16_read(&db->table[batch_index * metric_row.size], metric_row.photovoltaic);
-			uint16_t battery = octet_uint16_read(&db->table[batch_index * metric_row.size], metric_row.battery);
-			time_t captured_at = (time_t)octet_uint64_read(&db->table[batch_index * metric_row.size], metric_row.captured_at);
+			uint16_t photovoltaic = octet_uint16_read(&table[batch_index * metric_row.size], metric_row.photovoltaic);
+			uint16_t battery = octet_uint16_read(&table[batch_index * metric_row.size], metric_row.battery);
+			time_t captured_at = (time_t)octet_uint64_read(&table[batch_index * metric_row.size], metric_row.captured_at);
 			if (response->body.len + sizeof(photovoltaic) + sizeof(battery) + sizeof(captured_at) > response->body.cap) {
 				error("metrics amount %hu exceeds buffer length %u\n", *metrics_len, response->body.cap);
 				status = 500;
@@ -394,86 +413,6 @@ uint16_t metric_select_by_zone(octet_t *db, zone_t *zone, metric_query_t *query,
 	return status;
 }
 
-uint16_t metric_insert(octet_t *db, metric_t *metric) {
-	uint16_t status;
-
-	char uuid[16];
-	if (base16_encode(uuid, sizeof(uuid), metric->device_id, sizeof(*metric->device_id)) == -1) {
-		error("failed to encode uuid to base 16\n");
-		return 500;
-	}
-
-	char file[128];
-	if (sprintf(file, "%s/%.*s/%s.data", db->directory, (int)sizeof(uuid), uuid, metric_file) == -1) {
-		error("failed to sprintf uuid to file\n");
-		return 500;
-	}
-
-	octet_stmt_t stmt;
-	if (octet_open(&stmt, file, O_RDWR, F_WRLCK) == -1) {
-		status = octet_error();
-		goto cleanup;
-	}
-
-	debug("insert metric for device %02x%02x captured at %lu\n", (*metric->device_id)[0], (*metric->device_id)[1],
-				metric->captured_at);
-
-	off_t offset = stmt.stat.st_size;
-	while (offset > 0) {
-		if (octet_row_read(&stmt, file, offset - metric_row.size, db->row, metric_row.size) == -1) {
-			status = octet_error();
-			goto cleanup;
-		}
-		time_t captured_at = (time_t)octet_uint64_read(db->row, metric_row.captured_at);
-		if (captured_at <= metric->captured_at) {
-			break;
-		}
-		if (octet_row_write(&stmt, file, offset, db->row, metric_row.size) == -1) {
-			status = octet_error();
-			goto cleanup;
-		}
-		offset -= metric_row.size;
-	}
-
-	octet_uint16_write(db->row, metric_row.photovoltaic, (uint16_t)(metric->photovoltaic * 1000));
-	octet_uint16_write(db->row, metric_row.battery, (uint16_t)(metric->battery * 1000));
-	octet_uint64_write(db->row, metric_row.captured_at, (uint64_t)metric->captured_at);
-
-	if (octet_row_write(&stmt, file, offset, db->row, metric_row.size) == -1) {
-		status = octet_error();
-		goto cleanup;
-	}
-
-	uint8_t zone_id[8];
-	device_t device = {
-			.id = metric->device_id,
-			.zone_id = &zone_id,
-			.reading = NULL,
-			.metric = metric,
-			.buffer = NULL,
-			.uplink = NULL,
-			.downlink = NULL,
-	};
-	status = device_update_latest(db, &device);
-	if (status != 0) {
-		goto cleanup;
-	}
-
-	if (device.zone_id != NULL) {
-		zone_t zone = {.id = device.zone_id};
-		status = zone_update_latest(db, &zone);
-		if (status != 0) {
-			goto cleanup;
-		}
-	}
-
-	status = 0;
-
-cleanup:
-	octet_close(&stmt, file);
-	return status;
-}
-
 void metric_find(octet_t *db, bwt_t *bwt, request_t *request, response_t *response) {
 	const char *from;
 	size_t from_len;
@@ -521,6 +460,7 @@ void metric_find(octet_t *db, bwt_t *bwt, request_t *request, response_t *respon
 
 	header_write(response, "content-type:application/octet-stream\r\n");
 	header_write(response, "content-length:%u\r\n", response->body.len);
+	span.emitted = metrics_len;
 	info("found %hu metrics\n", metrics_len);
 	response->status = 200;
 }
@@ -608,6 +548,7 @@ void metric_find_by_device(octet_t *db, bwt_t *bwt, request_t *request, response
 	}
 	header_write(response, "content-type:application/octet-stream\r\n");
 	header_write(response, "content-length:%u\r\n", response->body.len);
+	span.emitted = metrics_len;
 	info("found %hu metrics\n", metrics_len);
 	response->status = 200;
 }
@@ -692,6 +633,7 @@ void metric_find_by_zone(octet_t *db, bwt_t *bwt, request_t *request, response_t
 	}
 	header_write(response, "content-type:application/octet-stream\r\n");
 	header_write(response, "content-length:%u\r\n", response->body.len);
+	span.emitted = metrics_len;
 	info("found %hu metrics\n", metrics_len);
 	response->status = 200;
 }
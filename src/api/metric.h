@@ -38,7 +38,6 @@ uint16_t metric_select(octet_t *db, bwt_t *bwt, metric_query_t *query, response_
 uint16_t metric_select_by_device(octet_t *db, device_t *device, metric_query_t *query, response_t *response,
 																 uint16_t *metrics_len);
 uint16_t metric_select_by_zone(octet_t *db, zone_t *zone, metric_query_t *query, response_t *response, uint16_t *metrics_len);
-uint16_t metric_insert(octet_t *db, metric_t *metric);
 
 void metric_find(octet_t *db, bwt_t *bwt, request_t *request, response_t *response);
 void metric_find_by_device(octet_t *db, bwt_t *bwt, request_t *request, response_t *response);
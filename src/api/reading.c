@@ -1,4 +1,5 @@
 #include "reading.h"
+#include "../lib/arena.h"
 #include "../lib/base16.h"
 #include "../lib/bwt.h"
 #include "../lib/endian.h"
@@ -6,6 +7,7 @@
 #include "../lib/octet.h"
 #include "../lib/request.h"
 #include "../lib/response.h"
+#include "../lib/span.h"
 #include "../lib/strn.h"
 #include "cache.h"
 #include "device.h"
@@ -32,9 +34,15 @@ const reading_row_t reading_row = {
 uint16_t reading_select(octet_t *db, bwt_t *bwt, reading_query_t *query, response_t *response, uint16_t *readings_len) {
 	uint16_t status;
 
+	uint8_t *table = arena_alloc(&db->arena, reading_row.size * 64);
+	if (table == NULL) {
+		return 500;
+	}
+
 	uint8_t user_devices_len = 0;
 	user_t user = {.id = &bwt->id};
-	status = user_device_select_by_user(db, &user, &user_devices_len);
+	uint8_t *user_devices;
+	status = user_device_select_by_user(db, &user, &user_devices, &user_devices_len);
 	if (status != 0) {
 		return status;
 	}
@@ -47,7 +55,7 @@ uint16_t reading_select(octet_t *db, bwt_t *bwt, reading_query_t *query, respons
 	octet_stmt_t stmt;
 	for (uint8_t index = 0; index < user_devices_len; index++) {
 		uint8_t (*device_id)[8] =
-				(uint8_t (*)[8])octet_blob_read(&db->chunk[index * user_device_row.size], user_device_row.device_id);
+				(uint8_t (*)[8])octet_blob_read(&user_devices[index * user_device_row.size], user_device_row.device_id);
 
 		if (base16_encode(uuid, sizeof(uuid), device_id, sizeof(*device_id)) == -1) {
 			error("failed to encode uuid to base 16\n");
@@ -101,23 +109,23 @@ uint16_t reading_select(octet_t *db, bwt_t *bwt, reading_query_t *query, respons
 				break;
 			}
 			if (batch_index == 0) {
-				if (offset >= reading_row.size * 63 && db->table_len >= reading_row.size * 64) {
+				if (offset >= reading_row.size * 63) {
 					batch_index = 63;
-					if (octet_row_read_all(&stmt, file, offset - reading_row.size * 63, db->table, reading_row.size, 64) == -1) {
+					if (octet_row_read_all(&stmt, file, offset - reading_row.size * 63, table, reading_row.size, 64) == -1) {
 						status = octet_error();
 						goto cleanup;
 					}
 				} else {
 					batch_index = 0;
-					if (octet_row_read(&stmt, file, offset, db->table, reading_row.size) == -1) {
+					if (octet_row_read(&stmt, file, offset, table, reading_row.size) == -1) {
 						status = octet_error();
 						goto cleanup;
 					}
 				}
 			}
-			int16_t temperature = octet_int16_read(&db->table[batch_index * reading_row.size], reading_row.temperature);
-			uint16_t humidity = octet_uint16_read(&db->table[batch_index * reading_row.size], reading_row.humidity);
-			time_t captured_at = (time_t)octet_uint64_read(&db->table[batch_index * reading_row.size], reading_row.captured_at);
+			int16_t temperature = octet_int16_read(&table[batch_index * reading_row.size], reading_row.temperature);
+			uint16_t humidity = octet_uint16_read(&table[batch_index * reading_row.size], reading_row.humidity);
+			time_t captured_at = (time_t)octet_uint64_read(&table[batch_index * reading_row.size], reading_row.captured_at);
 			if (response->body.len + sizeof(temperature) + sizeof(humidity) + sizeof(captured_at) > response->body.cap) {
 				error("readings amount %hu exceeds buffer length %u\n", *readings_len, response->body.cap);
 				status = 500;
@@ -174,6 +182,11 @@ uint16_t reading_select_by_device(octet_t *db, device_t *device, reading_query_t
 																	uint16_t *readings_len) {
 	uint16_t status;
 
+	uint8_t *table = arena_alloc(&db->arena, reading_row.size * 64);
+	if (table == NULL) {
+		return 500;
+	}
+
 	char uuid[16];
 	if (base16_encode(uuid, sizeof(uuid), device->id, sizeof(*device->id)) == -1) {
 		error("failed to encode uuid to base 16\n");
@@ -208,23 +221,23 @@ uint16_t reading_select_by_device(octet_t *db, device_t *device, reading_query_t
 			break;
 		}
 		if (batch_index == 0) {
-			if (offset >= reading_row.size * 63 && db->table_len >= reading_row.size * 64) {
+			if (offset >= reading_row.size * 63) {
 				batch_index = 63;
-				if (octet_row_read_all(&stmt, file, offset - reading_row.size * 63, db->table, reading_row.size, 64) == -1) {
+				if (octet_row_read_all(&stmt, file, offset - reading_row.size * 63, table, reading_row.size, 64) == -1) {
 					status = octet_error();
 					goto cleanup;
 				}
 			} else {
 				batch_index = 0;
-				if (octet_row_read(&stmt, file, offset, db->table, reading_row.size) == -1) {
+				if (octet_row_read(&stmt, file, offset, table, reading_row.size) == -1) {
 					status = octet_error();
 					goto cleanup;
 				}
 			}
 		}
-		int16_t temperature = octet_int16_read(&db->table[batch_index * reading_row.size], reading_row.temperature);
-		uint16_t humidity = octet_uint16_read(&db->table[batch_index * reading_row.size], reading_row.humidity);
-		time_t captured_at = (time_t)octet_uint64_read(&db->table[batch_index * reading_row.size], reading_row.captured_at);
+		int16_t temperature = octet_int16_read(&table[batch_index * reading_row.size], reading_row.temperature);
+		uint16_t humidity = octet_uint16_read(&table[batch_index * reading_row.size], reading_row.humidity);
+		time_t captured_at = (time_t)octet_uint64_read(&table[batch_index * reading_row.size], reading_row.captured_at);
 		if (response->body.len + sizeof(temperature) + sizeof(humidity) + sizeof(captured_at) > response->body.cap) {
 			error("readings amount %hu exceeds buffer length %u\n", *readings_len, response->body.cap);
 			status = 500;
@@ -273,8 +286,14 @@ uint16_t reading_select_by_zone(octet_t *db, zone_t *zone, reading_query_t *quer
 																uint16_t *readings_len) {
 	uint16_t status;
 
-	uint8_t devices_len;
-	status = device_select_by_zone(db, zone, &devices_len);
+	uint8_t *table = arena_alloc(&db->arena, reading_row.size * 64);
+	if (table == NULL) {
+		return 500;
+	}
+
+	uint8_t devices_len = 0;
+	uint8_t *devices;
+	status = device_select_by_zone(db, zone, &devices, &devices_len);
 	if (status != 0) {
 		return status;
 	}
@@ -286,7 +305,7 @@ uint16_t reading_select_by_zone(octet_t *db, zone_t *zone, reading_query_t *quer
 	char file[128];
 	octet_stmt_t stmt;
 	for (uint8_t index = 0; index < devices_len; index++) {
-		uint8_t (*device_id)[8] = (uint8_t (*)[8])octet_blob_read(&db->chunk[index * device_row.size], device_row.id);
+		uint8_t (*device_id)[8] = (uint8_t (*)[8])octet_blob_read(&devices[index * device_row.size], device_row.id);
 
 		if (base16_encode(uuid, sizeof(uuid), device_id, sizeof(*device_id)) == -1) {
 			error("failed to encode uuid to base 16\n");
@@ -326,23 +345,23 @@ uint16_t reading_select_by_zone(octet_t *db, zone_t *zone, reading_query_t *quer
 				break;
 			}
 			if (batch_index == 0) {
-				if (offset >= reading_row.size * 63 && db->table_len >= reading_row.size * 64) {
+				if (offset >= reading_row.size * 63) {
 					batch_index = 63;
-					if (octet_row_read_all(&stmt, file, offset - reading_row.size * 63, db->table, reading_row.size, 64) == -1) {
+					if (octet_row_read_all(&stmt, file, offset - reading_row.size * 63, table, reading_row.size, 64) == -1) {
 						status = octet_error();
 						goto cleanup;
 					}
 				} else {
 					batch_index = 0;
-					if (octet_row_read(&stmt, file, offset, db->table, reading_row.size) == -1) {
+					if (octet_row_read(&stmt, file, offset, table, reading_row.size) == -1) {
 						status = octet_error();
 						goto cleanup;
 					}
 				}
 			}
-			int16_t temperature = octet_int16_read(&db->table[batch_index * reading_row.size], reading_row.temperature);
-			uint16_t humidity = octet_uint16_read(&db->table[batch_index * reading_row.size], reading_row.humidity);
-			time_t captured_at = (time_t)octet_uint64_read(&db->table[batch_index * reading_row.size], reading_row.captured_at);
+			int16_t temperature = octet_int16_read(&table[batch_index * reading_row.size], reading_row.temperature);
+			uint16_t humidity = octet_uint16_read(&table[batch_index * reading_row.size], reading_row.humidity);
+			time_t captured_at = (time_t)octet_uint64_read(&table[batch_index * reading_row.size], reading_row.captured_at);
 			if (response->body.len + sizeof(temperature) + sizeof(humidity) + sizeof(captured_at) > response->body.cap) {
 				error("readings amount %hu exceeds buffer length %u\n", *readings_len, response->body.cap);
 				status = 500;
@@ -395,86 +414,6 @@ uint16_t reading_select_by_zone(octet_t *db, zone_t *zone, reading_query_t *quer
 	return status;
 }
 
-uint16_t reading_insert(octet_t *db, reading_t *reading) {
-	uint16_t status;
-
-	char uuid[16];
-	if (base16_encode(uuid, sizeof(uuid), reading->device_id, sizeof(*reading->device_id)) == -1) {
-		error("failed to encode uuid to base 16\n");
-		return 500;
-	}
-
-	char file[128];
-	if (sprintf(file, "%s/%.*s/%s.data", db->directory, (int)sizeof(uuid), uuid, reading_file) == -1) {
-		error("failed to sprintf uuid to file\n");
-		return 500;
-	}
-
-	octet_stmt_t stmt;
-	if (octet_open(&stmt, file, O_RDWR, F_WRLCK) == -1) {
-		status = octet_error();
-		goto cleanup;
-	}
-
-	debug("insert reading for device %02x%02x captured at %lu\n", (*reading->device_id)[0], (*reading->device_id)[1],
-				reading->captured_at);
-
-	off_t offset = stmt.stat.st_size;
-	while (offset > 0) {
-		if (octet_row_read(&stmt, file, offset - reading_row.size, db->row, reading_row.size) == -1) {
-			status = octet_error();
-			goto cleanup;
-		}
-		time_t captured_at = (time_t)octet_uint64_read(db->row, reading_row.captured_at);
-		if (captured_at <= reading->captured_at) {
-			break;
-		}
-		if (octet_row_write(&stmt, file, offset, db->row, reading_row.size) == -1) {
-			status = octet_error();
-			goto cleanup;
-		}
-		offset -= reading_row.size;
-	}
-
-	octet_int16_write(db->row, reading_row.temperature, (int16_t)(reading->temperature * 100));
-	octet_uint16_write(db->row, reading_row.humidity, (uint16_t)(reading->humidity * 100));
-	octet_uint64_write(db->row, reading_row.captured_at, (uint64_t)reading->captured_at);
-
-	if (octet_row_write(&stmt, file, offset, db->row, reading_row.size) == -1) {
-		status = octet_error();
-		goto cleanup;
-	}
-
-	uint8_t zone_id[8];
-	device_t device = {
-			.id = reading->device_id,
-			.zone_id = &zone_id,
-			.reading = reading,
-			.metric = NULL,
-			.buffer = NULL,
-			.uplink = NULL,
-			.downlink = NULL,
-	};
-	status = device_update_latest(db, &device);
-	if (status != 0) {
-		goto cleanup;
-	}
-
-	if (device.zone_id != NULL) {
-		zone_t zone = {.id = device.zone_id};
-		status = zone_update_latest(db, &zone);
-		if (status != 0) {
-			goto cleanup;
-		}
-	}
-
-	status = 0;
-
-cleanup:
-	octet_close(&stmt, file);
-	return status;
-}
-
 void reading_find(octet_t *db, bwt_t *bwt, request_t *request, response_t *response) {
 	const char *from;
 	size_t from_len;
@@ -522,6 +461,7 @@ void reading_find(octet_t *db, bwt_t *bwt, request_t *request, response_t *respo
 
 	header_write(response, "content-type:application/octet-stream\r\n");
 	header_write(response, "content-length:%u\r\n", response->body.len);
+	span.emitted = readings_len;
 	info("found %hu readings\n", readings_len);
 	response->status = 200;
 }
@@ -609,6 +549,7 @@ void reading_find_by_device(octet_t *db, bwt_t *bwt, request_t *request, respons
 	}
 	header_write(response, "content-type:application/octet-stream\r\n");
 	header_write(response, "content-length:%u\r\n", response->body.len);
+	span.emitted = readings_len;
 	info("found %hu readings\n", readings_len);
 	response->status = 200;
 }
@@ -693,6 +634,7 @@ void reading_find_by_zone(octet_t *db, bwt_t *bwt, request_t *request, response_
 	}
 	header_write(response, "content-type:application/octet-stream\r\n");
 	header_write(response, "content-length:%u\r\n", response->body.len);
+	span.emitted = readings_len;
 	info("found %hu readings\n", readings_len);
 	response->status = 200;
 }
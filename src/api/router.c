@@ -1,10 +1,13 @@
+#include "router.h"
 #include "../app/page.h"
 #include "../app/serve.h"
 #include "../lib/bwt.h"
 #include "../lib/endian.h"
+#include "../lib/logger.h"
 #include "../lib/octet.h"
 #include "../lib/request.h"
 #include "../lib/response.h"
+#include "../lib/span.h"
 #include "alert.h"
 #include "buffer.h"
 #include "config.h"
@@ -14,6 +17,7 @@
 #include "radio.h"
 #include "reading.h"
 #include "rule.h"
+#include "stats.h"
 #include "uplink.h"
 #include "user-device.h"
 #include "user-zone.h"
@@ -64,68 +68,27 @@ const uint64_t permission_downlink_create = 1lu << 2lu;
 const uint64_t permission_downlink_update = 1lu << 1lu;
 const uint64_t permission_downlink_delete = 1lu << 0lu;
 
-bool pathcmp(const char *pattern, uint8_t pattern_len, const char *pathname, uint8_t pathname_len) {
-	uint8_t pattern_ind = 0;
-	uint8_t pathname_ind = 0;
-
-	while (pattern_ind < pattern_len && pathname_ind < pathname_len) {
-		if (pattern[pattern_ind] == ':') {
-			while (pattern_ind < pattern_len && pattern[pattern_ind] != '/') {
-				pattern_ind++;
-			}
-			while (pathname_ind < pathname_len && pathname[pathname_ind] != '/') {
-				pathname_ind++;
-			}
-		} else if (pattern[pattern_ind] == pathname[pathname_ind]) {
-			pattern_ind++;
-			pathname_ind++;
-		} else {
-			return false;
-		}
-	}
-
-	return pattern_ind == pattern_len && pathname_ind == pathname_len;
-}
-
-bool endpoint(request_t *request, const char *method, const char *pathname, bool *method_found, bool *pathname_found) {
-	if (*method_found == true && *pathname_found == true) {
-		return false;
-	}
-
-	if (pathcmp(pathname, (uint8_t)strlen(pathname), request->pathname.ptr, (uint8_t)request->pathname.len) == true) {
-		*pathname_found = true;
-
-		if (strcmp(method, "get") == 0 && request->method.len == 4 &&
-				memcmp(request->method.ptr, "head", request->method.len) == 0) {
-			*method_found = true;
-
-			return true;
-		}
-
-		if (request->method.len == strlen(method) && memcmp(request->method.ptr, method, request->method.len) == 0) {
-			*method_found = true;
-
-			return true;
-		}
-	}
-
-	return false;
-}
+const char redirect_signin[] = "HTTP/1.1 307 Temporary Redirect\r\nlocation:/signin\r\nset-cookie:memo=";
+const size_t redirect_signin_split = sizeof("HTTP/1.1 307 Temporary Redirect\r\nlocation:/signin\r\n") - 1;
 
 bool authenticate(bool redirect, bwt_t *bwt, request_t *request, response_t *response) {
-	const char *cookie = header_find(request, "cookie");
+	uint16_t cookie_len = 0;
+	const char *cookie = header_find(request, "cookie", &cookie_len);
 	if (cookie == NULL) {
 		if (redirect == true) {
 			response->status = 307;
-			header_write(response, "location:/signin\r\n");
-			header_write(response, "set-cookie:memo=%.*s\r\n", (int)request->pathname.len, request->pathname.ptr);
+			response->preset = redirect_signin;
+			response->preset_len = sizeof(redirect_signin) - 1;
+			response->preset_split = redirect_signin_split;
+			body_write(response, request->pathname.ptr, request->pathname.len);
+			body_write(response, "\r\n\r\n", 4);
 		} else {
 			response->status = 401;
 		}
 		return false;
 	}
 
-	if (bwt_verify(cookie, request->header.len - (size_t)(cookie - (const char *)request->header.ptr), bwt) == -1) {
+	if (bwt_verify(cookie, cookie_len, bwt) == -1) {
 		response->status = 401;
 		return false;
 	}
@@ -146,622 +109,322 @@ bool authorize(bwt_t *bwt, uint64_t permission, response_t *response) {
 	return true;
 }
 
-void route(octet_t *db, request_t *request, response_t *response) {
-	bool method_found = false;
-	bool pathname_found = false;
-
-	if (response->status != 0) {
-		goto respond;
-	}
-
-	if (endpoint(request, "get", "/", &method_found, &pathname_found) == true) {
-		bwt_t bwt;
-		if (authenticate(true, &bwt, request, response) == true) {
-			serve(&page_home, response);
-		}
-	}
-
-	if (endpoint(request, "get", "/robots.txt", &method_found, &pathname_found) == true) {
-		serve(&page_robots, response);
-	}
-
-	if (endpoint(request, "get", "/security.txt", &method_found, &pathname_found) == true) {
-		serve(&page_security, response);
-	}
-
-	if (endpoint(request, "get", "/devices", &method_found, &pathname_found) == true) {
-		bwt_t bwt;
-		if (authenticate(true, &bwt, request, response) == true) {
-			serve(&page_devices, response);
-		}
-	}
-
-	if (endpoint(request, "get", "/device/:id", &method_found, &pathname_found) == true) {
-		bwt_t bwt;
-		if (authenticate(true, &bwt, request, response) == true) {
-			serve_device(db, &bwt, request, response);
-		}
-	}
-
-	if (endpoint(request, "get", "/device/:id/readings", &method_found, &pathname_found) == true) {
-		bwt_t bwt;
-		if (authenticate(true, &bwt, request, response) == true) {
-			serve_device_readings(db, &bwt, request, response);
-		}
-	}
-
-	if (endpoint(request, "get", "/device/:id/metrics", &method_found, &pathname_found) == true) {
-		bwt_t bwt;
-		if (authenticate(true, &bwt, request, response) == true) {
-			serve_device_metrics(db, &bwt, request, response);
-		}
-	}
-
-	if (endpoint(request, "get", "/device/:id/buffers", &method_found, &pathname_found) == true) {
-		bwt_t bwt;
-		if (authenticate(true, &bwt, request, response) == true) {
-			serve_device_buffers(db, &bwt, request, response);
-		}
-	}
-
-	if (endpoint(request, "get", "/device/:id/config", &method_found, &pathname_found) == true) {
-		bwt_t bwt;
-		if (authenticate(true, &bwt, request, response) == true) {
-			serve_device_config(db, &bwt, request, response);
-		}
-	}
-
-	if (endpoint(request, "get", "/device/:id/radio", &method_found, &pathname_found) == true) {
-		bwt_t bwt;
-		if (authenticate(true, &bwt, request, response) == true) {
-			serve_device_radio(db, &bwt, request, response);
-		}
-	}
-
-	if (endpoint(request, "get", "/device/:id/rules", &method_found, &pathname_found) == true) {
-		bwt_t bwt;
-		if (authenticate(true, &bwt, request, response) == true) {
-			serve_device_rules(db, &bwt, request, response);
-		}
-	}
-
-	if (endpoint(request, "get", "/device/:id/alerts", &method_found, &pathname_found) == true) {
-		bwt_t bwt;
-		if (authenticate(true, &bwt, request, response) == true) {
-			serve_device_alerts(db, &bwt, request, response);
-		}
-	}
-
-	if (endpoint(request, "get", "/device/:id/signals", &method_found, &pathname_found) == true) {
-		bwt_t bwt;
-		if (authenticate(true, &bwt, request, response) == true) {
-			serve_device_signals(db, &bwt, request, response);
-		}
-	}
-
-	if (endpoint(request, "get", "/device/:id/uplinks", &method_found, &pathname_found) == true) {
-		bwt_t bwt;
-		if (authenticate(true, &bwt, request, response) == true) {
-			serve_device_uplinks(db, &bwt, request, response);
-		}
-	}
-
-	if (endpoint(request, "get", "/device/:id/downlinks", &method_found, &pathname_found) == true) {
-		bwt_t bwt;
-		if (authenticate(true, &bwt, request, response) == true) {
-			serve_device_downlinks(db, &bwt, request, response);
-		}
-	}
-
-	if (endpoint(request, "get", "/zones", &method_found, &pathname_found) == true) {
-		bwt_t bwt;
-		if (authenticate(true, &bwt, request, response) == true) {
-			serve(&page_zones, response);
-		}
-	}
-
-	if (endpoint(request, "get", "/zone/:id", &method_found, &pathname_found) == true) {
-		bwt_t bwt;
-		if (authenticate(true, &bwt, request, response) == true) {
-			serve_zone(db, &bwt, request, response);
-		}
-	}
-
-	if (endpoint(request, "get", "/zone/:id/readings", &method_found, &pathname_found) == true) {
-		bwt_t bwt;
-		if (authenticate(true, &bwt, request, response) == true) {
-			serve_zone_readings(db, &bwt, request, response);
-		}
-	}
-
-	if (endpoint(request, "get", "/zone/:id/metrics", &method_found, &pathname_found) == true) {
-		bwt_t bwt;
-		if (authenticate(true, &bwt, request, response) == true) {
-			serve_zone_metrics(db, &bwt, request, response);
-		}
-	}
-
-	if (endpoint(request, "get", "/zone/:id/buffers", &method_found, &pathname_found) == true) {
-		bwt_t bwt;
-		if (authenticate(true, &bwt, request, response) == true) {
-			serve_zone_buffers(db, &bwt, request, response);
-		}
-	}
-
-	if (endpoint(request, "get", "/zone/:id/signals", &method_found, &pathname_found) == true) {
-		bwt_t bwt;
-		if (authenticate(true, &bwt, request, response) == true) {
-			serve_zone_signals(db, &bwt, request, response);
-		}
-	}
-
-	if (endpoint(request, "get", "/alerts", &method_found, &pathname_found) == true) {
-		bwt_t bwt;
-		if (authenticate(true, &bwt, request, response) == true) {
-			serve(&page_alerts, response);
-		}
-	}
-
-	if (endpoint(request, "get", "/uplinks", &method_found, &pathname_found) == true) {
-		bwt_t bwt;
-		if (authenticate(true, &bwt, request, response) == true) {
-			serve(&page_uplinks, response);
-		}
-	}
-
-	if (endpoint(request, "get", "/downlinks", &method_found, &pathname_found) == true) {
-		bwt_t bwt;
-		if (authenticate(true, &bwt, request, response) == true) {
-			serve(&page_downlinks, response);
-		}
-	}
-
-	if (endpoint(request, "get", "/users", &method_found, &pathname_found) == true) {
-		bwt_t bwt;
-		if (authenticate(true, &bwt, request, response) == true) {
-			if (authorize(&bwt, permission_user_read, response) == true) {
-				serve(&page_users, response);
-			}
-		}
-	}
-
-	if (endpoint(request, "get", "/user/:id", &method_found, &pathname_found) == true) {
-		bwt_t bwt;
-		if (authenticate(true, &bwt, request, response) == true) {
-			if (authorize(&bwt, permission_user_read, response) == true) {
-				serve_user(db, request, response);
-			}
-		}
-	}
-
-	if (endpoint(request, "get", "/user/:id/devices", &method_found, &pathname_found) == true) {
-		bwt_t bwt;
-		if (authenticate(true, &bwt, request, response) == true) {
-			if (authorize(&bwt, permission_user_device_read, response) == true) {
-				serve_user_devices(db, request, response);
-			}
-		}
-	}
-
-	if (endpoint(request, "get", "/user/:id/zones", &method_found, &pathname_found) == true) {
-		bwt_t bwt;
-		if (authenticate(true, &bwt, request, response) == true) {
-			if (authorize(&bwt, permission_user_zone_read, response) == true) {
-				serve_user_zones(db, request, response);
-			}
-		}
-	}
-
-	if (endpoint(request, "get", "/profile", &method_found, &pathname_found)) {
-		bwt_t bwt;
-		if (authenticate(true, &bwt, request, response) == true) {
-			serve(&page_profile, response);
-		}
-	}
-
-	if (endpoint(request, "get", "/signin", &method_found, &pathname_found) == true) {
-		serve(&page_signin, response);
-	}
-
-	if (endpoint(request, "get", "/signup", &method_found, &pathname_found) == true) {
-		serve(&page_signup, response);
-	}
-
-	if (endpoint(request, "get", "/api/devices", &method_found, &pathname_found) == true) {
-		bwt_t bwt;
-		if (authenticate(false, &bwt, request, response) == true) {
-			device_find(db, &bwt, request, response);
-		}
-	}
-
-	if (endpoint(request, "get", "/api/readings", &method_found, &pathname_found) == true) {
-		bwt_t bwt;
-		if (authenticate(false, &bwt, request, response) == true) {
-			reading_find(db, &bwt, request, response);
-		}
-	}
-
-	if (endpoint(request, "get", "/api/metrics", &method_found, &pathname_found) == true) {
-		bwt_t bwt;
-		if (authenticate(false, &bwt, request, response) == true) {
-			metric_find(db, &bwt, request, response);
-		}
-	}
-
-	if (endpoint(request, "get", "/api/buffers", &method_found, &pathname_found) == true) {
-		bwt_t bwt;
-		if (authenticate(false, &bwt, request, response) == true) {
-			buffer_find(db, &bwt, request, response);
-		}
-	}
-
-	if (endpoint(request, "get", "/api/device/:id", &method_found, &pathname_found) == true) {
-		bwt_t bwt;
-		if (authenticate(false, &bwt, request, response) == true) {
-			device_find_one(db, &bwt, request, response);
-		}
-	}
-
-	if (endpoint(request, "patch", "/api/device/:id", &method_found, &pathname_found) == true) {
-		bwt_t bwt;
-		if (authenticate(false, &bwt, request, response) == true) {
-			if (authorize(&bwt, permission_device_update, response) == true) {
-				device_modify(db, request, response);
-			}
-		}
-	}
-
-	if (endpoint(request, "get", "/api/device/:id/readings", &method_found, &pathname_found) == true) {
-		bwt_t bwt;
-		if (authenticate(false, &bwt, request, response) == true) {
-			reading_find_by_device(db, &bwt, request, response);
-		}
-	}
-
-	if (endpoint(request, "get", "/api/device/:id/metrics", &method_found, &pathname_found) == true) {
-		bwt_t bwt;
-		if (authenticate(false, &bwt, request, response) == true) {
-			metric_find_by_device(db, &bwt, request, response);
-		}
-	}
-
-	if (endpoint(request, "get", "/api/device/:id/buffers", &method_found, &pathname_found) == true) {
-		bwt_t bwt;
-		if (authenticate(false, &bwt, request, response) == true) {
-			buffer_find_by_device(db, &bwt, request, response);
-		}
-	}
-
-	if (endpoint(request, "get", "/api/device/:id/config", &method_found, &pathname_found) == true) {
-		bwt_t bwt;
-		if (authenticate(false, &bwt, request, response) == true) {
-			config_find_one_by_device(db, &bwt, request, response);
-		}
-	}
-
-	if (endpoint(request, "patch", "/api/device/:id/config", &method_found, &pathname_found) == true) {
-		bwt_t bwt;
-		if (authenticate(false, &bwt, request, response) == true) {
-			if (authorize(&bwt, permission_config_update, response) == true) {
-				config_modify(db, &bwt, request, response);
-			}
-		}
-	}
-
-	if (endpoint(request, "get", "/api/device/:id/radio", &method_found, &pathname_found) == true) {
-		bwt_t bwt;
-		if (authenticate(false, &bwt, request, response) == true) {
-			radio_find_one_by_device(db, &bwt, request, response);
-		}
-	}
+const route_t routes[] = {
+	{.method = "get", .pathname = "/", .authenticate = true, .redirect = true, .page = &page_home},
+	{.method = "get", .pathname = "/robots.txt", .page = &page_robots},
+	{.method = "get", .pathname = "/security.txt", .page = &page_security},
+	{.method = "get", .pathname = "/devices", .authenticate = true, .redirect = true, .page = &page_devices},
+	{.method = "get", .pathname = "/device/:id", .authenticate = true, .redirect = true, .secured = serve_device},
+	{.method = "get", .pathname = "/device/:id/readings", .authenticate = true, .redirect = true,
+	 .secured = serve_device_readings},
+	{.method = "get", .pathname = "/device/:id/metrics", .authenticate = true, .redirect = true, .secured = serve_device_metrics},
+	{.method = "get", .pathname = "/device/:id/buffers", .authenticate = true, .redirect = true, .secured = serve_device_buffers},
+	{.method = "get", .pathname = "/device/:id/config", .authenticate = true, .redirect = true, .secured = serve_device_config},
+	{.method = "get", .pathname = "/device/:id/radio", .authenticate = true, .redirect = true, .secured = serve_device_radio},
+	{.method = "get", .pathname = "/device/:id/rules", .authenticate = true, .redirect = true, .secured = serve_device_rules},
+	{.method = "get", .pathname = "/device/:id/alerts", .authenticate = true, .redirect = true, .secured = serve_device_alerts},
+	{.method = "get", .pathname = "/device/:id/signals", .authenticate = true, .redirect = true, .secured = serve_device_signals},
+	{.method = "get", .pathname = "/device/:id/uplinks", .authenticate = true, .redirect = true, .secured = serve_device_uplinks},
+	{.method = "get", .pathname = "/device/:id/downlinks", .authenticate = true, .redirect = true,
+	 .secured = serve_device_downlinks},
+	{.method = "get", .pathname = "/zones", .authenticate = true, .redirect = true, .page = &page_zones},
+	{.method = "get", .pathname = "/zone/:id", .authenticate = true, .redirect = true, .secured = serve_zone},
+	{.method = "get", .pathname = "/zone/:id/readings", .authenticate = true, .redirect = true, .secured = serve_zone_readings},
+	{.method = "get", .pathname = "/zone/:id/metrics", .authenticate = true, .redirect = true, .secured = serve_zone_metrics},
+	{.method = "get", .pathname = "/zone/:id/buffers", .authenticate = true, .redirect = true, .secured = serve_zone_buffers},
+	{.method = "get", .pathname = "/zone/:id/signals", .authenticate = true, .redirect = true, .secured = serve_zone_signals},
+	{.method = "get", .pathname = "/alerts", .authenticate = true, .redirect = true, .page = &page_alerts},
+	{.method = "get", .pathname = "/uplinks", .authenticate = true, .redirect = true, .page = &page_uplinks},
+	{.method = "get", .pathname = "/downlinks", .authenticate = true, .redirect = true, .page = &page_downlinks},
+	{.method = "get", .pathname = "/users", .authenticate = true, .redirect = true, .permission = &permission_user_read,
+	 .page = &page_users},
+	{.method = "get", .pathname = "/user/:id", .authenticate = true, .redirect = true, .permission = &permission_user_read,
+	 .handler = serve_user},
+	{.method = "get", .pathname = "/user/:id/devices", .authenticate = true, .redirect = true,
+	 .permission = &permission_user_device_read, .handler = serve_user_devices},
+	{.method = "get", .pathname = "/user/:id/zones", .authenticate = true, .redirect = true,
+	 .permission = &permission_user_zone_read, .handler = serve_user_zones},
+	{.method = "get", .pathname = "/profile", .authenticate = true, .redirect = true, .page = &page_profile},
+	{.method = "get", .pathname = "/signin", .page = &page_signin},
+	{.method = "get", .pathname = "/signup", .page = &page_signup},
+	{.method = "get", .pathname = "/api/devices", .authenticate = true, .secured = device_find},
+	{.method = "get", .pathname = "/api/readings", .authenticate = true, .secured = reading_find},
+	{.method = "get", .pathname = "/api/metrics", .authenticate = true, .secured = metric_find},
+	{.method = "get", .pathname = "/api/buffers", .authenticate = true, .secured = buffer_find},
+	{.method = "get", .pathname = "/api/device/:id", .authenticate = true, .secured = device_find_one},
+	{.method = "patch", .pathname = "/api/device/:id", .authenticate = true, .permission = &permission_device_update,
+	 .handler = device_modify},
+	{.method = "get", .pathname = "/api/device/:id/readings", .authenticate = true, .secured = reading_find_by_device},
+	{.method = "get", .pathname = "/api/device/:id/metrics", .authenticate = true, .secured = metric_find_by_device},
+	{.method = "get", .pathname = "/api/device/:id/buffers", .authenticate = true, .secured = buffer_find_by_device},
+	{.method = "get", .pathname = "/api/device/:id/config", .authenticate = true, .secured = config_find_one_by_device},
+	{.method = "patch", .pathname = "/api/device/:id/config", .authenticate = true, .permission = &permission_config_update,
+	 .secured = config_modify},
+	{.method = "get", .pathname = "/api/device/:id/radio", .authenticate = true, .secured = radio_find_one_by_device},
+	{.method = "patch", .pathname = "/api/device/:id/radio", .authenticate = true, .permission = &permission_radio_update,
+	 .secured = radio_modify},
+	{.method = "get", .pathname = "/api/device/:id/rules", .authenticate = true, .secured = rule_find_by_device},
+	{.method = "post", .pathname = "/api/device/:id/rule", .authenticate = true, .permission = &permission_rule_create,
+	 .secured = rule_create},
+	{.method = "patch", .pathname = "/api/device/:id/rule", .authenticate = true, .permission = &permission_rule_update,
+	 .secured = rule_modify},
+	{.method = "delete", .pathname = "/api/device/:id/rule", .authenticate = true, .permission = &permission_rule_delete,
+	 .secured = rule_remove},
+	{.method = "get", .pathname = "/api/device/:id/alerts", .authenticate = true, .secured = alert_find_by_device},
+	{.method = "get", .pathname = "/api/device/:id/signals", .authenticate = true, .secured = uplink_signal_find_by_device},
+	{.method = "get", .pathname = "/api/device/:id/uplinks", .authenticate = true, .secured = uplink_find_by_device},
+	{.method = "get", .pathname = "/api/device/:id/downlinks", .authenticate = true, .secured = downlink_find_by_device},
+	{.method = "get", .pathname = "/api/zones", .authenticate = true, .secured = zone_find},
+	{.method = "get", .pathname = "/api/zone/:id", .authenticate = true, .secured = zone_find_one},
+	{.method = "patch", .pathname = "/api/zone/:id", .authenticate = true, .handler = zone_modify},
+	{.method = "get", .pathname = "/api/zone/:id/readings", .authenticate = true, .secured = reading_find_by_zone},
+	{.method = "get", .pathname = "/api/zone/:id/metrics", .authenticate = true, .secured = metric_find_by_zone},
+	{.method = "get", .pathname = "/api/zone/:id/buffers", .authenticate = true, .secured = buffer_find_by_zone},
+	{.method = "get", .pathname = "/api/zone/:id/signals", .authenticate = true, .secured = uplink_signal_find_by_zone},
+	{.method = "get", .pathname = "/api/alerts", .authenticate = true, .secured = alert_find},
+	{.method = "get", .pathname = "/api/uplinks", .authenticate = true, .secured = uplink_find},
+	{.method = "post", .pathname = "/api/uplink", .authenticate = true, .permission = &permission_uplink_create,
+	 .handler = uplink_create},
+	{.method = "post", .pathname = "/api/uplinks", .authenticate = true, .permission = &permission_uplink_create,
+	 .handler = uplink_create_batch},
+	{.method = "get", .pathname = "/api/downlinks", .authenticate = true, .secured = downlink_find},
+	{.method = "post", .pathname = "/api/downlink", .authenticate = true, .permission = &permission_downlink_create,
+	 .handler = downlink_create},
+	{.method = "get", .pathname = "/api/users", .authenticate = true, .permission = &permission_user_read, .handler = user_find},
+	{.method = "get", .pathname = "/api/user/:id", .authenticate = true, .permission = &permission_user_read,
+	 .handler = user_find_one},
+	{.method = "patch", .pathname = "/api/user/:id", .authenticate = true, .permission = &permission_user_update,
+	 .handler = user_modify_permissions},
+	{.method = "delete", .pathname = "/api/user/:id", .authenticate = true, .permission = &permission_user_delete,
+	 .handler = user_remove},
+	{.method = "get", .pathname = "/api/user/:id/devices", .authenticate = true, .permission = &permission_user_device_read,
+	 .handler = device_find_by_user},
+	{.method = "post", .pathname = "/api/user/:id/device", .authenticate = true, .permission = &permission_user_device_create,
+	 .handler = user_device_create},
+	{.method = "delete", .pathname = "/api/user/:id/device", .authenticate = true, .permission = &permission_user_device_delete,
+	 .handler = user_device_remove},
+	{.method = "get", .pathname = "/api/user/:id/zones", .authenticate = true, .permission = &permission_user_zone_read,
+	 .handler = zone_find_by_user},
+	{.method = "post", .pathname = "/api/user/:id/zone", .authenticate = true, .permission = &permission_user_zone_create,
+	 .handler = user_zone_create},
+	{.method = "delete", .pathname = "/api/user/:id/zone", .authenticate = true, .permission = &permission_user_zone_delete,
+	 .handler = user_zone_remove},
+	{.method = "get", .pathname = "/api/profile", .authenticate = true, .secured = user_profile},
+	{.method = "post", .pathname = "/api/signin", .handler = user_signin},
+	{.method = "post", .pathname = "/api/signup", .handler = user_signup},
+	{.method = "get", .pathname = "/api/stats", .authenticate = true, .permission = &permission_user_read, .handler = stats_find},
+};
+
+const uint8_t routes_len = sizeof(routes) / sizeof(*routes);
+
+route_node_t route_nodes[128];
+uint8_t route_nodes_len = 1;
+
+uint8_t route_method(const char *method, uint8_t method_len) {
+	if (method_len == 3 && memcmp(method, "get", 3) == 0) {
+		return 0;
+	}
+	if (method_len == 4 && memcmp(method, "head", 4) == 0) {
+		return 0;
+	}
+	if (method_len == 4 && memcmp(method, "post", 4) == 0) {
+		return 1;
+	}
+	if (method_len == 5 && memcmp(method, "patch", 5) == 0) {
+		return 2;
+	}
+	if (method_len == 6 && memcmp(method, "delete", 6) == 0) {
+		return 3;
+	}
+	return UINT8_MAX;
+}
 
-	if (endpoint(request, "patch", "/api/device/:id/radio", &method_found, &pathname_found) == true) {
-		bwt_t bwt;
-		if (authenticate(false, &bwt, request, response) == true) {
-			if (authorize(&bwt, permission_radio_update, response) == true) {
-				radio_modify(db, &bwt, request, response);
+int route_init(void) {
+	for (uint8_t index = 0; index < routes_len; index++) {
+		const route_t *rt = &routes[index];
+		const char *segment = rt->pathname + 1;
+		const char *end = rt->pathname + strlen(rt->pathname);
+
+		uint8_t node = 0;
+		while (true) {
+			const char *slash = memchr(segment, '/', (size_t)(end - segment));
+			if (slash == NULL) {
+				slash = end;
 			}
-		}
-	}
-
-	if (endpoint(request, "get", "/api/device/:id/rules", &method_found, &pathname_found) == true) {
-		bwt_t bwt;
-		if (authenticate(false, &bwt, request, response) == true) {
-			rule_find_by_device(db, &bwt, request, response);
-		}
-	}
-
-	if (endpoint(request, "post", "/api/device/:id/rule", &method_found, &pathname_found) == true) {
-		bwt_t bwt;
-		if (authenticate(false, &bwt, request, response) == true) {
-			if (authorize(&bwt, permission_rule_create, response) == true) {
-				rule_create(db, &bwt, request, response);
+			uint8_t segment_len = (uint8_t)(slash - segment);
+
+			uint8_t prev = 0;
+			uint8_t child = route_nodes[node].child;
+			while (child != 0) {
+				if (route_nodes[child].segment_len == segment_len && memcmp(route_nodes[child].segment, segment, segment_len) == 0) {
+					break;
+				}
+				prev = child;
+				child = route_nodes[child].sibling;
 			}
-		}
-	}
 
-	if (endpoint(request, "patch", "/api/device/:id/rule", &method_found, &pathname_found) == true) {
-		bwt_t bwt;
-		if (authenticate(false, &bwt, request, response) == true) {
-			if (authorize(&bwt, permission_rule_update, response) == true) {
-				rule_modify(db, &bwt, request, response);
+			if (child == 0) {
+				if (route_nodes_len >= sizeof(route_nodes) / sizeof(*route_nodes)) {
+					error("failed to compile route %s %s because of too many segments\n", rt->method, rt->pathname);
+					return -1;
+				}
+				child = route_nodes_len++;
+				route_nodes[child] = (route_node_t){.segment = segment, .segment_len = segment_len};
+				route_nodes[child].param = segment_len > 0 && segment[0] == ':';
+				if (prev == 0) {
+					route_nodes[node].child = child;
+				} else {
+					route_nodes[prev].sibling = child;
+				}
 			}
-		}
-	}
 
-	if (endpoint(request, "delete", "/api/device/:id/rule", &method_found, &pathname_found) == true) {
-		bwt_t bwt;
-		if (authenticate(false, &bwt, request, response) == true) {
-			if (authorize(&bwt, permission_rule_delete, response) == true) {
-				rule_remove(db, &bwt, request, response);
+			node = child;
+			if (slash == end) {
+				break;
 			}
+			segment = slash + 1;
 		}
-	}
 
-	if (endpoint(request, "get", "/api/device/:id/alerts", &method_found, &pathname_found) == true) {
-		bwt_t bwt;
-		if (authenticate(false, &bwt, request, response) == true) {
-			alert_find_by_device(db, &bwt, request, response);
-		}
+		route_nodes[node].routes[route_method(rt->method, (uint8_t)strlen(rt->method))] = index + 1;
 	}
 
-	if (endpoint(request, "get", "/api/device/:id/signals", &method_found, &pathname_found) == true) {
-		bwt_t bwt;
-		if (authenticate(false, &bwt, request, response) == true) {
-			uplink_signal_find_by_device(db, &bwt, request, response);
-		}
-	}
-
-	if (endpoint(request, "get", "/api/device/:id/uplinks", &method_found, &pathname_found) == true) {
-		bwt_t bwt;
-		if (authenticate(false, &bwt, request, response) == true) {
-			uplink_find_by_device(db, &bwt, request, response);
-		}
-	}
-
-	if (endpoint(request, "get", "/api/device/:id/downlinks", &method_found, &pathname_found) == true) {
-		bwt_t bwt;
-		if (authenticate(false, &bwt, request, response) == true) {
-			downlink_find_by_device(db, &bwt, request, response);
-		}
-	}
-
-	if (endpoint(request, "get", "/api/zones", &method_found, &pathname_found) == true) {
-		bwt_t bwt;
-		if (authenticate(false, &bwt, request, response) == true) {
-			zone_find(db, &bwt, request, response);
-		}
-	}
-
-	if (endpoint(request, "get", "/api/zone/:id", &method_found, &pathname_found) == true) {
-		bwt_t bwt;
-		if (authenticate(false, &bwt, request, response) == true) {
-			zone_find_one(db, &bwt, request, response);
-		}
-	}
-
-	if (endpoint(request, "patch", "/api/zone/:id", &method_found, &pathname_found) == true) {
-		bwt_t bwt;
-		if (authenticate(false, &bwt, request, response) == true) {
-			zone_modify(db, request, response);
-		}
-	}
-
-	if (endpoint(request, "get", "/api/zone/:id/readings", &method_found, &pathname_found) == true) {
-		bwt_t bwt;
-		if (authenticate(false, &bwt, request, response) == true) {
-			reading_find_by_zone(db, &bwt, request, response);
-		}
-	}
-
-	if (endpoint(request, "get", "/api/zone/:id/metrics", &method_found, &pathname_found) == true) {
-		bwt_t bwt;
-		if (authenticate(false, &bwt, request, response) == true) {
-			metric_find_by_zone(db, &bwt, request, response);
-		}
-	}
-
-	if (endpoint(request, "get", "/api/zone/:id/buffers", &method_found, &pathname_found) == true) {
-		bwt_t bwt;
-		if (authenticate(false, &bwt, request, response) == true) {
-			buffer_find_by_zone(db, &bwt, request, response);
-		}
-	}
-
-	if (endpoint(request, "get", "/api/zone/:id/signals", &method_found, &pathname_found) == true) {
-		bwt_t bwt;
-		if (authenticate(false, &bwt, request, response) == true) {
-			uplink_signal_find_by_zone(db, &bwt, request, response);
-		}
-	}
-
-	if (endpoint(request, "get", "/api/alerts", &method_found, &pathname_found) == true) {
-		bwt_t bwt;
-		if (authenticate(false, &bwt, request, response) == true) {
-			alert_find(db, &bwt, request, response);
-		}
-	}
-
-	if (endpoint(request, "get", "/api/uplinks", &method_found, &pathname_found) == true) {
-		bwt_t bwt;
-		if (authenticate(false, &bwt, request, response) == true) {
-			uplink_find(db, &bwt, request, response);
-		}
-	}
-
-	if (endpoint(request, "post", "/api/uplink", &method_found, &pathname_found) == true) {
-		bwt_t bwt;
-		if (authenticate(false, &bwt, request, response) == true) {
-			if (authorize(&bwt, permission_uplink_create, response) == true) {
-				uplink_create(db, request, response);
-			}
-		}
-	}
-
-	if (endpoint(request, "get", "/api/downlinks", &method_found, &pathname_found) == true) {
-		bwt_t bwt;
-		if (authenticate(false, &bwt, request, response) == true) {
-			downlink_find(db, &bwt, request, response);
-		}
-	}
-
-	if (endpoint(request, "post", "/api/downlink", &method_found, &pathname_found) == true) {
-		bwt_t bwt;
-		if (authenticate(false, &bwt, request, response) == true) {
-			if (authorize(&bwt, permission_downlink_create, response) == true) {
-				downlink_create(db, request, response);
-			}
-		}
-	}
-
-	if (endpoint(request, "get", "/api/users", &method_found, &pathname_found) == true) {
-		bwt_t bwt;
-		if (authenticate(false, &bwt, request, response) == true) {
-			if (authorize(&bwt, permission_user_read, response) == true) {
-				user_find(db, request, response);
-			}
-		}
-	}
+	debug("compiled %hhu routes into %hhu segments\n", routes_len, route_nodes_len);
+	return 0;
+}
 
-	if (endpoint(request, "get", "/api/user/:id", &method_found, &pathname_found) == true) {
-		bwt_t bwt;
-		if (authenticate(false, &bwt, request, response) == true) {
-			if (authorize(&bwt, permission_user_read, response) == true) {
-				user_find_one(db, request, response);
+const route_t *route_find(request_t *request, bool *pathname_found) {
+	const char *pathname = request->pathname.ptr;
+	uint8_t pathname_len = request->pathname.len;
+	if (pathname_len == 0 || pathname[0] != '/') {
+		return NULL;
+	}
+
+	request->params_len = 0;
+
+	uint8_t node = 0;
+	uint8_t offset = 1;
+	while (true) {
+		uint8_t end = offset;
+		while (end < pathname_len && pathname[end] != '/') {
+			end++;
+		}
+		uint8_t segment_len = end - offset;
+
+		uint8_t match = 0;
+		uint8_t param = 0;
+		for (uint8_t child = route_nodes[node].child; child != 0; child = route_nodes[child].sibling) {
+			if (route_nodes[child].param == true) {
+				param = child;
+			} else if (route_nodes[child].segment_len == segment_len &&
+								 memcmp(route_nodes[child].segment, &pathname[offset], segment_len) == 0) {
+				match = child;
+				break;
 			}
 		}
-	}
 
-	if (endpoint(request, "patch", "/api/user/:id", &method_found, &pathname_found) == true) {
-		bwt_t bwt;
-		if (authenticate(false, &bwt, request, response) == true) {
-			if (authorize(&bwt, permission_user_update, response) == true) {
-				user_modify_permissions(db, request, response);
+		if (match == 0 && param != 0 && segment_len > 0) {
+			match = param;
+			if (request->params_len < sizeof(request->params) / sizeof(*request->params)) {
+				request->params[request->params_len] = (param_t){.offset = offset, .len = segment_len};
+				request->params_len++;
 			}
 		}
-	}
 
-	if (endpoint(request, "delete", "/api/user/:id", &method_found, &pathname_found) == true) {
-		bwt_t bwt;
-		if (authenticate(false, &bwt, request, response) == true) {
-			if (authorize(&bwt, permission_user_delete, response) == true) {
-				user_remove(db, request, response);
-			}
+		if (match == 0) {
+			return NULL;
 		}
-	}
 
-	if (endpoint(request, "get", "/api/user/:id/devices", &method_found, &pathname_found) == true) {
-		bwt_t bwt;
-		if (authenticate(false, &bwt, request, response) == true) {
-			if (authorize(&bwt, permission_user_device_read, response) == true) {
-				device_find_by_user(db, request, response);
-			}
+		node = match;
+		if (end == pathname_len) {
+			break;
 		}
+		offset = end + 1;
 	}
 
-	if (endpoint(request, "post", "/api/user/:id/device", &method_found, &pathname_found) == true) {
-		bwt_t bwt;
-		if (authenticate(false, &bwt, request, response) == true) {
-			if (authorize(&bwt, permission_user_device_create, response) == true) {
-				user_device_create(db, request, response);
-			}
-		}
+	uint8_t *methods = route_nodes[node].routes;
+	if (methods[0] == 0 && methods[1] == 0 && methods[2] == 0 && methods[3] == 0) {
+		return NULL;
 	}
+	*pathname_found = true;
 
-	if (endpoint(request, "delete", "/api/user/:id/device", &method_found, &pathname_found) == true) {
-		bwt_t bwt;
-		if (authenticate(false, &bwt, request, response) == true) {
-			if (authorize(&bwt, permission_user_device_delete, response) == true) {
-				user_device_remove(db, request, response);
-			}
-		}
+	uint8_t method = route_method(request->method.ptr, request->method.len);
+	if (method == UINT8_MAX || methods[method] == 0) {
+		return NULL;
 	}
 
-	if (endpoint(request, "get", "/api/user/:id/zones", &method_found, &pathname_found) == true) {
-		bwt_t bwt;
-		if (authenticate(false, &bwt, request, response) == true) {
-			if (authorize(&bwt, permission_user_zone_read, response) == true) {
-				zone_find_by_user(db, request, response);
-			}
-		}
-	}
+	return &routes[methods[method] - 1];
+}
 
-	if (endpoint(request, "post", "/api/user/:id/zone", &method_found, &pathname_found) == true) {
-		bwt_t bwt;
-		if (authenticate(false, &bwt, request, response) == true) {
-			if (authorize(&bwt, permission_user_zone_create, response) == true) {
-				user_zone_create(db, request, response);
-			}
-		}
+void route(octet_t *db, request_t *request, response_t *response) {
+	if (response->status != 0) {
+		goto respond;
 	}
 
-	if (endpoint(request, "delete", "/api/user/:id/zone", &method_found, &pathname_found) == true) {
-		bwt_t bwt;
-		if (authenticate(false, &bwt, request, response) == true) {
-			if (authorize(&bwt, permission_user_zone_delete, response) == true) {
-				user_zone_remove(db, request, response);
-			}
-		}
+	bool pathname_found = false;
+	const route_t *rt = route_find(request, &pathname_found);
+	if (rt == NULL) {
+		response->status = pathname_found == true ? 405 : 404;
+		goto respond;
 	}
+	request->route = (uint8_t)(rt - routes + 1);
 
-	if (endpoint(request, "get", "/api/profile", &method_found, &pathname_found) == true) {
-		bwt_t bwt;
-		if (authenticate(false, &bwt, request, response) == true) {
-			user_profile(db, &bwt, request, response);
-		}
+	bwt_t bwt;
+	uint64_t authorized_at = span_clock();
+	bool authorized = (rt->authenticate == false || authenticate(rt->redirect, &bwt, request, response) == true) &&
+										(rt->permission == NULL || authorize(&bwt, *rt->permission, response) == true);
+	span.auth += span_clock() - authorized_at;
+	if (authorized == false) {
+		goto respond;
 	}
-
-	if (endpoint(request, "post", "/api/signin", &method_found, &pathname_found) == true) {
-		user_signin(db, request, response);
+	if (rt->authenticate == true) {
+		memcpy(span.user, bwt.id, sizeof(span.user));
+		span.authenticated = true;
 	}
 
-	if (endpoint(request, "post", "/api/signup", &method_found, &pathname_found) == true) {
-		user_signup(db, request, response);
+	if (rt->page != NULL) {
+		serve(rt->page, request, response);
+	} else if (rt->secured != NULL) {
+		rt->secured(db, &bwt, request, response);
+	} else {
+		rt->handler(db, request, response);
 	}
 
 respond:
-	if (response->status == 0 && pathname_found == false && method_found == false) {
-		response->status = 404;
-	}
-	if (response->status == 0 && pathname_found == true && method_found == false) {
-		response->status = 405;
-	}
-
 	if (request->pathname.len >= 5 && memcmp(request->pathname.ptr, "/api/", 5) == 0) {
 		return;
 	}
 
 	if (response->status == 400) {
-		serve(&page_bad_request, response);
+		serve(&page_bad_request, request, response);
 	}
 	if (response->status == 401) {
-		serve(&page_unauthorized, response);
+		serve(&page_unauthorized, request, response);
 	}
 	if (response->status == 403) {
-		serve(&page_forbidden, response);
+		serve(&page_forbidden, request, response);
 	}
 	if (response->status == 404) {
-		serve(&page_not_found, response);
+		serve(&page_not_found, request, response);
 	}
 	if (response->status == 405) {
-		serve(&page_method_not_allowed, response);
+		serve(&page_method_not_allowed, request, response);
 	}
 	if (response->status == 414) {
-		serve(&page_uri_too_long, response);
+		serve(&page_uri_too_long, request, response);
 	}
 	if (response->status == 431) {
-		serve(&page_request_header_fields_too_large, response);
+		serve(&page_request_header_fields_too_large, request, response);
 	}
 	if (response->status == 500) {
-		serve(&page_internal_server_error, response);
+		serve(&page_internal_server_error, request, response);
 	}
 	if (response->status == 503) {
-		serve(&page_service_unavailable, response);
+		serve(&page_service_unavailable, request, response);
 	}
 	if (response->status == 505) {
-		serve(&page_http_version_not_supported, response);
+		serve(&page_http_version_not_supported, request, response);
 	}
 	if (response->status == 507) {
-		serve(&page_insufficient_storage, response);
+		serve(&page_insufficient_storage, request, response);
 	}
 }
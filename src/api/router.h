@@ -1,7 +1,38 @@
 #pragma once
 
+#include "../app/file.h"
+#include "../lib/bwt.h"
 #include "../lib/octet.h"
 #include "../lib/request.h"
 #include "../lib/response.h"
+#include <stdbool.h>
+#include <stdint.h>
 
+typedef struct route_t {
+	const char *method;
+	const char *pathname;
+	bool authenticate;
+	bool redirect;
+	const uint64_t *permission;
+	file_t *page;
+	void (*handler)(octet_t *db, request_t *request, response_t *response);
+	void (*secured)(octet_t *db, bwt_t *bwt, request_t *request, response_t *response);
+} route_t;
+
+typedef struct route_node_t {
+	const char *segment;
+	uint8_t segment_len;
+	bool param;
+	uint8_t child;
+	uint8_t sibling;
+	uint8_t routes[4];
+} route_node_t;
+
+extern const uint64_t permission_uplink_create;
+
+extern const route_t routes[];
+extern const uint8_t routes_len;
+
+int route_init(void);
+const route_t *route_find(request_t *request, bool *pathname_found);
 void route(octet_t *db, request_t *request, response_t *response);
@@ -5,6 +5,7 @@
 #include "../lib/logger.h"
 #include "../lib/octet.h"
 #include "../lib/response.h"
+#include "../lib/span.h"
 #include "cache.h"
 #include "device.h"
 #include "user-device.h"
@@ -430,6 +431,7 @@ void rule_find_by_device(octet_t *db, bwt_t *bwt, request_t *request, response_t
 	}
 	header_write(response, "content-type:application/octet-stream\r\n");
 	header_write(response, "content-length:%u\r\n", response->body.len);
+	span.emitted = rules_len;
 	info("found %hu rules\n", rules_len);
 	response->status = 200;
 }
@@ -1,3 +1,8 @@
+#include "../app/airtime.h"
+#include "../app/packet.h"
+#include "../lib/base16.h"
+#include "../lib/config.h"
+#include "../lib/error.h"
 #include "../lib/logger.h"
 #include "../lib/octet.h"
 #include "alert.h"
@@ -16,18 +21,60 @@
 #include "user-zone.h"
 #include "user.h"
 #include "zone.h"
+#include <errno.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <stdatomic.h>
 #include <stdbool.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 #include <time.h>
+#include <unistd.h>
+
+typedef struct seed_file_t {
+	octet_stmt_t stmt;
+	char file[128];
+	uint8_t *chunk;
+	size_t chunk_len;
+	off_t offset;
+} seed_file_t;
+
+typedef struct seed_job_t {
+	uint8_t (*device_id)[8];
+	unsigned int rand_state;
+	int status;
+	reading_t reading;
+	metric_t metric;
+	buffer_t buffer;
+	uplink_t uplink;
+	uint8_t uplink_data[16];
+	downlink_t downlink;
+	uint8_t downlink_data[16];
+	uint16_t airtime[8];
+	time_t airtime_bucket;
+	uint8_t packet_rx[8];
+	uint8_t packet_lost[8];
+	time_t packet_bucket;
+	uint16_t last_frame;
+} seed_job_t;
 
 uint8_t (*user_ids)[8];
 uint8_t user_ids_len;
 uint8_t (*zone_ids)[8];
+char (*zone_names)[16];
+uint8_t (*zone_colors)[12];
 uint8_t zone_ids_len;
 uint8_t (*device_ids)[8];
-uint8_t device_ids_len;
+uint16_t device_ids_len;
+uint8_t *device_rows;
+uint32_t device_rows_len;
+
+seed_job_t *seed_jobs;
+atomic_uint_fast16_t seed_jobs_next;
+time_t seed_from;
+time_t seed_to;
+const size_t seed_chunk = 1048576;
 
 int seed_user(octet_t *db) {
 	char *usernames[] = {"alice", "bob", "charlie", "dave"};
@@ -68,18 +115,27 @@ int seed_zone(octet_t *db) {
 			{0x02, 0x84, 0xc7, 0x38, 0xbd, 0xf8, 0xf0, 0xf9, 0xff, 0x08, 0x2f, 0x49},
 	};
 
-	zone_ids_len = sizeof(names) / sizeof(*names);
+	zone_ids_len = (uint8_t)(sizeof(names) / sizeof(*names) + seed_devices / 128);
 	zone_ids = malloc(zone_ids_len * sizeof(*zone_ids));
-	if (zone_ids == NULL) {
+	zone_names = malloc(zone_ids_len * sizeof(*zone_names));
+	zone_colors = malloc(zone_ids_len * sizeof(*zone_colors));
+	if (zone_ids == NULL || zone_names == NULL || zone_colors == NULL) {
 		return -1;
 	}
 
 	for (uint8_t index = 0; index < zone_ids_len; index++) {
+		if (index < sizeof(names) / sizeof(*names)) {
+			sprintf(zone_names[index], "%s", names[index]);
+		} else {
+			sprintf(zone_names[index], "zone-%hhu", index);
+		}
+		memcpy(zone_colors[index], colors[index % 2], sizeof(*zone_colors));
+
 		zone_t zone = {
 				.id = &zone_ids[index],
-				.name = names[index],
-				.name_len = (uint8_t)strlen(names[index]),
-				.color = &colors[index],
+				.name = zone_names[index],
+				.name_len = (uint8_t)strlen(zone_names[index]),
+				.color = &zone_colors[index],
 				.created_at = (time_t[]){time(NULL)},
 		};
 
@@ -112,38 +168,127 @@ int seed_user_zone(octet_t *db) {
 	return 0;
 }
 
+int seed_idcmp(const void *alpha, const void *bravo) {
+	return memcmp((const uint8_t *)alpha + device_row.id, (const uint8_t *)bravo + device_row.id, sizeof(*device_ids));
+}
+
+uint8_t *seed_catalog_find(uint8_t (*device_id)[8]) {
+	uint32_t low = 0;
+	uint32_t high = device_rows_len;
+	while (low < high) {
+		uint32_t mid = low + (high - low) / 2;
+		int order = memcmp(&device_rows[mid * device_row.size + device_row.id], device_id, sizeof(*device_id));
+		if (order == 0) {
+			return &device_rows[mid * device_row.size];
+		}
+		if (order < 0) {
+			low = mid + 1;
+		} else {
+			high = mid;
+		}
+	}
+	return NULL;
+}
+
+int seed_catalog(octet_t *db, uint8_t *rows, uint16_t rows_len) {
+	int status;
+
+	char file[128];
+	if (sprintf(file, "%s/%s.data", db->directory, device_file) == -1) {
+		error("failed to sprintf to file\n");
+		return -1;
+	}
+
+	octet_stmt_t stmt;
+	if (octet_open(&stmt, file, O_RDWR, F_WRLCK) == -1) {
+		status = -1;
+		goto cleanup;
+	}
+
+	if (device_rows == NULL) {
+		uint32_t existing_len = (uint32_t)(stmt.stat.st_size / device_row.size);
+		device_rows = malloc((existing_len + rows_len) * device_row.size);
+		if (device_rows == NULL) {
+			error("failed to allocate device catalog because %s\n", errno_str());
+			status = -1;
+			goto cleanup;
+		}
+
+		uint8_t *existing = &device_rows[rows_len * device_row.size];
+		for (uint32_t index = 0; index < existing_len; index++) {
+			if (octet_row_read(&stmt, file, index * device_row.size, &existing[index * device_row.size], device_row.size) == -1) {
+				status = -1;
+				goto cleanup;
+			}
+		}
+
+		uint32_t alpha = 0;
+		uint32_t bravo = 0;
+		device_rows_len = 0;
+		while (alpha < existing_len || bravo < rows_len) {
+			uint8_t *row;
+			if (bravo >= rows_len ||
+					(alpha < existing_len && seed_idcmp(&existing[alpha * device_row.size], &rows[bravo * device_row.size]) < 0)) {
+				row = &existing[alpha++ * device_row.size];
+			} else {
+				row = &rows[bravo++ * device_row.size];
+			}
+			memmove(&device_rows[device_rows_len++ * device_row.size], row, device_row.size);
+		}
+	}
+
+	if (octet_bulk_write(&stmt, file, 0, device_rows, device_rows_len * device_row.size) == -1) {
+		status = -1;
+		goto cleanup;
+	}
+
+	status = 0;
+
+cleanup:
+	octet_close(&stmt, file);
+	return status;
+}
+
 int seed_device(octet_t *db) {
-	device_ids_len = (uint8_t)(8 + rand() % 16);
+	int status = -1;
+
+	device_ids_len = seed_devices != 0 ? seed_devices : (uint16_t)(8 + rand() % 16);
 	device_ids = malloc(device_ids_len * sizeof(*device_ids));
-	if (device_ids == NULL) {
-		return -1;
+	uint8_t *rows = malloc(device_ids_len * device_row.size);
+	if (device_ids == NULL || rows == NULL) {
+		goto cleanup;
 	}
 
-	char *zone_names[] = {"indoor", "outdoor"};
-	uint8_t zone_colors[][12] = {
-			{0x16, 0xa3, 0x4a, 0x4a, 0xde, 0x80, 0xf0, 0xfd, 0xf4, 0x05, 0x2e, 0x16},
-			{0x02, 0x84, 0xc7, 0x38, 0xbd, 0xf8, 0xf0, 0xf9, 0xff, 0x08, 0x2f, 0x49},
-	};
+	time_t created_at = time(NULL);
+	for (uint16_t index = 0; index < device_ids_len; index++) {
+		uint8_t *row = &rows[index * device_row.size];
+		memset(row, 0, device_row.size);
 
-	for (uint8_t index = 0; index < device_ids_len; index++) {
-		char name[16];
-		uint8_t name_len = (uint8_t)(4 + rand() % 12);
-		for (uint8_t ind = 0; ind < name_len; ind++) {
-			name[ind] = (char)('a' + rand() % 26);
+		uint8_t device_id[8];
+		for (uint8_t ind = 0; ind < sizeof(device_id); ind++) {
+			device_id[ind] = (uint8_t)(rand() & 0xff);
 		}
 
-		uint8_t (*zone_id)[8];
-		char *zone_name;
-		uint8_t (*zone_color)[12];
+		char device_name[16];
+		uint8_t device_name_len = (uint8_t)(4 + rand() % 12);
+		for (uint8_t ind = 0; ind < device_name_len; ind++) {
+			device_name[ind] = (char)('a' + rand() % 26);
+		}
+
+		octet_blob_write(row, device_row.id, device_id, sizeof(device_id));
+		octet_uint8_write(row, device_row.name_len, device_name_len);
+		octet_text_write(row, device_row.name, device_name, device_name_len);
+
 		if (rand() % 5 == 0) {
-			zone_id = NULL;
-			zone_name = NULL;
-			zone_color = NULL;
+			octet_uint8_write(row, device_row.zone_null, 0x00);
 		} else {
 			uint8_t ind = (uint8_t)(rand() % zone_ids_len);
-			zone_id = &zone_ids[ind];
-			zone_name = zone_names[ind];
-			zone_color = &zone_colors[ind];
+			uint8_t zone_name_len = (uint8_t)strlen(zone_names[ind]);
+			octet_uint8_write(row, device_row.zone_null, 0x01);
+			octet_blob_write(row, device_row.zone_id, zone_ids[ind], sizeof(*zone_ids));
+			octet_uint8_write(row, device_row.zone_name_len, zone_name_len);
+			octet_text_write(row, device_row.zone_name, zone_names[ind], zone_name_len);
+			octet_blob_write(row, device_row.zone_color, zone_colors[ind], sizeof(*zone_colors));
 		}
 
 		char firmware[16];
@@ -152,6 +297,8 @@ int seed_device(octet_t *db) {
 			firmware_len =
 					(uint8_t)sprintf(firmware, "v%hhu.%hhu.%hhu", (uint8_t)(rand() % 4), (uint8_t)(rand() % 8), (uint8_t)(rand() % 16));
 		}
+		octet_uint8_write(row, device_row.firmware_len, firmware_len);
+		octet_text_write(row, device_row.firmware, firmware, firmware_len);
 
 		char hardware[16];
 		uint8_t hardware_len = 0;
@@ -159,34 +306,33 @@ int seed_device(octet_t *db) {
 			hardware_len =
 					(uint8_t)sprintf(hardware, "v%hhu.%hhu.%hhu", (uint8_t)(rand() % 2), (uint8_t)(rand() % 4), (uint8_t)(rand() % 8));
 		}
+		octet_uint8_write(row, device_row.hardware_len, hardware_len);
+		octet_text_write(row, device_row.hardware, hardware, hardware_len);
 
-		device_t device = {
-				.id = &device_ids[index],
-				.name = name,
-				.name_len = name_len,
-				.zone_id = zone_id,
-				.zone_name = zone_name,
-				.zone_name_len = zone_name == NULL ? 0 : (uint8_t)strlen(zone_name),
-				.zone_color = zone_color,
-				.firmware = firmware_len == 0 ? NULL : firmware,
-				.firmware_len = firmware_len,
-				.hardware = hardware_len == 0 ? NULL : hardware,
-				.hardware_len = hardware_len,
-				.created_at = (time_t[]){time(NULL)},
-		};
+		octet_uint64_write(row, device_row.created_at, (uint64_t)created_at);
+	}
 
-		if (device_insert(db, &device) != 0) {
-			return -1;
-		}
+	qsort(rows, device_ids_len, device_row.size, &seed_idcmp);
+	for (uint16_t index = 0; index < device_ids_len; index++) {
+		memcpy(device_ids[index], &rows[index * device_row.size + device_row.id], sizeof(*device_ids));
+	}
+
+	if (seed_catalog(db, rows, device_ids_len) == -1) {
+		goto cleanup;
 	}
 
 	info("seeded file %s\n", device_file);
-	return 0;
+	status = 0;
+
+cleanup:
+	free(rows);
+	return status;
 }
 
 int seed_user_device(octet_t *db) {
 	for (uint8_t index = 0; index < user_ids_len; index++) {
-		for (uint8_t ind = 0; ind < device_ids_len; ind++) {
+		uint8_t linked = 0;
+		for (uint16_t ind = 0; ind < device_ids_len && linked < 255; ind++) {
 			if (rand() % 2 == 0) {
 				user_device_t user_device = {
 						.user_id = &user_ids[index],
@@ -196,6 +342,7 @@ int seed_user_device(octet_t *db) {
 				if (user_device_insert(db, &user_device) != 0) {
 					return -1;
 				}
+				linked++;
 			}
 		}
 	}
@@ -205,15 +352,15 @@ int seed_user_device(octet_t *db) {
 }
 
 int seed_host(octet_t *db) {
-	char *address = "0.0.0.0";
+	char *host_address = "0.0.0.0";
 	char *username = "warden";
 	char *password = ".go4Warden";
 
 	uint8_t id[8];
 	host_t host = {
 			.id = &id,
-			.address = address,
-			.address_len = (uint8_t)strlen(address),
+			.address = host_address,
+			.address_len = (uint8_t)strlen(host_address),
 			.port = 1278,
 			.username = username,
 			.username_len = (uint8_t)strlen(username),
@@ -230,13 +377,13 @@ int seed_host(octet_t *db) {
 }
 
 int seed_email(octet_t *db) {
-	char *address = "0.0.0.0";
+	char *email_address = "0.0.0.0";
 	char *from = "warden@example.com";
 	char *to = "alerts@example.com";
 
 	email_t email = {
-			.address = address,
-			.address_len = (uint8_t)strlen(address),
+			.address = email_address,
+			.address_len = (uint8_t)strlen(email_address),
 			.port = 25,
 			.from = from,
 			.from_len = (uint8_t)strlen(from),
@@ -252,136 +399,577 @@ int seed_email(octet_t *db) {
 	return 0;
 }
 
-int seed_reading(octet_t *db) {
-	for (uint8_t index = 0; index < device_ids_len; index++) {
-		float temperature = (float)(rand() % 6000) / 100 - 20;
-		float humidity = (float)(rand() % 10000) / 100;
-		time_t now = time(NULL);
-		time_t captured_at = time(NULL) - 2 * 24 * 60 * 60;
-		while (captured_at < now) {
-			reading_t reading = {
-					.temperature = temperature,
-					.humidity = humidity,
-					.captured_at = captured_at,
-					.device_id = &device_ids[index],
-			};
+int seed_files(octet_t *db, uint8_t (*device_id)[8]) {
+	char uuid[16];
+	if (base16_encode(uuid, sizeof(uuid), device_id, sizeof(*device_id)) == -1) {
+		error("failed to encode uuid to base 16\n");
+		return -1;
+	}
 
-			if (reading_insert(db, &reading) != 0) {
-				return -1;
-			}
-			temperature += ((float)rand() / (float)RAND_MAX) * 2.0f - 1.0f;
-			if (temperature < -20) {
-				temperature += 1;
-			}
-			if (temperature > 40) {
-				temperature -= 1;
-			}
-			humidity += ((float)rand() / (float)RAND_MAX) * 2.0f - 1.0f;
-			if (humidity < 0) {
-				humidity += 1;
-			}
-			if (humidity > 100) {
-				humidity -= 1;
-			}
-			captured_at += 56 + rand() % 8;
+	char file[128];
+	if (sprintf(file, "%s/%.*s", db->directory, (int)sizeof(uuid), uuid) == -1) {
+		error("failed to sprintf uuid to directory\n");
+		return -1;
+	}
+
+	if (octet_mkdir(file) == -1) {
+		return -1;
+	}
+
+	const char *files[] = {uplink_file, downlink_file, reading_file, metric_file, buffer_file,
+												 config_file, radio_file,		 alert_file,	 rule_file};
+	for (uint8_t index = 0; index < sizeof(files) / sizeof(*files); index++) {
+		if (sprintf(file, "%s/%.*s/%s.data", db->directory, (int)sizeof(uuid), uuid, files[index]) == -1) {
+			error("failed to sprintf uuid to file\n");
+			return -1;
+		}
+
+		if (octet_creat(file) == -1) {
+			return -1;
 		}
 	}
 
-	info("seeded file %s\n", reading_file);
 	return 0;
 }
 
-int seed_metric(octet_t *db) {
-	for (uint8_t index = 0; index < device_ids_len; index++) {
-		float photovoltaic = (float)(rand() % 5000) / 1000;
-		float battery = (float)(rand() % 1000) / 1000 + 3.2f;
-		time_t now = time(NULL);
-		time_t captured_at = time(NULL) - 2 * 24 * 60 * 60;
-		while (captured_at < now) {
-			metric_t metric = {
-					.photovoltaic = photovoltaic,
-					.battery = battery,
-					.captured_at = captured_at,
-					.device_id = &device_ids[index],
-			};
+int seed_open(octet_t *db, seed_file_t *seed_file, uint8_t (*device_id)[8], const char *series, uint8_t *chunk) {
+	char uuid[16];
+	if (base16_encode(uuid, sizeof(uuid), device_id, sizeof(*device_id)) == -1) {
+		error("failed to encode uuid to base 16\n");
+		return -1;
+	}
 
-			if (metric_insert(db, &metric) != 0) {
-				return -1;
-			}
-			photovoltaic += ((float)rand() / (float)RAND_MAX) * 0.2f - 0.1f;
-			if (photovoltaic < 0) {
-				photovoltaic += 0.1f;
-			}
-			if (photovoltaic > 5) {
-				photovoltaic -= 0.1f;
-			}
-			battery += ((float)rand() / (float)RAND_MAX) * 0.2f - 0.1f;
-			if (battery < 3.2) {
-				battery += 0.1f;
-			}
-			if (battery > 4.2) {
-				battery -= 0.1f;
-			}
-			captured_at += 56 + rand() % 8;
-		}
+	if (sprintf(seed_file->file, "%s/%.*s/%s.data", db->directory, (int)sizeof(uuid), uuid, series) == -1) {
+		error("failed to sprintf uuid to file\n");
+		return -1;
 	}
 
-	info("seeded file %s\n", metric_file);
+	if (octet_open(&seed_file->stmt, seed_file->file, O_RDWR, F_WRLCK) == -1) {
+		octet_close(&seed_file->stmt, seed_file->file);
+		return -1;
+	}
+
+	seed_file->chunk = chunk;
+	seed_file->chunk_len = 0;
+	seed_file->offset = seed_file->stmt.stat.st_size;
 	return 0;
 }
 
-int seed_buffer(octet_t *db) {
-	for (uint8_t index = 0; index < device_ids_len; index++) {
-		uint32_t delay = 0;
-		uint16_t level = 0;
-		time_t now = time(NULL);
-		time_t captured_at = time(NULL) - 2 * 24 * 60 * 60;
-		while (captured_at < now) {
-			buffer_t buffer = {
-					.delay = delay,
-					.level = level,
-					.captured_at = captured_at,
-					.device_id = &device_ids[index],
-			};
+int seed_flush(seed_file_t *seed_file) {
+	if (seed_file->chunk_len == 0) {
+		return 0;
+	}
 
-			if (buffer_insert(db, &buffer) != 0) {
-				return -1;
-			}
-			bool increase = rand() % 128 == 0;
-			bool decrease = rand() % 8 != 0;
-			if (increase) {
-				uint16_t value = (uint16_t)(rand() % 3600);
-				delay += (uint32_t)value;
-				level += (uint16_t)value / 60;
+	if (octet_bulk_write(&seed_file->stmt, seed_file->file, seed_file->offset, seed_file->chunk, seed_file->chunk_len) == -1) {
+		return -1;
+	}
+
+	seed_file->offset += (off_t)seed_file->chunk_len;
+	seed_file->chunk_len = 0;
+	return 0;
+}
+
+uint8_t *seed_row(seed_file_t *seed_file, uint8_t row_size) {
+	if (seed_file->chunk_len + row_size > seed_chunk && seed_flush(seed_file) == -1) {
+		return NULL;
+	}
+
+	uint8_t *row = &seed_file->chunk[seed_file->chunk_len];
+	memset(row, 0, row_size);
+	seed_file->chunk_len += row_size;
+	return row;
+}
+
+int seed_close(seed_file_t *seed_file) {
+	int status = seed_flush(seed_file);
+	octet_close(&seed_file->stmt, seed_file->file);
+	return status;
+}
+
+time_t seed_step(seed_job_t *job) {
+	return (time_t)(seed_cadence - seed_cadence / 16 + rand_r(&job->rand_state) % (seed_cadence / 8 + 1));
+}
+
+int seed_reading(octet_t *db, seed_job_t *job, uint8_t *chunk) {
+	seed_file_t seed_file;
+	if (seed_open(db, &seed_file, job->device_id, reading_file, chunk) == -1) {
+		return -1;
+	}
+
+	float temperature = (float)(rand_r(&job->rand_state) % 6000) / 100 - 20;
+	float humidity = (float)(rand_r(&job->rand_state) % 10000) / 100;
+	time_t captured_at = seed_from;
+	while (captured_at < seed_to) {
+		uint8_t *row = seed_row(&seed_file, reading_row.size);
+		if (row == NULL) {
+			seed_close(&seed_file);
+			return -1;
+		}
+		octet_int16_write(row, reading_row.temperature, (int16_t)(temperature * 100));
+		octet_uint16_write(row, reading_row.humidity, (uint16_t)(humidity * 100));
+		octet_uint64_write(row, reading_row.captured_at, (uint64_t)captured_at);
+		job->reading = (reading_t){
+				.temperature = temperature,
+				.humidity = humidity,
+				.captured_at = captured_at,
+				.device_id = job->device_id,
+		};
+
+		temperature += ((float)rand_r(&job->rand_state) / (float)RAND_MAX) * 2.0f - 1.0f;
+		if (temperature < -20) {
+			temperature += 1;
+		}
+		if (temperature > 40) {
+			temperature -= 1;
+		}
+		humidity += ((float)rand_r(&job->rand_state) / (float)RAND_MAX) * 2.0f - 1.0f;
+		if (humidity < 0) {
+			humidity += 1;
+		}
+		if (humidity > 100) {
+			humidity -= 1;
+		}
+		captured_at += seed_step(job);
+	}
+
+	return seed_close(&seed_file);
+}
+
+int seed_metric(octet_t *db, seed_job_t *job, uint8_t *chunk) {
+	seed_file_t seed_file;
+	if (seed_open(db, &seed_file, job->device_id, metric_file, chunk) == -1) {
+		return -1;
+	}
+
+	float photovoltaic = (float)(rand_r(&job->rand_state) % 5000) / 1000;
+	float battery = (float)(rand_r(&job->rand_state) % 1000) / 1000 + 3.2f;
+	time_t captured_at = seed_from;
+	while (captured_at < seed_to) {
+		uint8_t *row = seed_row(&seed_file, metric_row.size);
+		if (row == NULL) {
+			seed_close(&seed_file);
+			return -1;
+		}
+		octet_uint16_write(row, metric_row.photovoltaic, (uint16_t)(photovoltaic * 1000));
+		octet_uint16_write(row, metric_row.battery, (uint16_t)(battery * 1000));
+		octet_uint64_write(row, metric_row.captured_at, (uint64_t)captured_at);
+		job->metric = (metric_t){
+				.photovoltaic = photovoltaic,
+				.battery = battery,
+				.captured_at = captured_at,
+				.device_id = job->device_id,
+		};
+
+		photovoltaic += ((float)rand_r(&job->rand_state) / (float)RAND_MAX) * 0.2f - 0.1f;
+		if (photovoltaic < 0) {
+			photovoltaic += 0.1f;
+		}
+		if (photovoltaic > 5) {
+			photovoltaic -= 0.1f;
+		}
+		battery += ((float)rand_r(&job->rand_state) / (float)RAND_MAX) * 0.2f - 0.1f;
+		if (battery < 3.2) {
+			battery += 0.1f;
+		}
+		if (battery > 4.2) {
+			battery -= 0.1f;
+		}
+		captured_at += seed_step(job);
+	}
+
+	return seed_close(&seed_file);
+}
+
+int seed_buffer(octet_t *db, seed_job_t *job, uint8_t *chunk) {
+	seed_file_t seed_file;
+	if (seed_open(db, &seed_file, job->device_id, buffer_file, chunk) == -1) {
+		return -1;
+	}
+
+	uint32_t delay = 0;
+	uint16_t level = 0;
+	time_t captured_at = seed_from;
+	while (captured_at < seed_to) {
+		uint8_t *row = seed_row(&seed_file, buffer_row.size);
+		if (row == NULL) {
+			seed_close(&seed_file);
+			return -1;
+		}
+		octet_uint32_write(row, buffer_row.delay, delay);
+		octet_uint16_write(row, buffer_row.level, level);
+		octet_uint64_write(row, buffer_row.captured_at, (uint64_t)captured_at);
+		job->buffer = (buffer_t){
+				.delay = delay,
+				.level = level,
+				.captured_at = captured_at,
+				.device_id = job->device_id,
+		};
+
+		bool increase = rand_r(&job->rand_state) % 128 == 0;
+		bool decrease = rand_r(&job->rand_state) % 8 != 0;
+		if (increase) {
+			uint16_t value = (uint16_t)(rand_r(&job->rand_state) % 3600);
+			delay += (uint32_t)value;
+			level += (uint16_t)value / 60;
+		}
+		if (decrease) {
+			uint16_t value = (uint16_t)(rand_r(&job->rand_state) % 120);
+			uint32_t delay_sub = (uint32_t)value + 1;
+			if (delay_sub < delay) {
+				delay -= delay_sub;
+			} else {
+				delay = 0;
 			}
-			if (decrease) {
-				uint16_t value = (uint16_t)(rand() % 120);
-				uint32_t delay_sub = (uint32_t)value + 1;
-				if (delay_sub < delay) {
-					delay -= delay_sub;
-				} else {
-					delay = 0;
-				}
-				uint16_t level_sub = (uint16_t)value / 60 + 1;
-				if (level_sub < level) {
-					level -= level_sub;
-				} else {
-					level = 0;
-				}
+			uint16_t level_sub = (uint16_t)value / 60 + 1;
+			if (level_sub < level) {
+				level -= level_sub;
+			} else {
+				level = 0;
 			}
-			captured_at += 56 + rand() % 8;
 		}
+		captured_at += seed_step(job);
+	}
+
+	return seed_close(&seed_file);
+}
+
+int seed_uplink(octet_t *db, seed_job_t *job, uint8_t *chunk) {
+	seed_file_t seed_file;
+	if (seed_open(db, &seed_file, job->device_id, uplink_file, chunk) == -1) {
+		return -1;
+	}
+
+	uint16_t frame = 0;
+	int16_t rssi = (int16_t)(rand_r(&job->rand_state) % 128 - 157);
+	int8_t snr = (int8_t)(rand_r(&job->rand_state) % 144 - 96);
+	uint8_t sf = (uint8_t)(rand_r(&job->rand_state) % 7 + 6);
+	uint8_t cr = (uint8_t)(rand_r(&job->rand_state) % 4 + 5);
+	bool crc = (bool)(rand_r(&job->rand_state) % 6 != 0);
+	uint8_t tx_power = (uint8_t)(rand_r(&job->rand_state) % 16 + 2);
+	uint8_t preamble_len = (uint8_t)(rand_r(&job->rand_state) % 16 + 6);
+	job->last_frame = frame - 1;
+	time_t received_at = seed_from;
+	while (received_at < seed_to) {
+		uint8_t *row = seed_row(&seed_file, uplink_row.size);
+		if (row == NULL) {
+			seed_close(&seed_file);
+			return -1;
+		}
+		uint8_t data_len = 4 + (uint8_t)(rand_r(&job->rand_state) % 12);
+		for (uint8_t ind = 0; ind < data_len; ind++) {
+			job->uplink_data[ind] = (uint8_t)rand_r(&job->rand_state);
+		}
+		job->uplink = (uplink_t){
+				.frame = frame,
+				.kind = (uint8_t)rand_r(&job->rand_state),
+				.data = job->uplink_data,
+				.data_len = data_len,
+				.airtime = 12 * 16 + (uint16_t)(rand_r(&job->rand_state) % 256),
+				.frequency = (uint32_t)(435625 * 1000 - sf * 200 * 1000),
+				.bandwidth = 125 * 1000,
+				.rssi = rssi,
+				.snr = snr,
+				.sf = sf,
+				.cr = cr,
+				.crc = crc,
+				.tx_power = tx_power,
+				.preamble_len = preamble_len,
+				.received_at = received_at,
+				.device_id = job->device_id,
+		};
+		octet_uint16_write(row, uplink_row.frame, job->uplink.frame);
+		octet_uint8_write(row, uplink_row.kind, job->uplink.kind);
+		octet_uint8_write(row, uplink_row.data_len, job->uplink.data_len);
+		octet_blob_write(row, uplink_row.data, job->uplink.data, job->uplink.data_len);
+		octet_uint16_write(row, uplink_row.airtime, job->uplink.airtime);
+		octet_uint32_write(row, uplink_row.frequency, job->uplink.frequency);
+		octet_uint32_write(row, uplink_row.bandwidth, job->uplink.bandwidth);
+		octet_int16_write(row, uplink_row.rssi, job->uplink.rssi);
+		octet_int8_write(row, uplink_row.snr, job->uplink.snr);
+		octet_uint8_write(row, uplink_row.sf, job->uplink.sf);
+		octet_uint8_write(row, uplink_row.cr, job->uplink.cr);
+		octet_bool_write(row, uplink_row.crc, job->uplink.crc);
+		octet_uint8_write(row, uplink_row.tx_power, job->uplink.tx_power);
+		octet_uint8_write(row, uplink_row.preamble_len, job->uplink.preamble_len);
+		octet_uint64_write(row, uplink_row.received_at, (uint64_t)job->uplink.received_at);
+		airtime_account(&job->airtime, &job->airtime_bucket, &job->uplink);
+		packet_account(&job->packet_rx, &job->packet_lost, &job->packet_bucket, &job->last_frame, &job->uplink);
+		job->last_frame = frame;
+
+		frame += 1;
+		rssi += (int16_t)(rand_r(&job->rand_state) % 5 - 2);
+		if (rssi < -157) {
+			rssi += 10;
+		}
+		if (rssi > -29) {
+			rssi -= 10;
+		}
+		snr += (int8_t)(rand_r(&job->rand_state) % 5 - 2);
+		if (snr < -96) {
+			snr += 10;
+		}
+		if (snr > 48) {
+			snr -= 10;
+		}
+		sf += (uint8_t)(rand_r(&job->rand_state) % 3 - 1);
+		if (sf < 6) {
+			sf += 1;
+		}
+		if (sf > 12) {
+			sf -= 1;
+		}
+		cr += (uint8_t)(rand_r(&job->rand_state) % 3 - 1);
+		if (cr < 5) {
+			cr += 1;
+		}
+		if (cr > 8) {
+			cr -= 1;
+		}
+		tx_power += (uint8_t)(rand_r(&job->rand_state) % 3 - 1);
+		if (tx_power < 2) {
+			tx_power += 1;
+		}
+		if (tx_power > 17) {
+			tx_power -= 1;
+		}
+		preamble_len += (uint8_t)(rand_r(&job->rand_state) % 3 - 1);
+		if (preamble_len < 6) {
+			preamble_len += 1;
+		}
+		if (preamble_len > 21) {
+			preamble_len -= 1;
+		}
+		received_at += seed_step(job);
+	}
+
+	return seed_close(&seed_file);
+}
+
+int seed_downlink(octet_t *db, seed_job_t *job, uint8_t *chunk) {
+	seed_file_t seed_file;
+	if (seed_open(db, &seed_file, job->device_id, downlink_file, chunk) == -1) {
+		return -1;
+	}
+
+	uint16_t frame = 0;
+	uint8_t sf = (uint8_t)(rand_r(&job->rand_state) % 7 + 6);
+	uint8_t cr = (uint8_t)(rand_r(&job->rand_state) % 4 + 5);
+	bool crc = (bool)(rand_r(&job->rand_state) % 6 != 0);
+	uint8_t tx_power = (uint8_t)(rand_r(&job->rand_state) % 16 + 2);
+	uint8_t preamble_len = (uint8_t)(rand_r(&job->rand_state) % 16 + 6);
+	time_t sent_at = seed_from;
+	while (sent_at < seed_to) {
+		uint8_t *row = seed_row(&seed_file, downlink_row.size);
+		if (row == NULL) {
+			seed_close(&seed_file);
+			return -1;
+		}
+		uint8_t data_len = 4 + (uint8_t)(rand_r(&job->rand_state) % 12);
+		for (uint8_t ind = 0; ind < data_len; ind++) {
+			job->downlink_data[ind] = (uint8_t)rand_r(&job->rand_state);
+		}
+		job->downlink = (downlink_t){
+				.frame = frame,
+				.kind = (uint8_t)rand_r(&job->rand_state),
+				.data = job->downlink_data,
+				.data_len = data_len,
+				.airtime = 12 * 16 + (uint16_t)(rand_r(&job->rand_state) % 256),
+				.frequency = (uint32_t)(435625 * 1000 - sf * 200 * 1000),
+				.bandwidth = 125 * 1000,
+				.sf = sf,
+				.cr = cr,
+				.crc = crc,
+				.tx_power = tx_power,
+				.preamble_len = preamble_len,
+				.sent_at = sent_at,
+				.device_id = job->device_id,
+		};
+		octet_uint16_write(row, downlink_row.frame, job->downlink.frame);
+		octet_uint8_write(row, downlink_row.kind, job->downlink.kind);
+		octet_uint8_write(row, downlink_row.data_len, job->downlink.data_len);
+		octet_blob_write(row, downlink_row.data, job->downlink.data, job->downlink.data_len);
+		octet_uint16_write(row, downlink_row.airtime, job->downlink.airtime);
+		octet_uint32_write(row, downlink_row.frequency, job->downlink.frequency);
+		octet_uint32_write(row, downlink_row.bandwidth, job->downlink.bandwidth);
+		octet_uint8_write(row, downlink_row.sf, job->downlink.sf);
+		octet_uint8_write(row, downlink_row.cr, job->downlink.cr);
+		octet_bool_write(row, downlink_row.crc, job->downlink.crc);
+		octet_uint8_write(row, downlink_row.tx_power, job->downlink.tx_power);
+		octet_uint8_write(row, downlink_row.preamble_len, job->downlink.preamble_len);
+		octet_uint64_write(row, downlink_row.sent_at, (uint64_t)job->downlink.sent_at);
+
+		frame += 1;
+		sf += (uint8_t)(rand_r(&job->rand_state) % 3 - 1);
+		if (sf < 6) {
+			sf += 1;
+		}
+		if (sf > 12) {
+			sf -= 1;
+		}
+		cr += (uint8_t)(rand_r(&job->rand_state) % 3 - 1);
+		if (cr < 5) {
+			cr += 1;
+		}
+		if (cr > 8) {
+			cr -= 1;
+		}
+		tx_power += (uint8_t)(rand_r(&job->rand_state) % 3 - 1);
+		if (tx_power < 2) {
+			tx_power += 1;
+		}
+		if (tx_power > 17) {
+			tx_power -= 1;
+		}
+		preamble_len += (uint8_t)(rand_r(&job->rand_state) % 3 - 1);
+		if (preamble_len < 6) {
+			preamble_len += 1;
+		}
+		if (preamble_len > 21) {
+			preamble_len -= 1;
+		}
+		sent_at += seed_step(job);
+	}
+
+	return seed_close(&seed_file);
+}
+
+void *seed_worker(void *arg) {
+	octet_t *db = arg;
+
+	uint8_t *chunk = malloc(seed_chunk);
+	if (chunk == NULL) {
+		error("failed to allocate seed chunk because %s\n", errno_str());
+		return NULL;
+	}
+
+	while (true) {
+		uint16_t index = (uint16_t)atomic_fetch_add_explicit(&seed_jobs_next, 1, memory_order_relaxed);
+		if (index >= device_ids_len) {
+			break;
+		}
+
+		seed_job_t *job = &seed_jobs[index];
+		if (seed_files(db, job->device_id) == -1 || seed_reading(db, job, chunk) == -1 || seed_metric(db, job, chunk) == -1 ||
+				seed_buffer(db, job, chunk) == -1 || seed_uplink(db, job, chunk) == -1 || seed_downlink(db, job, chunk) == -1) {
+			error("failed to seed series for device %02x%02x\n", (*job->device_id)[0], (*job->device_id)[1]);
+			continue;
+		}
+		job->status = 0;
+	}
+
+	free(chunk);
+	return NULL;
+}
+
+int seed_series(octet_t *db) {
+	int status = -1;
+
+	seed_jobs = calloc(device_ids_len, sizeof(*seed_jobs));
+	if (seed_jobs == NULL) {
+		error("failed to allocate seed jobs because %s\n", errno_str());
+		return -1;
+	}
+
+	seed_to = time(NULL);
+	seed_from = seed_to - seed_days * 24 * 60 * 60;
+	for (uint16_t index = 0; index < device_ids_len; index++) {
+		seed_jobs[index].device_id = &device_ids[index];
+		seed_jobs[index].rand_state = (unsigned int)rand();
+		seed_jobs[index].status = -1;
+	}
+
+	long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+	uint8_t workers_len = cpus < 1 ? 1 : cpus > 16 ? 16 : (uint8_t)cpus;
+	if (workers_len > device_ids_len) {
+		workers_len = (uint8_t)device_ids_len;
+	}
+
+	info("seeding %hu devices over %hu days every %hu seconds with %hhu workers\n", device_ids_len, seed_days, seed_cadence,
+			 workers_len);
+
+	pthread_t workers[16];
+	uint8_t workers_started = 0;
+	atomic_store_explicit(&seed_jobs_next, 0, memory_order_relaxed);
+	for (uint8_t index = 0; index < workers_len; index++) {
+		if ((errno = pthread_create(&workers[index], NULL, &seed_worker, (void *)db)) != 0) {
+			error("failed to create seed worker because %s\n", errno_str());
+			break;
+		}
+		workers_started++;
+	}
+	if (workers_started == 0) {
+		goto cleanup;
+	}
+	for (uint8_t index = 0; index < workers_started; index++) {
+		pthread_join(workers[index], NULL);
+	}
+
+	for (uint16_t index = 0; index < device_ids_len; index++) {
+		seed_job_t *job = &seed_jobs[index];
+		if (job->status != 0) {
+			goto cleanup;
+		}
+
+		uint8_t *row = seed_catalog_find(job->device_id);
+		if (row == NULL) {
+			error("device %02x%02x missing from catalog\n", (*job->device_id)[0], (*job->device_id)[1]);
+			goto cleanup;
+		}
+
+		uint8_t zone_id[8];
+		device_t device = {
+				.id = job->device_id,
+				.zone_id = &zone_id,
+				.reading = &job->reading,
+				.metric = &job->metric,
+				.buffer = &job->buffer,
+				.uplink = NULL,
+				.downlink = &job->downlink,
+		};
+		device_latest(row, &device);
+
+		octet_blob_write(row, device_row.airtime, (uint8_t *)job->airtime, sizeof(job->airtime));
+		octet_uint64_write(row, device_row.airtime_bucket, (uint64_t)job->airtime_bucket);
+		octet_blob_write(row, device_row.packet_rx, job->packet_rx, sizeof(job->packet_rx));
+		octet_blob_write(row, device_row.packet_lost, job->packet_lost, sizeof(job->packet_lost));
+		octet_uint64_write(row, device_row.packet_bucket, (uint64_t)job->packet_bucket);
+		octet_uint8_write(row, device_row.uplink_null, 0x01);
+		octet_uint16_write(row, device_row.uplink_frame, job->uplink.frame);
+		octet_uint8_write(row, device_row.uplink_kind, job->uplink.kind);
+		octet_int16_write(row, device_row.uplink_rssi, job->uplink.rssi);
+		octet_int8_write(row, device_row.uplink_snr, job->uplink.snr);
+		octet_uint8_write(row, device_row.uplink_sf, job->uplink.sf);
+		octet_uint64_write(row, device_row.uplink_received_at, (uint64_t)job->uplink.received_at);
+	}
+
+	if (seed_catalog(db, NULL, 0) == -1) {
+		goto cleanup;
 	}
 
+	for (uint8_t index = 0; index < zone_ids_len; index++) {
+		zone_t zone = {.id = &zone_ids[index]};
+		if (zone_update_latest(db, &zone) != 0) {
+			goto cleanup;
+		}
+	}
+
+	info("seeded file %s\n", reading_file);
+	info("seeded file %s\n", metric_file);
 	info("seeded file %s\n", buffer_file);
-	return 0;
+	info("seeded file %s\n", uplink_file);
+	info("seeded file %s\n", downlink_file);
+	status = 0;
+
+cleanup:
+	free(seed_jobs);
+	return status;
 }
 
 int seed_config(octet_t *db) {
 	uint8_t uplink_ind = 0;
 
 	time_t captured_at = time(NULL);
-	for (uint8_t index = 0; index < device_ids_len; index++) {
+	for (uint16_t index = 0; index < device_ids_len; index++) {
 		config_t config = {
 				.led_debug = uplink_ind % 4 == 0,
 				.reading_enable = uplink_ind % 8 != 0,
@@ -408,7 +996,7 @@ int seed_config(octet_t *db) {
 
 int seed_radio(octet_t *db) {
 	time_t captured_at = time(NULL);
-	for (uint8_t index = 0; index < device_ids_len; index++) {
+	for (uint16_t index = 0; index < device_ids_len; index++) {
 		radio_t radio = {
 				.frequency = (uint32_t)(433225000 + (rand() % 7) * 200000),
 				.bandwidth = (uint32_t)(62500 + (rand() % 4) * 62500),
@@ -435,7 +1023,7 @@ int seed_radio(octet_t *db) {
 
 int seed_alert(octet_t *db) {
 	time_t issued_at = time(NULL);
-	for (uint8_t index = 0; index < device_ids_len; index++) {
+	for (uint16_t index = 0; index < device_ids_len; index++) {
 		alert_t alert = {
 				.severity = (uint8_t)(rand() % 3),
 				.field = (uint8_t)(rand() % 7),
@@ -458,7 +1046,7 @@ int seed_alert(octet_t *db) {
 }
 
 int seed_rule(octet_t *db) {
-	for (uint8_t index = 0; index < device_ids_len; index++) {
+	for (uint16_t index = 0; index < device_ids_len; index++) {
 		time_t now = time(NULL);
 		time_t created_at = time(NULL) - 5 * 60;
 		while (created_at < now) {
@@ -485,170 +1073,6 @@ int seed_rule(octet_t *db) {
 	return 0;
 }
 
-int seed_uplink(octet_t *db) {
-	for (uint8_t index = 0; index < device_ids_len; index++) {
-		uint16_t frame = 0;
-		int16_t rssi = (int16_t)(rand() % 128 - 157);
-		int8_t snr = (int8_t)(rand() % 144 - 96);
-		uint8_t sf = (uint8_t)(rand() % 7 + 6);
-		uint8_t cr = (uint8_t)(rand() % 4 + 5);
-		bool crc = (bool)(rand() % 6 != 0);
-		uint8_t tx_power = (uint8_t)(rand() % 16 + 2);
-		uint8_t preamble_len = (uint8_t)(rand() % 16 + 6);
-		time_t now = time(NULL);
-		time_t received_at = time(NULL) - 2 * 24 * 60 * 60;
-		while (received_at < now) {
-			uint8_t data[16];
-			uint8_t data_len = 4 + (uint8_t)(rand() % 12);
-			for (uint8_t ind = 0; ind < data_len; ind++) {
-				data[ind] = (uint8_t)rand();
-			}
-			uplink_t uplink = {
-					.frame = frame,
-					.kind = (uint8_t)rand(),
-					.data = data,
-					.data_len = data_len,
-					.airtime = 12 * 16 + (uint16_t)(rand() % 256),
-					.frequency = (uint32_t)(435625 * 1000 - sf * 200 * 1000),
-					.bandwidth = 125 * 1000,
-					.rssi = rssi,
-					.snr = snr,
-					.sf = sf,
-					.cr = cr,
-					.crc = crc,
-					.tx_power = tx_power,
-					.preamble_len = preamble_len,
-					.received_at = received_at,
-					.device_id = &device_ids[index],
-			};
-
-			if (uplink_insert(db, &uplink) != 0) {
-				return -1;
-			}
-			frame += 1;
-			rssi += (int16_t)(rand() % 5 - 2);
-			if (rssi < -157) {
-				rssi += 10;
-			}
-			if (rssi > -29) {
-				rssi -= 10;
-			}
-			snr += (int8_t)(rand() % 5 - 2);
-			if (snr < -96) {
-				snr += 10;
-			}
-			if (snr > 48) {
-				snr -= 10;
-			}
-			sf += (uint8_t)(rand() % 3 - 1);
-			if (sf < 6) {
-				sf += 1;
-			}
-			if (sf > 12) {
-				sf -= 1;
-			}
-			cr += (uint8_t)(rand() % 3 - 1);
-			if (cr < 5) {
-				cr += 1;
-			}
-			if (cr > 8) {
-				cr -= 1;
-			}
-			tx_power += (uint8_t)(rand() % 3 - 1);
-			if (tx_power < 2) {
-				tx_power += 1;
-			}
-			if (tx_power > 17) {
-				tx_power -= 1;
-			}
-			preamble_len += (uint8_t)(rand() % 3 - 1);
-			if (preamble_len < 6) {
-				preamble_len += 1;
-			}
-			if (preamble_len > 21) {
-				preamble_len -= 1;
-			}
-			received_at += 56 + rand() % 8;
-		}
-	}
-
-	info("seeded file %s\n", uplink_file);
-	return 0;
-}
-
-int seed_downlink(octet_t *db) {
-	for (uint8_t index = 0; index < device_ids_len; index++) {
-		uint16_t frame = 0;
-		uint8_t sf = (uint8_t)(rand() % 7 + 6);
-		uint8_t cr = (uint8_t)(rand() % 4 + 5);
-		bool crc = (bool)(rand() % 6 != 0);
-		uint8_t tx_power = (uint8_t)(rand() % 16 + 2);
-		uint8_t preamble_len = (uint8_t)(rand() % 16 + 6);
-		time_t now = time(NULL);
-		time_t sent_at = time(NULL) - 2 * 24 * 60 * 60;
-		while (sent_at < now) {
-			uint8_t data[16];
-			uint8_t data_len = 4 + (uint8_t)(rand() % 12);
-			for (uint8_t ind = 0; ind < data_len; ind++) {
-				data[ind] = (uint8_t)rand();
-			}
-			downlink_t downlink = {
-					.frame = frame,
-					.kind = (uint8_t)rand(),
-					.data = data,
-					.data_len = data_len,
-					.airtime = 12 * 16 + (uint16_t)(rand() % 256),
-					.frequency = (uint32_t)(435625 * 1000 - sf * 200 * 1000),
-					.bandwidth = 125 * 1000,
-					.sf = sf,
-					.cr = cr,
-					.crc = crc,
-					.tx_power = tx_power,
-					.preamble_len = preamble_len,
-					.sent_at = sent_at,
-					.device_id = &device_ids[index],
-			};
-
-			if (downlink_insert(db, &downlink) != 0) {
-				return -1;
-			}
-			frame += 1;
-			sf += (uint8_t)(rand() % 3 - 1);
-			if (sf < 6) {
-				sf += 1;
-			}
-			if (sf > 12) {
-				sf -= 1;
-			}
-			cr += (uint8_t)(rand() % 3 - 1);
-			if (cr < 5) {
-				cr += 1;
-			}
-			if (cr > 8) {
-				cr -= 1;
-			}
-			tx_power += (uint8_t)(rand() % 3 - 1);
-			if (tx_power < 2) {
-				tx_power += 1;
-			}
-			if (tx_power > 17) {
-				tx_power -= 1;
-			}
-			preamble_len += (uint8_t)(rand() % 3 - 1);
-			if (preamble_len < 6) {
-				preamble_len += 1;
-			}
-			if (preamble_len > 21) {
-				preamble_len -= 1;
-			}
-			sent_at += 56 + rand() % 8;
-		}
-	}
-
-	info("seeded file %s\n", downlink_file);
-	return 0;
-}
-
 int seed(octet_t *db) {
 	if (seed_user(db) == -1) {
 		return -1;
@@ -671,13 +1095,7 @@ int seed(octet_t *db) {
 	if (seed_email(db) == -1) {
 		return -1;
 	}
-	if (seed_reading(db) == -1) {
-		return -1;
-	}
-	if (seed_metric(db) == -1) {
-		return -1;
-	}
-	if (seed_buffer(db) == -1) {
+	if (seed_series(db) == -1) {
 		return -1;
 	}
 	if (seed_config(db) == -1) {
@@ -692,16 +1110,13 @@ int seed(octet_t *db) {
 	if (seed_rule(db) == -1) {
 		return -1;
 	}
-	if (seed_uplink(db) == -1) {
-		return -1;
-	}
-	if (seed_downlink(db) == -1) {
-		return -1;
-	}
 
 	free(user_ids);
 	free(zone_ids);
+	free(zone_names);
+	free(zone_colors);
 	free(device_ids);
+	free(device_rows);
 
 	return 0;
 }
@@ -0,0 +1,231 @@
+#include "stats.h"
+#include "../app/decode.h"
+#include "../lib/config.h"
+#include "../lib/logger.h"
+#include "../lib/stats.h"
+#include "../lib/thread.h"
+#include "router.h"
+#include <stdarg.h>
+#include <stdatomic.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+const double quantiles[] = {0.5, 0.9, 0.99, 0.999};
+const char *status_classes[] = {"1xx", "2xx", "3xx", "4xx", "5xx"};
+
+void stats_write(response_t *response, const char *format, ...) {
+	uint32_t remaining = response->body.cap - response->body.len;
+	va_list args;
+	va_start(args, format);
+	int written = vsnprintf(response->body.ptr + response->body.len, remaining, format, args);
+	va_end(args);
+	if (written > 0) {
+		response->body.len += (uint32_t)written < remaining ? (uint32_t)written : remaining;
+	}
+}
+
+void stats_summary(response_t *response, const char *metric, const char *labels, summary_t *summary) {
+	const char *separator = labels[0] == '\0' ? "" : ",";
+	for (uint8_t index = 0; index < sizeof(quantiles) / sizeof(*quantiles); index++) {
+		stats_write(response, "%s{%s%squantile=\"%g\"} %.6f\n", metric, labels, separator, quantiles[index],
+								(double)summary_quantile(summary, quantiles[index]) / 1000000);
+	}
+	const char *open = labels[0] == '\0' ? "" : "{";
+	const char *close = labels[0] == '\0' ? "" : "}";
+	stats_write(response, "%s_max%s%s%s %.6f\n", metric, open, labels, close, (double)summary->max / 1000000);
+	stats_write(response, "%s_sum%s%s%s %.6f\n", metric, open, labels, close, (double)summary->sum / 1000000);
+	stats_write(response, "%s_count%s%s%s %lu\n", metric, open, labels, close, summary->count);
+}
+
+void stats_find(octet_t *db, request_t *request, response_t *response) {
+	(void)db;
+
+	if (request->search.len != 0) {
+		response->status = 400;
+		return;
+	}
+
+	uint8_t len = (uint8_t)atomic_load_explicit(&shards_len, memory_order_acquire);
+	shard_t *sources[sizeof(shards) / sizeof(*shards) + 1];
+	uint8_t sources_len = 0;
+	if (shard_spill != NULL) {
+		sources[sources_len++] = shard_spill;
+	}
+	for (uint8_t index = 0; index < len; index++) {
+		sources[sources_len++] = shards[index];
+	}
+
+	stats_write(response, "# TYPE warden_requests_total counter\n");
+	for (uint8_t route = 0; route < shard_routes; route++) {
+		const char *method = route == 0 ? "none" : routes[route - 1].method;
+		const char *pathname = route == 0 ? "none" : routes[route - 1].pathname;
+		for (uint8_t status = 0; status < sizeof(status_classes) / sizeof(*status_classes); status++) {
+			uint64_t requests = 0;
+			for (uint8_t index = 0; index < sources_len; index++) {
+				requests += atomic_load_explicit(&sources[index]->routes[route].statuses[status], memory_order_relaxed);
+			}
+			if (requests > 0) {
+				stats_write(response, "warden_requests_total{method=\"%s\",route=\"%s\",status=\"%s\"} %lu\n", method, pathname,
+										status_classes[status], requests);
+			}
+		}
+	}
+
+	summary_t summary;
+	char labels[160];
+
+	stats_write(response, "# TYPE warden_request_duration_seconds summary\n");
+	for (uint8_t route = 0; route < shard_routes; route++) {
+		memset(&summary, 0, sizeof(summary));
+		for (uint8_t index = 0; index < sources_len; index++) {
+			summary_merge(&summary, &sources[index]->routes[route].latency);
+		}
+		if (summary.count == 0) {
+			continue;
+		}
+		const char *method = route == 0 ? "none" : routes[route - 1].method;
+		const char *pathname = route == 0 ? "none" : routes[route - 1].pathname;
+		snprintf(labels, sizeof(labels), "method=\"%s\",route=\"%s\"", method, pathname);
+		stats_summary(response, "warden_request_duration_seconds", labels, &summary);
+	}
+
+	stats_write(response, "# TYPE warden_queue_depth gauge\n");
+	stats_write(response, "warden_queue_depth %u\n", (uint8_t)atomic_load_explicit(&queue.size, memory_order_relaxed));
+	stats_write(response, "# TYPE warden_queue_capacity gauge\n");
+	stats_write(response, "warden_queue_capacity %hhu\n", queue_size);
+
+	memset(&summary, 0, sizeof(summary));
+	for (uint8_t index = 0; index < sources_len; index++) {
+		summary_merge(&summary, &sources[index]->queue_wait);
+	}
+	stats_write(response, "# TYPE warden_queue_wait_seconds summary\n");
+	stats_summary(response, "warden_queue_wait_seconds", "", &summary);
+
+	stats_write(response, "# TYPE warden_pool_size gauge\n");
+	stats_write(response, "warden_pool_size %u\n", (uint8_t)atomic_load_explicit(&thread_pool.size, memory_order_relaxed));
+	stats_write(response, "# TYPE warden_pool_spawned gauge\n");
+	stats_write(response, "warden_pool_spawned %u\n", (uint8_t)atomic_load_explicit(&thread_pool.spawned, memory_order_relaxed));
+	stats_write(response, "# TYPE warden_pool_load gauge\n");
+	stats_write(response, "warden_pool_load %u\n", (uint8_t)atomic_load_explicit(&thread_pool.load, memory_order_relaxed));
+	stats_write(response, "# TYPE warden_pool_utilization gauge\n");
+	stats_write(response, "warden_pool_utilization %.3f\n", (double)thread_pool.utilization);
+	stats_write(response, "# TYPE warden_pool_delay_seconds gauge\n");
+	stats_write(response, "warden_pool_delay_seconds %.6f\n", (double)thread_pool.delay / 1000000);
+
+	uint64_t device_hits = 0;
+	uint64_t device_misses = 0;
+	uint64_t zone_hits = 0;
+	uint64_t zone_misses = 0;
+	for (uint8_t index = 0; index < sources_len; index++) {
+		device_hits += atomic_load_explicit(&sources[index]->device_hits, memory_order_relaxed);
+		device_misses += atomic_load_explicit(&sources[index]->device_misses, memory_order_relaxed);
+		zone_hits += atomic_load_explicit(&sources[index]->zone_hits, memory_order_relaxed);
+		zone_misses += atomic_load_explicit(&sources[index]->zone_misses, memory_order_relaxed);
+	}
+	stats_write(response, "# TYPE warden_cache_lookups_total counter\n");
+	stats_write(response, "warden_cache_lookups_total{cache=\"device\",result=\"hit\"} %lu\n", device_hits);
+	stats_write(response, "warden_cache_lookups_total{cache=\"device\",result=\"miss\"} %lu\n", device_misses);
+	stats_write(response, "warden_cache_lookups_total{cache=\"zone\",result=\"hit\"} %lu\n", zone_hits);
+	stats_write(response, "warden_cache_lookups_total{cache=\"zone\",result=\"miss\"} %lu\n", zone_misses);
+	stats_write(response, "# TYPE warden_cache_hit_ratio gauge\n");
+	stats_write(response, "warden_cache_hit_ratio{cache=\"device\"} %.3f\n",
+							device_hits + device_misses == 0 ? 0 : (double)device_hits / (double)(device_hits + device_misses));
+	stats_write(response, "warden_cache_hit_ratio{cache=\"zone\"} %.3f\n",
+							zone_hits + zone_misses == 0 ? 0 : (double)zone_hits / (double)(zone_hits + zone_misses));
+
+	stats_write(response, "# TYPE warden_series_read_bytes_total counter\n");
+	for (uint8_t series = 0; series < sizeof(stats_series) / sizeof(*stats_series); series++) {
+		uint64_t bytes = 0;
+		for (uint8_t index = 0; index < sources_len; index++) {
+			bytes += atomic_load_explicit(&sources[index]->series_bytes[series], memory_order_relaxed);
+		}
+		stats_write(response, "warden_series_read_bytes_total{series=\"%s\"} %lu\n", stats_series[series], bytes);
+	}
+
+	memset(&summary, 0, sizeof(summary));
+	for (uint8_t index = 0; index < sources_len; index++) {
+		summary_merge(&summary, &sources[index]->alerter_cycle);
+	}
+	stats_write(response, "# TYPE warden_alerter_cycle_seconds summary\n");
+	stats_summary(response, "warden_alerter_cycle_seconds", "", &summary);
+
+	stats_write(response, "# TYPE warden_decode_backlog gauge\n");
+	stats_write(response, "warden_decode_backlog %u\n", (uint16_t)atomic_load_explicit(&decode_queue.size, memory_order_relaxed));
+	stats_write(response, "# TYPE warden_decode_capacity gauge\n");
+	stats_write(response, "warden_decode_capacity %hu\n", decode_backlog);
+
+	memset(&summary, 0, sizeof(summary));
+	for (uint8_t index = 0; index < sources_len; index++) {
+		summary_merge(&summary, &sources[index]->decode_lag);
+	}
+	stats_write(response, "# TYPE warden_decode_lag_seconds summary\n");
+	stats_summary(response, "warden_decode_lag_seconds", "", &summary);
+
+	stats_write(response, "# TYPE warden_lock_wait_seconds summary\n");
+	for (uint8_t lock = 0; lock < sizeof(stats_locks) / sizeof(*stats_locks); lock++) {
+		memset(&summary, 0, sizeof(summary));
+		for (uint8_t index = 0; index < sources_len; index++) {
+			summary_merge(&summary, &sources[index]->locks[lock]);
+		}
+		const char *space = strchr(stats_locks[lock], ' ');
+		snprintf(labels, sizeof(labels), "file=\"%.*s\",lock=\"%s\"", (int)(space - stats_locks[lock]), stats_locks[lock],
+						 space + 1);
+		stats_summary(response, "warden_lock_wait_seconds", labels, &summary);
+	}
+
+	stats_write(response, "# TYPE warden_lock_site_wait_seconds summary\n");
+	for (uint8_t site = 0; site < sizeof(lock_sites) / sizeof(*lock_sites); site++) {
+		const char *site_name = (const char *)atomic_load_explicit(&lock_sites[site], memory_order_acquire);
+		if (site_name == NULL) {
+			continue;
+		}
+		memset(&summary, 0, sizeof(summary));
+		for (uint8_t index = 0; index < sources_len; index++) {
+			summary_merge(&summary, &sources[index]->sites[site]);
+		}
+		snprintf(labels, sizeof(labels), "site=\"%s\"", site_name);
+		stats_summary(response, "warden_lock_site_wait_seconds", labels, &summary);
+	}
+
+	lock_file_t *contended[sizeof(lock_files) / sizeof(*lock_files)];
+	uint8_t contended_len = 0;
+	for (uint8_t index = 0; index < sizeof(lock_files) / sizeof(*lock_files); index++) {
+		if (atomic_load_explicit(&lock_files[index].hash, memory_order_acquire) > 1) {
+			contended[contended_len++] = &lock_files[index];
+		}
+	}
+	for (uint8_t index = 1; index < contended_len; index++) {
+		lock_file_t *lock_file = contended[index];
+		uint64_t wait = atomic_load_explicit(&lock_file->wait, memory_order_relaxed);
+		uint8_t ind = index;
+		while (ind > 0 && atomic_load_explicit(&contended[ind - 1]->wait, memory_order_relaxed) < wait) {
+			contended[ind] = contended[ind - 1];
+			ind--;
+		}
+		contended[ind] = lock_file;
+	}
+	stats_write(response, "# TYPE warden_lock_contended_seconds_total counter\n");
+	for (uint8_t index = 0; index < contended_len && index < 16; index++) {
+		stats_write(response, "warden_lock_contended_seconds_total{file=\"%s\"} %.6f\n", contended[index]->path,
+								(double)atomic_load_explicit(&contended[index]->wait, memory_order_relaxed) / 1000000);
+	}
+	stats_write(response, "# TYPE warden_lock_contended_waits_total counter\n");
+	for (uint8_t index = 0; index < contended_len && index < 16; index++) {
+		stats_write(response, "warden_lock_contended_waits_total{file=\"%s\"} %lu\n", contended[index]->path,
+								atomic_load_explicit(&contended[index]->waits, memory_order_relaxed));
+	}
+	stats_write(response, "# TYPE warden_lock_contended_seconds_max gauge\n");
+	for (uint8_t index = 0; index < contended_len && index < 16; index++) {
+		stats_write(response, "warden_lock_contended_seconds_max{file=\"%s\"} %.6f\n", contended[index]->path,
+								(double)atomic_load_explicit(&contended[index]->max, memory_order_relaxed) / 1000000);
+	}
+	stats_write(response, "# TYPE warden_lock_contended_dropped_total counter\n");
+	stats_write(response, "warden_lock_contended_dropped_total %lu\n",
+							atomic_load_explicit(&lock_files_dropped, memory_order_relaxed));
+
+	header_write(response, "content-type:text/plain; version=0.0.4\r\n");
+	header_write(response, "content-length:%u\r\n", response->body.len);
+	info("found stats of %hhu shards\n", sources_len);
+	response->status = 200;
+}
@@ -0,0 +1,7 @@
+#pragma once
+
+#include "../lib/octet.h"
+#include "../lib/request.h"
+#include "../lib/response.h"
+
+void stats_find(octet_t *db, request_t *request, response_t *response);
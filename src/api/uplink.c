@@ -1,11 +1,15 @@
 #include "uplink.h"
+#include "../app/decode.h"
+#include "../lib/arena.h"
 #include "../lib/base16.h"
 #include "../lib/bwt.h"
+#include "../lib/config.h"
 #include "../lib/endian.h"
 #include "../lib/logger.h"
 #include "../lib/octet.h"
 #include "../lib/request.h"
 #include "../lib/response.h"
+#include "../lib/span.h"
 #include "../lib/strn.h"
 #include "cache.h"
 #include "decode.h"
@@ -21,6 +25,8 @@
 
 const char *uplink_file = "uplink";
 
+const uint16_t uplinks_batch = 256;
+
 const uplink_row_t uplink_row = {
 		.frame = 0,
 		.kind = 2,
@@ -43,24 +49,30 @@ const uplink_row_t uplink_row = {
 uint16_t uplink_select(octet_t *db, bwt_t *bwt, uplink_query_t *query, response_t *response, uint8_t *uplinks_len) {
 	uint16_t status;
 
-	uint8_t devices_len;
+	uint8_t devices_len = 0;
 	user_t user = {.id = &bwt->id};
-	status = user_device_select_by_user(db, &user, &devices_len);
+	uint8_t *devices;
+	status = user_device_select_by_user(db, &user, &devices, &devices_len);
 	if (status != 0) {
 		return status;
 	}
 
 	debug("select uplinks for user %02x%02x limit %hhu offset %u\n", bwt->id[0], bwt->id[1], query->limit, query->offset);
 
-	char (*uuids)[16] = (char (*)[16])db->alpha;
-	char (*files)[128] = (char (*)[128])db->bravo;
-	off_t *offsets = (off_t *)db->charlie;
-	time_t *received_ats = (time_t *)db->delta;
-	octet_stmt_t *stmts = (octet_stmt_t *)db->echo;
+	char (*uuids)[16] = arena_alloc(&db->arena, devices_len * sizeof(*uuids));
+	char (*files)[128] = arena_alloc(&db->arena, devices_len * sizeof(*files));
+	off_t *offsets = arena_alloc(&db->arena, devices_len * sizeof(*offsets));
+	time_t *received_ats = arena_alloc(&db->arena, devices_len * sizeof(*received_ats));
+	octet_stmt_t *stmts = arena_alloc(&db->arena, devices_len * sizeof(*stmts));
+	uint8_t *table = arena_alloc(&db->arena, devices_len * uplink_row.size);
+	if (uuids == NULL || files == NULL || offsets == NULL || received_ats == NULL || stmts == NULL || table == NULL) {
+		return 500;
+	}
+
 	uint8_t stmts_len = 0;
 	for (uint8_t index = 0; index < devices_len; index++) {
 		uint8_t (*device_id)[8] =
-				(uint8_t (*)[8])octet_blob_read(&db->chunk[index * user_device_row.size], user_device_row.device_id);
+				(uint8_t (*)[8])octet_blob_read(&devices[index * user_device_row.size], user_device_row.device_id);
 
 		if (base16_encode(uuids[index], sizeof(uuids[index]), device_id, sizeof(*device_id)) == -1) {
 			error("failed to encode uuid to base 16\n");
@@ -87,12 +99,12 @@ uint16_t uplink_select(octet_t *db, bwt_t *bwt, uplink_query_t *query, response_
 		if (offsets[index] < 0) {
 			continue;
 		}
-		if (octet_row_read(&stmts[index], files[index], offsets[index], &db->table[index * uplink_row.size], uplink_row.size) ==
+		if (octet_row_read(&stmts[index], files[index], offsets[index], &table[index * uplink_row.size], uplink_row.size) ==
 				-1) {
 			status = octet_error();
 			goto cleanup;
 		}
-		received_ats[index] = (time_t)octet_uint64_read(&db->table[index * uplink_row.size], uplink_row.received_at);
+		received_ats[index] = (time_t)octet_uint64_read(&table[index * uplink_row.size], uplink_row.received_at);
 	}
 
 	while (*uplinks_len < query->limit) {
@@ -111,23 +123,23 @@ uint16_t uplink_select(octet_t *db, bwt_t *bwt, uplink_query_t *query, response_
 		}
 
 		if (query->offset == 0) {
-			uint16_t frame = octet_uint16_read(&db->table[index * uplink_row.size], uplink_row.frame);
-			uint8_t kind = octet_uint8_read(&db->table[index * uplink_row.size], uplink_row.kind);
-			uint8_t data_len = octet_uint8_read(&db->table[index * uplink_row.size], uplink_row.data_len);
-			uint8_t (*data)[32] = (uint8_t (*)[32])octet_blob_read(&db->table[index * uplink_row.size], uplink_row.data);
-			uint16_t airtime = octet_uint16_read(&db->table[index * uplink_row.size], uplink_row.airtime);
-			uint32_t frequency = octet_uint32_read(&db->table[index * uplink_row.size], uplink_row.frequency);
-			uint32_t bandwidth = octet_uint32_read(&db->table[index * uplink_row.size], uplink_row.bandwidth);
-			int16_t rssi = octet_int16_read(&db->table[index * uplink_row.size], uplink_row.rssi);
-			int8_t snr = octet_int8_read(&db->table[index * uplink_row.size], uplink_row.snr);
-			uint8_t sf = octet_uint8_read(&db->table[index * uplink_row.size], uplink_row.sf);
-			uint8_t cr = octet_uint8_read(&db->table[index * uplink_row.size], uplink_row.cr);
-			bool crc = octet_bool_read(&db->table[index * uplink_row.size], uplink_row.crc);
-			uint8_t tx_power = octet_uint8_read(&db->table[index * uplink_row.size], uplink_row.tx_power);
-			uint8_t preamble_len = octet_uint8_read(&db->table[index * uplink_row.size], uplink_row.preamble_len);
-			time_t received_at = (time_t)octet_uint64_read(&db->table[index * uplink_row.size], uplink_row.received_at);
+			uint16_t frame = octet_uint16_read(&table[index * uplink_row.size], uplink_row.frame);
+			uint8_t kind = octet_uint8_read(&table[index * uplink_row.size], uplink_row.kind);
+			uint8_t data_len = octet_uint8_read(&table[index * uplink_row.size], uplink_row.data_len);
+			uint8_t (*data)[32] = (uint8_t (*)[32])octet_blob_read(&table[index * uplink_row.size], uplink_row.data);
+			uint16_t airtime = octet_uint16_read(&table[index * uplink_row.size], uplink_row.airtime);
+			uint32_t frequency = octet_uint32_read(&table[index * uplink_row.size], uplink_row.frequency);
+			uint32_t bandwidth = octet_uint32_read(&table[index * uplink_row.size], uplink_row.bandwidth);
+			int16_t rssi = octet_int16_read(&table[index * uplink_row.size], uplink_row.rssi);
+			int8_t snr = octet_int8_read(&table[index * uplink_row.size], uplink_row.snr);
+			uint8_t sf = octet_uint8_read(&table[index * uplink_row.size], uplink_row.sf);
+			uint8_t cr = octet_uint8_read(&table[index * uplink_row.size], uplink_row.cr);
+			bool crc = octet_bool_read(&table[index * uplink_row.size], uplink_row.crc);
+			uint8_t tx_power = octet_uint8_read(&table[index * uplink_row.size], uplink_row.tx_power);
+			uint8_t preamble_len = octet_uint8_read(&table[index * uplink_row.size], uplink_row.preamble_len);
+			time_t received_at = (time_t)octet_uint64_read(&table[index * uplink_row.size], uplink_row.received_at);
 			uint8_t (*device_id)[8] =
-					(uint8_t (*)[8])octet_blob_read(&db->chunk[index * user_device_row.size], user_device_row.device_id);
+					(uint8_t (*)[8])octet_blob_read(&devices[index * user_device_row.size], user_device_row.device_id);
 			body_write(response, (uint16_t[]){hton16(frame)}, sizeof(frame));
 			body_write(response, &kind, sizeof(kind));
 			body_write(response, &data_len, sizeof(data_len));
@@ -153,12 +165,12 @@ uint16_t uplink_select(octet_t *db, bwt_t *bwt, uplink_query_t *query, response_
 			continue;
 		}
 
-		if (octet_row_read(&stmts[index], files[index], offsets[index], &db->table[index * uplink_row.size], uplink_row.size) ==
+		if (octet_row_read(&stmts[index], files[index], offsets[index], &table[index * uplink_row.size], uplink_row.size) ==
 				-1) {
 			status = octet_error();
 			goto cleanup;
 		}
-		received_ats[index] = (time_t)octet_uint64_read(&db->table[index * uplink_row.size], uplink_row.received_at);
+		received_ats[index] = (time_t)octet_uint64_read(&table[index * uplink_row.size], uplink_row.received_at);
 	}
 
 cleanup:
@@ -336,8 +348,9 @@ uint16_t uplink_signal_select_by_zone(octet_t *db, zone_t *zone, uplink_signal_q
 																			uint16_t *signals_len) {
 	uint16_t status;
 
-	uint8_t devices_len;
-	status = device_select_by_zone(db, zone, &devices_len);
+	uint8_t devices_len = 0;
+	uint8_t *devices;
+	status = device_select_by_zone(db, zone, &devices, &devices_len);
 	if (status != 0) {
 		return status;
 	}
@@ -349,7 +362,7 @@ uint16_t uplink_signal_select_by_zone(octet_t *db, zone_t *zone, uplink_signal_q
 	char file[128];
 	octet_stmt_t stmt;
 	for (uint8_t index = 0; index < devices_len; index++) {
-		uint8_t (*device_id)[8] = (uint8_t (*)[8])octet_blob_read(&db->chunk[index * device_row.size], device_row.id);
+		uint8_t (*device_id)[8] = (uint8_t (*)[8])octet_blob_read(&devices[index * device_row.size], device_row.id);
 
 		if (base16_encode(uuid, sizeof(uuid), device_id, sizeof(*device_id)) == -1) {
 			error("failed to encode uuid to base 16\n");
@@ -449,9 +462,7 @@ uint16_t uplink_signal_select_by_zone(octet_t *db, zone_t *zone, uplink_signal_q
 	return status;
 }
 
-int uplink_parse(uplink_t *uplink, request_t *request) {
-	request->body.pos = 0;
-
+int uplink_read(uplink_t *uplink, request_t *request) {
 	if (request->body.len < request->body.pos + sizeof(uplink->frame)) {
 		debug("missing frame on uplink\n");
 		return -1;
@@ -554,6 +565,16 @@ int uplink_parse(uplink_t *uplink, request_t *request) {
 	}
 	uplink->device_id = (uint8_t (*)[8])body_read(request, sizeof(*uplink->device_id));
 
+	return 0;
+}
+
+int uplink_parse(uplink_t *uplink, request_t *request) {
+	request->body.pos = 0;
+
+	if (uplink_read(uplink, request) == -1) {
+		return -1;
+	}
+
 	if (request->body.len != request->body.pos) {
 		debug("body len %u does not match body pos %u\n", request->body.len, request->body.pos);
 		return -1;
@@ -616,7 +637,7 @@ int uplink_validate(uplink_t *uplink) {
 	return 0;
 }
 
-uint16_t uplink_insert(octet_t *db, uplink_t *uplink) {
+uint16_t uplink_append(octet_t *db, uplink_t *uplink) {
 	uint16_t status;
 
 	char uuid[16];
@@ -678,21 +699,6 @@ uint16_t uplink_insert(octet_t *db, uplink_t *uplink) {
 		goto cleanup;
 	}
 
-	uint8_t zone_id[8];
-	device_t device = {
-			.id = uplink->device_id,
-			.zone_id = &zone_id,
-			.reading = NULL,
-			.metric = NULL,
-			.buffer = NULL,
-			.uplink = uplink,
-			.downlink = NULL,
-	};
-	status = device_update_latest(db, &device);
-	if (status != 0) {
-		goto cleanup;
-	}
-
 	status = 0;
 
 cleanup:
@@ -737,6 +743,7 @@ void uplink_find(octet_t *db, bwt_t *bwt, request_t *request, response_t *respon
 
 	header_write(response, "content-type:application/octet-stream\r\n");
 	header_write(response, "content-length:%u\r\n", response->body.len);
+	span.emitted = uplinks_len;
 	info("found %hhu uplinks\n", uplinks_len);
 	response->status = 200;
 }
@@ -814,6 +821,7 @@ void uplink_find_by_device(octet_t *db, bwt_t *bwt, request_t *request, response
 	}
 	header_write(response, "content-type:application/octet-stream\r\n");
 	header_write(response, "content-length:%u\r\n", response->body.len);
+	span.emitted = uplinks_len;
 	info("found %hu uplinks\n", uplinks_len);
 	response->status = 200;
 }
@@ -901,6 +909,7 @@ void uplink_signal_find_by_device(octet_t *db, bwt_t *bwt, request_t *request, r
 	}
 	header_write(response, "content-type:application/octet-stream\r\n");
 	header_write(response, "content-length:%u\r\n", response->body.len);
+	span.emitted = signals_len;
 	info("found %hu signals\n", signals_len);
 	response->status = 200;
 }
@@ -985,6 +994,7 @@ void uplink_signal_find_by_zone(octet_t *db, bwt_t *bwt, request_t *request, res
 	}
 	header_write(response, "content-type:application/octet-stream\r\n");
 	header_write(response, "content-length:%u\r\n", response->body.len);
+	span.emitted = signals_len;
 	info("found %hu signals\n", signals_len);
 	response->status = 200;
 }
@@ -1001,13 +1011,41 @@ void uplink_create(octet_t *db, request_t *request, response_t *response) {
 		return;
 	}
 
-	uint16_t status = uplink_insert(db, &uplink);
-	if (status != 0) {
-		response->status = status;
+	if (defer_decode == true) {
+		ingest_t ingest;
+		if (ingest_init(&ingest, &db->arena, uplink.device_id, 1) == -1) {
+			response->status = 500;
+			return;
+		}
+		int decoded = decode_ingest(&uplink, &ingest);
+
+		if (decoder_stopping() == true) {
+			response->status = 503;
+			return;
+		}
+
+		uint16_t status = uplink_append(db, &uplink);
+		if (status != 0) {
+			response->status = status;
+			return;
+		}
+
+		if (decoder_push(&uplink) == -1) {
+			warn("appended uplink for device %02x%02x without decoding\n", (*uplink.device_id)[0], (*uplink.device_id)[1]);
+		}
+
+		if (decoded == -1) {
+			response->status = 400;
+			return;
+		}
+
+		info("appended uplink for device %02x%02x\n", (*uplink.device_id)[0], (*uplink.device_id)[1]);
+		response->status = 201;
 		return;
 	}
 
-	if ((status = decode(db, &uplink)) != 0) {
+	uint16_t status = decode(db, &uplink);
+	if (status != 0) {
 		response->status = status;
 		return;
 	}
@@ -1015,3 +1053,119 @@ void uplink_create(octet_t *db, request_t *request, response_t *response) {
 	info("created uplink for device %02x%02x\n", (*uplink.device_id)[0], (*uplink.device_id)[1]);
 	response->status = 201;
 }
+
+int uplink_order(uplink_t *alpha, uplink_t *bravo) {
+	int order = memcmp(alpha->device_id, bravo->device_id, sizeof(*alpha->device_id));
+	if (order != 0) {
+		return order;
+	}
+	return (alpha->received_at > bravo->received_at) - (alpha->received_at < bravo->received_at);
+}
+
+void uplink_create_batch(octet_t *db, request_t *request, response_t *response) {
+	if (request->search.len != 0 || request->body.len == 0) {
+		response->status = 400;
+		return;
+	}
+
+	uplink_t *uplinks = arena_alloc(&db->arena, uplinks_batch * sizeof(*uplinks));
+	uint16_t *statuses = arena_alloc(&db->arena, uplinks_batch * sizeof(*statuses));
+	uint16_t *order = arena_alloc(&db->arena, uplinks_batch * sizeof(*order));
+	if (uplinks == NULL || statuses == NULL || order == NULL) {
+		response->status = 500;
+		return;
+	}
+
+	uint16_t uplinks_len = 0;
+	uint16_t order_len = 0;
+	request->body.pos = 0;
+	while (request->body.pos < request->body.len) {
+		if (uplinks_len >= uplinks_batch) {
+			warn("uplinks batch exceeds %hu frames\n", uplinks_batch);
+			response->status = 413;
+			return;
+		}
+		uplink_t *uplink = &uplinks[uplinks_len];
+		if (uplink_read(uplink, request) == -1) {
+			response->status = 400;
+			return;
+		}
+		if (uplink_validate(uplink) == -1) {
+			statuses[uplinks_len] = 400;
+		} else {
+			statuses[uplinks_len] = 201;
+			uint16_t ind = order_len;
+			while (ind > 0 && uplink_order(&uplinks[order[ind - 1]], uplink) > 0) {
+				order[ind] = order[ind - 1];
+				ind--;
+			}
+			order[ind] = uplinks_len;
+			order_len++;
+		}
+		uplinks_len++;
+	}
+
+	if (response->body.len + uplinks_len * sizeof(*statuses) > response->body.cap) {
+		error("uplinks amount %hu exceeds buffer length %u\n", uplinks_len, response->body.cap);
+		response->status = 500;
+		return;
+	}
+
+	uint16_t devices_len = 0;
+	uint16_t start = 0;
+	while (start < order_len) {
+		uint8_t (*device_id)[8] = uplinks[order[start]].device_id;
+		uint16_t end = start + 1;
+		while (end < order_len && memcmp(uplinks[order[end]].device_id, device_id, sizeof(*device_id)) == 0) {
+			end++;
+		}
+
+		ingest_t ingest;
+		if (ingest_init(&ingest, &db->arena, device_id, end - start) == -1) {
+			response->status = 500;
+			return;
+		}
+		for (uint16_t index = start; index < end; index++) {
+			uplink_t *uplink = &uplinks[order[index]];
+			ingest.uplinks[ingest.uplinks_len++] = *uplink;
+			if (decode_ingest(uplink, &ingest) == -1) {
+				statuses[order[index]] = 400;
+			}
+		}
+
+		uint16_t status = ingest_uplinks(db, &ingest);
+		for (uint16_t index = start; status != 0 && index < end; index++) {
+			statuses[order[index]] = status;
+		}
+
+		if (status == 0) {
+			ingest.appended = true;
+			status = ingest_commit(db, &ingest);
+			if (status != 0) {
+				error("failed to derive %hu uplinks for device %02x%02x\n", end - start, (*device_id)[0], (*device_id)[1]);
+			}
+			for (uint16_t index = start; status != 0 && index < end; index++) {
+				if (statuses[order[index]] == 201) {
+					statuses[order[index]] = 202;
+				}
+			}
+		}
+
+		devices_len++;
+		start = end;
+	}
+
+	uint16_t created_len = 0;
+	for (uint16_t index = 0; index < uplinks_len; index++) {
+		if (statuses[index] == 201 || statuses[index] == 202) {
+			created_len++;
+		}
+		body_write(response, (uint16_t[]){hton16(statuses[index])}, sizeof(*statuses));
+	}
+
+	header_write(response, "content-type:application/octet-stream\r\n");
+	header_write(response, "content-length:%u\r\n", response->body.len);
+	span.emitted = uplinks_len;
+	info("created %hu uplinks for %hu devices\n", created_len, devices_len);
+	response->status = 200;
+}
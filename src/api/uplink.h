@@ -61,6 +61,7 @@ typedef struct uplink_row_t {
 
 extern const char *uplink_file;
 
+extern const uint16_t uplinks_batch;
 extern const uplink_row_t uplink_row;
 
 uint16_t uplink_select(octet_t *db, bwt_t *bwt, uplink_query_t *query, response_t *response, uint8_t *uplinks_len);
@@ -70,10 +71,12 @@ uint16_t uplink_signal_select_by_device(octet_t *db, device_t *device, uplink_si
 																				uint16_t *signals_len);
 uint16_t uplink_signal_select_by_zone(octet_t *db, zone_t *zone, uplink_signal_query_t *query, response_t *response,
 																			uint16_t *signals_len);
-uint16_t uplink_insert(octet_t *db, uplink_t *uplink);
+uint16_t uplink_append(octet_t *db, uplink_t *uplink);
 
 void uplink_find(octet_t *db, bwt_t *bwt, request_t *request, response_t *response);
 void uplink_find_by_device(octet_t *db, bwt_t *bwt, request_t *request, response_t *response);
 void uplink_signal_find_by_device(octet_t *db, bwt_t *bwt, request_t *request, response_t *response);
 void uplink_signal_find_by_zone(octet_t *db, bwt_t *bwt, request_t *request, response_t *response);
+int uplink_order(uplink_t *alpha, uplink_t *bravo);
 void uplink_create(octet_t *db, request_t *request, response_t *response);
+void uplink_create_batch(octet_t *db, request_t *request, response_t *response);
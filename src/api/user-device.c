@@ -1,4 +1,5 @@
 #include "user-device.h"
+#include "../lib/arena.h"
 #include "../lib/base16.h"
 #include "../lib/logger.h"
 #include "../lib/octet.h"
@@ -66,7 +67,7 @@ cleanup:
 	return status;
 }
 
-uint16_t user_device_select_by_user(octet_t *db, user_t *user, uint8_t *user_devices_len) {
+uint16_t user_device_select_by_user(octet_t *db, user_t *user, uint8_t **user_devices, uint8_t *user_devices_len) {
 	uint16_t status;
 
 	char file[128];
@@ -81,23 +82,29 @@ uint16_t user_device_select_by_user(octet_t *db, user_t *user, uint8_t *user_dev
 		goto cleanup;
 	}
 
+	*user_devices = arena_alloc(&db->arena, (size_t)stmt.stat.st_size);
+	if (*user_devices == NULL) {
+		status = 500;
+		goto cleanup;
+	}
+
 	debug("select user devices for user %02x%02x\n", (*user->id)[0], (*user->id)[1]);
 
 	off_t offset = 0;
-	uint16_t chunk_len = 0;
+	uint32_t user_devices_size = 0;
 	while (true) {
 		if (offset >= stmt.stat.st_size) {
 			status = 0;
 			break;
 		}
-		if (octet_row_read(&stmt, file, offset, &db->chunk[chunk_len], user_device_row.size) == -1) {
+		if (octet_row_read(&stmt, file, offset, &(*user_devices)[user_devices_size], user_device_row.size) == -1) {
 			status = octet_error();
 			goto cleanup;
 		}
-		uint8_t (*user_id)[8] = (uint8_t (*)[8])octet_blob_read(&db->chunk[chunk_len], user_device_row.user_id);
+		uint8_t (*user_id)[8] = (uint8_t (*)[8])octet_blob_read(&(*user_devices)[user_devices_size], user_device_row.user_id);
 		if (memcmp(user_id, user->id, sizeof(*user->id)) == 0) {
 			*user_devices_len += 1;
-			chunk_len += user_device_row.size;
+			user_devices_size += user_device_row.size;
 		}
 		offset += user_device_row.size;
 	}
@@ -22,7 +22,7 @@ extern const char *user_device_file;
 extern const user_device_row_t user_device_row;
 
 uint16_t user_device_existing(octet_t *db, user_device_t *user_device);
-uint16_t user_device_select_by_user(octet_t *db, user_t *user, uint8_t *user_devices_len);
+uint16_t user_device_select_by_user(octet_t *db, user_t *user, uint8_t **user_devices, uint8_t *user_devices_len);
 uint16_t user_device_insert(octet_t *db, user_device_t *user_device);
 uint16_t user_device_delete(octet_t *db, user_device_t *user_device);
 
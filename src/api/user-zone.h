@@ -22,7 +22,7 @@ extern const char *user_zone_file;
 extern const user_zone_row_t user_zone_row;
 
 uint16_t user_zone_existing(octet_t *db, user_zone_t *user_zone);
-uint16_t user_zone_select_by_user(octet_t *db, user_t *user, uint8_t *user_zones_len);
+uint16_t user_zone_select_by_user(octet_t *db, user_t *user, uint8_t **user_zones, uint8_t *user_zones_len);
 uint16_t user_zone_insert(octet_t *db, user_zone_t *user_zone);
 uint16_t user_zone_delete(octet_t *db, user_zone_t *user_zone);
 
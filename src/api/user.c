@@ -1,4 +1,5 @@
 #include "user.h"
+#include "../lib/arena.h"
 #include "../lib/base16.h"
 #include "../lib/bwt.h"
 #include "../lib/config.h"
@@ -8,6 +9,7 @@
 #include "../lib/octet.h"
 #include "../lib/request.h"
 #include "../lib/response.h"
+#include "../lib/span.h"
 #include "../lib/sha256.h"
 #include <fcntl.h>
 #include <stdbool.h>
@@ -133,8 +135,8 @@ uint16_t user_select(octet_t *db, user_query_t *query, response_t *response, uin
 		goto cleanup;
 	}
 
-	if (stmt.stat.st_size > db->table_len) {
-		error("file length %zu exceeds buffer length %u\n", (size_t)stmt.stat.st_size, db->table_len);
+	uint8_t *table = arena_alloc(&db->arena, (size_t)stmt.stat.st_size);
+	if (table == NULL) {
 		status = 500;
 		goto cleanup;
 	}
@@ -148,7 +150,7 @@ uint16_t user_select(octet_t *db, user_query_t *query, response_t *response, uin
 			status = 0;
 			break;
 		}
-		if (octet_row_read(&stmt, file, offset, &db->table[table_len], user_row.size) == -1) {
+		if (octet_row_read(&stmt, file, offset, &table[table_len], user_row.size) == -1) {
 			status = octet_error();
 			goto cleanup;
 		}
@@ -157,12 +159,12 @@ uint16_t user_select(octet_t *db, user_query_t *query, response_t *response, uin
 	}
 
 	if (table_len >= user_row.size * 2) {
-		for (uint8_t index = 0; index < table_len / user_row.size - 1; index++) {
-			for (uint8_t ind = index + 1; ind < table_len / user_row.size; ind++) {
-				if (user_rowcmp(&db->table[index * user_row.size], &db->table[ind * user_row.size], query) > 0) {
-					memcpy(db->row, &db->table[index * user_row.size], user_row.size);
-					memcpy(&db->table[index * user_row.size], &db->table[ind * user_row.size], user_row.size);
-					memcpy(&db->table[ind * user_row.size], db->row, user_row.size);
+		for (uint32_t index = 0; index < table_len / user_row.size - 1; index++) {
+			for (uint32_t ind = index + 1; ind < table_len / user_row.size; ind++) {
+				if (user_rowcmp(&table[index * user_row.size], &table[ind * user_row.size], query) > 0) {
+					memcpy(db->row, &table[index * user_row.size], user_row.size);
+					memcpy(&table[index * user_row.size], &table[ind * user_row.size], user_row.size);
+					memcpy(&table[ind * user_row.size], db->row, user_row.size);
 				}
 			}
 		}
@@ -174,12 +176,12 @@ uint16_t user_select(octet_t *db, user_query_t *query, response_t *response, uin
 			status = 0;
 			break;
 		}
-		uint8_t (*id)[8] = (uint8_t (*)[8])octet_blob_read(&db->table[index], user_row.id);
-		uint8_t username_len = octet_uint8_read(&db->table[index], user_row.username_len);
-		char *username = octet_text_read(&db->table[index], user_row.username);
-		time_t signup_at = (time_t)octet_uint64_read(&db->table[index], user_row.signup_at);
-		time_t signin_at = (time_t)octet_uint64_read(&db->table[index], user_row.signin_at);
-		uint8_t (*permissions)[8] = (uint8_t (*)[8])octet_blob_read(&db->table[index], user_row.permissions);
+		uint8_t (*id)[8] = (uint8_t (*)[8])octet_blob_read(&table[index], user_row.id);
+		uint8_t username_len = octet_uint8_read(&table[index], user_row.username_len);
+		char *username = octet_text_read(&table[index], user_row.username);
+		time_t signup_at = (time_t)octet_uint64_read(&table[index], user_row.signup_at);
+		time_t signin_at = (time_t)octet_uint64_read(&table[index], user_row.signin_at);
+		uint8_t (*permissions)[8] = (uint8_t (*)[8])octet_blob_read(&table[index], user_row.permissions);
 		body_write(response, id, sizeof(*id));
 		body_write(response, username, username_len);
 		body_write(response, (char[]){0x00}, sizeof(char));
@@ -579,6 +581,7 @@ void user_find(octet_t *db, request_t *request, response_t *response) {
 
 	header_write(response, "content-type:application/octet-stream\r\n");
 	header_write(response, "content-length:%u\r\n", response->body.len);
+	span.emitted = users_len;
 	info("found %hhu users\n", users_len);
 	response->status = 200;
 }
@@ -1,4 +1,5 @@
 #include "zone.h"
+#include "../lib/arena.h"
 #include "../lib/base16.h"
 #include "../lib/bwt.h"
 #include "../lib/endian.h"
@@ -6,6 +7,7 @@
 #include "../lib/octet.h"
 #include "../lib/request.h"
 #include "../lib/response.h"
+#include "../lib/span.h"
 #include "cache.h"
 #include "device.h"
 #include "user-zone.h"
@@ -317,7 +319,8 @@ uint16_t zone_select(octet_t *db, bwt_t *bwt, zone_query_t *query, response_t *r
 
 	uint8_t user_zones_len = 0;
 	user_t user = {.id = &bwt->id};
-	status = user_zone_select_by_user(db, &user, &user_zones_len);
+	uint8_t *user_zones;
+	status = user_zone_select_by_user(db, &user, &user_zones, &user_zones_len);
 	if (status != 0) {
 		return status;
 	}
@@ -334,8 +337,8 @@ uint16_t zone_select(octet_t *db, bwt_t *bwt, zone_query_t *query, response_t *r
 		goto cleanup;
 	}
 
-	if (stmt.stat.st_size > db->table_len) {
-		error("file length %zu exceeds buffer length %u\n", (size_t)stmt.stat.st_size, db->table_len);
+	uint8_t *table = arena_alloc(&db->arena, (size_t)stmt.stat.st_size);
+	if (table == NULL) {
 		status = 500;
 		goto cleanup;
 	}
@@ -350,13 +353,13 @@ uint16_t zone_select(octet_t *db, bwt_t *bwt, zone_query_t *query, response_t *r
 			status = 0;
 			break;
 		}
-		if (octet_row_read(&stmt, file, offset, &db->table[table_len], zone_row.size) == -1) {
+		if (octet_row_read(&stmt, file, offset, &table[table_len], zone_row.size) == -1) {
 			status = octet_error();
 			goto cleanup;
 		}
-		uint8_t (*id)[8] = (uint8_t (*)[8])octet_blob_read(&db->table[table_len], zone_row.id);
+		uint8_t (*id)[8] = (uint8_t (*)[8])octet_blob_read(&table[table_len], zone_row.id);
 		for (uint8_t index = 0; index < user_zones_len; index++) {
-			uint8_t (*zone_id)[8] = (uint8_t (*)[8])octet_blob_read(&db->chunk[index * user_zone_row.size], user_zone_row.zone_id);
+			uint8_t (*zone_id)[8] = (uint8_t (*)[8])octet_blob_read(&user_zones[index * user_zone_row.size], user_zone_row.zone_id);
 			if (memcmp(id, zone_id, sizeof(*zone_id)) == 0) {
 				table_len += zone_row.size;
 				break;
@@ -366,12 +369,12 @@ uint16_t zone_select(octet_t *db, bwt_t *bwt, zone_query_t *query, response_t *r
 	}
 
 	if (table_len >= zone_row.size * 2) {
-		for (uint8_t index = 0; index < table_len / zone_row.size - 1; index++) {
-			for (uint8_t ind = index + 1; ind < table_len / zone_row.size; ind++) {
-				if (zone_rowcmp(&db->table[index * zone_row.size], &db->table[ind * zone_row.size], query) > 0) {
-					memcpy(db->row, &db->table[index * zone_row.size], zone_row.size);
-					memcpy(&db->table[index * zone_row.size], &db->table[ind * zone_row.size], zone_row.size);
-					memcpy(&db->table[ind * zone_row.size], db->row, zone_row.size);
+		for (uint32_t index = 0; index < table_len / zone_row.size - 1; index++) {
+			for (uint32_t ind = index + 1; ind < table_len / zone_row.size; ind++) {
+				if (zone_rowcmp(&table[index * zone_row.size], &table[ind * zone_row.size], query) > 0) {
+					memcpy(db->row, &table[index * zone_row.size], zone_row.size);
+					memcpy(&table[index * zone_row.size], &table[ind * zone_row.size], zone_row.size);
+					memcpy(&table[ind * zone_row.size], db->row, zone_row.size);
 				}
 			}
 		}
@@ -383,23 +386,23 @@ uint16_t zone_select(octet_t *db, bwt_t *bwt, zone_query_t *query, response_t *r
 			status = 0;
 			break;
 		}
-		uint8_t (*id)[8] = (uint8_t (*)[8])octet_blob_read(&db->table[index], zone_row.id);
-		uint8_t name_len = octet_uint8_read(&db->table[index], zone_row.name_len);
-		char *name = octet_text_read(&db->table[index], zone_row.name);
-		uint8_t (*color)[12] = (uint8_t (*)[12])octet_blob_read(&db->table[index], zone_row.color);
-		uint8_t reading_null = octet_uint8_read(&db->table[index], zone_row.reading_null);
-		int16_t reading_temperature = octet_int16_read(&db->table[index], zone_row.reading_temperature);
-		uint16_t reading_humidity = octet_uint16_read(&db->table[index], zone_row.reading_humidity);
-		int16_t reading_dewpoint = octet_int16_read(&db->table[index], zone_row.reading_dewpoint);
-		time_t reading_captured_at = (time_t)octet_uint64_read(&db->table[index], zone_row.reading_captured_at);
-		uint8_t metric_null = octet_uint8_read(&db->table[index], zone_row.metric_null);
-		uint16_t metric_photovoltaic = octet_uint16_read(&db->table[index], zone_row.metric_photovoltaic);
-		uint16_t metric_battery = octet_uint16_read(&db->table[index], zone_row.metric_battery);
-		time_t metric_captured_at = (time_t)octet_uint64_read(&db->table[index], zone_row.metric_captured_at);
-		uint8_t buffer_null = octet_uint8_read(&db->table[index], zone_row.buffer_null);
-		uint32_t buffer_delay = octet_uint32_read(&db->table[index], zone_row.buffer_delay);
-		uint16_t buffer_level = octet_uint16_read(&db->table[index], zone_row.buffer_level);
-		time_t buffer_captured_at = (time_t)octet_uint64_read(&db->table[index], zone_row.buffer_captured_at);
+		uint8_t (*id)[8] = (uint8_t (*)[8])octet_blob_read(&table[index], zone_row.id);
+		uint8_t name_len = octet_uint8_read(&table[index], zone_row.name_len);
+		char *name = octet_text_read(&table[index], zone_row.name);
+		uint8_t (*color)[12] = (uint8_t (*)[12])octet_blob_read(&table[index], zone_row.color);
+		uint8_t reading_null = octet_uint8_read(&table[index], zone_row.reading_null);
+		int16_t reading_temperature = octet_int16_read(&table[index], zone_row.reading_temperature);
+		uint16_t reading_humidity = octet_uint16_read(&table[index], zone_row.reading_humidity);
+		int16_t reading_dewpoint = octet_int16_read(&table[index], zone_row.reading_dewpoint);
+		time_t reading_captured_at = (time_t)octet_uint64_read(&table[index], zone_row.reading_captured_at);
+		uint8_t metric_null = octet_uint8_read(&table[index], zone_row.metric_null);
+		uint16_t metric_photovoltaic = octet_uint16_read(&table[index], zone_row.metric_photovoltaic);
+		uint16_t metric_battery = octet_uint16_read(&table[index], zone_row.metric_battery);
+		time_t metric_captured_at = (time_t)octet_uint64_read(&table[index], zone_row.metric_captured_at);
+		uint8_t buffer_null = octet_uint8_read(&table[index], zone_row.buffer_null);
+		uint32_t buffer_delay = octet_uint32_read(&table[index], zone_row.buffer_delay);
+		uint16_t buffer_level = octet_uint16_read(&table[index], zone_row.buffer_level);
+		time_t buffer_captured_at = (time_t)octet_uint64_read(&table[index], zone_row.buffer_captured_at);
 		body_write(response, id, sizeof(*id));
 		body_write(response, name, name_len);
 		body_write(response, (char[]){0x00}, sizeof(char));
@@ -537,7 +540,8 @@ uint16_t zone_select_by_user(octet_t *db, user_t *user, zone_query_t *query, res
 	uint16_t status;
 
 	uint8_t user_zones_len = 0;
-	status = user_zone_select_by_user(db, user, &user_zones_len);
+	uint8_t *user_zones;
+	status = user_zone_select_by_user(db, user, &user_zones, &user_zones_len);
 	if (status != 0) {
 		return status;
 	}
@@ -554,8 +558,8 @@ uint16_t zone_select_by_user(octet_t *db, user_t *user, zone_query_t *query, res
 		goto cleanup;
 	}
 
-	if (stmt.stat.st_size > db->table_len) {
-		error("file length %zu exceeds buffer length %u\n", (size_t)stmt.stat.st_size, db->table_len);
+	uint8_t *table = arena_alloc(&db->arena, (size_t)stmt.stat.st_size);
+	if (table == NULL) {
 		status = 500;
 		goto cleanup;
 	}
@@ -570,13 +574,13 @@ uint16_t zone_select_by_user(octet_t *db, user_t *user, zone_query_t *query, res
 			status = 0;
 			break;
 		}
-		if (octet_row_read(&stmt, file, offset, &db->table[table_len], zone_row.size) == -1) {
+		if (octet_row_read(&stmt, file, offset, &table[table_len], zone_row.size) == -1) {
 			status = octet_error();
 			goto cleanup;
 		}
-		uint8_t (*id)[8] = (uint8_t (*)[8])octet_blob_read(&db->table[table_len], zone_row.id);
+		uint8_t (*id)[8] = (uint8_t (*)[8])octet_blob_read(&table[table_len], zone_row.id);
 		for (uint8_t index = 0; index < user_zones_len; index++) {
-			uint8_t (*zone_id)[8] = (uint8_t (*)[8])octet_blob_read(&db->chunk[index * user_zone_row.size], user_zone_row.zone_id);
+			uint8_t (*zone_id)[8] = (uint8_t (*)[8])octet_blob_read(&user_zones[index * user_zone_row.size], user_zone_row.zone_id);
 			if (memcmp(id, zone_id, sizeof(*zone_id)) == 0) {
 				table_len += zone_row.size;
 				break;
@@ -586,12 +590,12 @@ uint16_t zone_select_by_user(octet_t *db, user_t *user, zone_query_t *query, res
 	}
 
 	if (table_len >= zone_row.size * 2) {
-		for (uint8_t index = 0; index < table_len / zone_row.size - 1; index++) {
-			for (uint8_t ind = index + 1; ind < table_len / zone_row.size; ind++) {
-				if (zone_rowcmp(&db->table[index * zone_row.size], &db->table[ind * zone_row.size], query) > 0) {
-					memcpy(db->row, &db->table[index * zone_row.size], zone_row.size);
-					memcpy(&db->table[index * zone_row.size], &db->table[ind * zone_row.size], zone_row.size);
-					memcpy(&db->table[ind * zone_row.size], db->row, zone_row.size);
+		for (uint32_t index = 0; index < table_len / zone_row.size - 1; index++) {
+			for (uint32_t ind = index + 1; ind < table_len / zone_row.size; ind++) {
+				if (zone_rowcmp(&table[index * zone_row.size], &table[ind * zone_row.size], query) > 0) {
+					memcpy(db->row, &table[index * zone_row.size], zone_row.size);
+					memcpy(&table[index * zone_row.size], &table[ind * zone_row.size], zone_row.size);
+					memcpy(&table[ind * zone_row.size], db->row, zone_row.size);
 				}
 			}
 		}
@@ -603,13 +607,13 @@ uint16_t zone_select_by_user(octet_t *db, user_t *user, zone_query_t *query, res
 			status = 0;
 			break;
 		}
-		uint8_t (*id)[8] = (uint8_t (*)[8])octet_blob_read(&db->table[index], zone_row.id);
-		uint8_t name_len = octet_uint8_read(&db->table[index], zone_row.name_len);
-		char *name = octet_text_read(&db->table[index], zone_row.name);
-		uint8_t (*color)[12] = (uint8_t (*)[12])octet_blob_read(&db->table[index], zone_row.color);
-		time_t created_at = (time_t)octet_uint64_read(&db->table[index], zone_row.created_at);
-		uint8_t updated_at_null = octet_uint8_read(&db->table[index], zone_row.updated_at_null);
-		time_t updated_at = (time_t)octet_uint64_read(&db->table[index], zone_row.updated_at);
+		uint8_t (*id)[8] = (uint8_t (*)[8])octet_blob_read(&table[index], zone_row.id);
+		uint8_t name_len = octet_uint8_read(&table[index], zone_row.name_len);
+		char *name = octet_text_read(&table[index], zone_row.name);
+		uint8_t (*color)[12] = (uint8_t (*)[12])octet_blob_read(&table[index], zone_row.color);
+		time_t created_at = (time_t)octet_uint64_read(&table[index], zone_row.created_at);
+		uint8_t updated_at_null = octet_uint8_read(&table[index], zone_row.updated_at_null);
+		time_t updated_at = (time_t)octet_uint64_read(&table[index], zone_row.updated_at);
 		uint8_t uplink_null = 0x00;
 		body_write(response, id, sizeof(*id));
 		body_write(response, name, name_len);
@@ -968,6 +972,7 @@ void zone_find(octet_t *db, bwt_t *bwt, request_t *request, response_t *response
 
 	header_write(response, "content-type:application/octet-stream\r\n");
 	header_write(response, "content-length:%u\r\n", response->body.len);
+	span.emitted = zones_len;
 	info("found %hhu zones\n", zones_len);
 	response->status = 200;
 }
@@ -1059,6 +1064,7 @@ void zone_find_by_user(octet_t *db, request_t *request, response_t *response) {
 
 	header_write(response, "content-type:application/octet-stream\r\n");
 	header_write(response, "content-length:%u\r\n", response->body.len);
+	span.emitted = zones_len;
 	info("found %hhu zones\n", zones_len);
 	response->status = 200;
 }
@@ -4,10 +4,13 @@
 #include "../api/metric.h"
 #include "../api/reading.h"
 #include "../api/rule.h"
+#include "../lib/arena.h"
 #include "../lib/base16.h"
 #include "../lib/config.h"
 #include "../lib/logger.h"
 #include "../lib/octet.h"
+#include "../lib/stats.h"
+#include "../lib/thread.h"
 #include "email.h"
 #include <fcntl.h>
 #include <pthread.h>
@@ -22,7 +25,7 @@ pthread_t alerter_thread;
 octet_t alerter_octet;
 char *alerter_buffer;
 
-int device_load(octet_t *db, uint8_t *devices_len) {
+int device_load(octet_t *db, uint8_t **devices, uint8_t *devices_len) {
 	int status;
 
 	char file[128];
@@ -37,8 +40,8 @@ int device_load(octet_t *db, uint8_t *devices_len) {
 		goto cleanup;
 	}
 
-	if (stmt.stat.st_size > db->table_len) {
-		error("file length %zu exceeds buffer length %u\n", (size_t)stmt.stat.st_size, db->table_len);
+	*devices = arena_alloc(&db->arena, (size_t)stmt.stat.st_size);
+	if (*devices == NULL) {
 		status = -1;
 		goto cleanup;
 	}
@@ -51,7 +54,7 @@ int device_load(octet_t *db, uint8_t *devices_len) {
 			status = 0;
 			break;
 		}
-		if (octet_row_read(&stmt, file, offset, &db->table[offset], device_row.size) == -1) {
+		if (octet_row_read(&stmt, file, offset, &(*devices)[offset], device_row.size) == -1) {
 			status = -1;
 			goto cleanup;
 		}
@@ -64,7 +67,7 @@ cleanup:
 	return status;
 }
 
-int alert_load_by_device(octet_t *db, device_t *device, uint8_t *alerts_len) {
+int alert_load_by_device(octet_t *db, device_t *device, uint8_t **alerts, uint8_t *alerts_len) {
 	int status;
 
 	char uuid[16];
@@ -85,28 +88,34 @@ int alert_load_by_device(octet_t *db, device_t *device, uint8_t *alerts_len) {
 		goto cleanup;
 	}
 
+	*alerts = arena_alloc(&db->arena, (size_t)stmt.stat.st_size);
+	if (*alerts == NULL) {
+		status = -1;
+		goto cleanup;
+	}
+
 	debug("select alerts for device %02x%02x\n", (*device->id)[0], (*device->id)[1]);
 
 	time_t now = time(NULL);
 	off_t offset = stmt.stat.st_size - alert_row.size;
-	uint16_t alpha_len = 0;
+	uint32_t alerts_size = 0;
 	while (true) {
-		if (offset < 0 || alpha_len + alert_row.size > db->alpha_len) {
+		if (offset < 0) {
 			status = 0;
 			break;
 		}
-		if (octet_row_read(&stmt, file, offset, &db->alpha[alpha_len], alert_row.size) == -1) {
+		if (octet_row_read(&stmt, file, offset, &(*alerts)[alerts_size], alert_row.size) == -1) {
 			status = -1;
 			goto cleanup;
 		}
-		time_t issued_at = (time_t)octet_uint64_read(&db->alpha[alpha_len], alert_row.issued_at);
+		time_t issued_at = (time_t)octet_uint64_read(&(*alerts)[alerts_size], alert_row.issued_at);
 		if (issued_at + alert_lookback < now) {
 			status = 0;
 			break;
 		}
 		*alerts_len += 1;
 		offset -= alert_row.size;
-		alpha_len += alert_row.size;
+		alerts_size += alert_row.size;
 	}
 
 cleanup:
@@ -114,7 +123,7 @@ cleanup:
 	return status;
 }
 
-int rule_load_by_device(octet_t *db, device_t *device, uint8_t *rules_len) {
+int rule_load_by_device(octet_t *db, device_t *device, uint8_t **rules, uint8_t *rules_len) {
 	int status;
 
 	char uuid[16];
@@ -135,8 +144,8 @@ int rule_load_by_device(octet_t *db, device_t *device, uint8_t *rules_len) {
 		goto cleanup;
 	}
 
-	if (stmt.stat.st_size > db->bravo_len) {
-		error("file length %zu exceeds buffer length %u\n", (size_t)stmt.stat.st_size, db->bravo_len);
+	*rules = arena_alloc(&db->arena, (size_t)stmt.stat.st_size);
+	if (*rules == NULL) {
 		status = -1;
 		goto cleanup;
 	}
@@ -149,7 +158,7 @@ int rule_load_by_device(octet_t *db, device_t *device, uint8_t *rules_len) {
 			status = 0;
 			break;
 		}
-		if (octet_row_read(&stmt, file, offset, &db->bravo[offset], rule_row.size) == -1) {
+		if (octet_row_read(&stmt, file, offset, &(*rules)[offset], rule_row.size) == -1) {
 			status = -1;
 			goto cleanup;
 		}
@@ -265,29 +274,20 @@ void *alerter(void *args) {
 
 	db->directory = database_directory;
 
-	uint32_t offset = 0;
-
-	db->row = (uint8_t *)&alerter_buffer[offset];
 	db->row_len = UINT8_MAX;
-	offset += db->row_len;
-
-	db->alpha = (uint8_t *)&alerter_buffer[offset];
-	db->alpha_len = (uint16_t)(database_buffer / 16);
-	offset += db->alpha_len;
-
-	db->bravo = (uint8_t *)&alerter_buffer[offset];
-	db->bravo_len = (uint16_t)(database_buffer / 16);
-	offset += db->bravo_len;
-
-	db->table = (uint8_t *)&alerter_buffer[offset];
-	db->table_len = database_buffer - offset;
-	offset += db->table_len;
+	db->row = (uint8_t *)&alerter_buffer[database_buffer - db->row_len];
+	arena_init(&db->arena, (uint8_t *)alerter_buffer, database_buffer - db->row_len);
 
 	while (true) {
 		trace("alerter thread running thresholds\n");
+		arena_reset(&db->arena);
 
+		struct timespec start;
+		clock_gettime(CLOCK_MONOTONIC, &start);
+
+		uint8_t *devices;
 		uint8_t devices_len = 0;
-		if (device_load(db, &devices_len) == -1) {
+		if (device_load(db, &devices, &devices_len) == -1) {
 			continue;
 		}
 
@@ -299,83 +299,85 @@ void *alerter(void *args) {
 			uplink_t uplink;
 			downlink_t downlink;
 			device_t device;
-			device.id = (uint8_t (*)[8])octet_blob_read(&db->table[index * device_row.size], device_row.id);
-			device.name = octet_text_read(&db->table[index * device_row.size], device_row.name);
-			device.name_len = octet_uint8_read(&db->table[index * device_row.size], device_row.name_len);
-			if (octet_uint8_read(&db->table[index * device_row.size], device_row.reading_null) != 0x00) {
+			device.id = (uint8_t (*)[8])octet_blob_read(&devices[index * device_row.size], device_row.id);
+			device.name = octet_text_read(&devices[index * device_row.size], device_row.name);
+			device.name_len = octet_uint8_read(&devices[index * device_row.size], device_row.name_len);
+			if (octet_uint8_read(&devices[index * device_row.size], device_row.reading_null) != 0x00) {
 				device.reading = &reading;
-				int16_t temperature = octet_int16_read(&db->table[index * device_row.size], device_row.reading_temperature);
-				uint16_t humidity = octet_uint16_read(&db->table[index * device_row.size], device_row.reading_humidity);
-				int16_t dewpoint = octet_int16_read(&db->table[index * device_row.size], device_row.reading_dewpoint);
+				int16_t temperature = octet_int16_read(&devices[index * device_row.size], device_row.reading_temperature);
+				uint16_t humidity = octet_uint16_read(&devices[index * device_row.size], device_row.reading_humidity);
+				int16_t dewpoint = octet_int16_read(&devices[index * device_row.size], device_row.reading_dewpoint);
 				device.reading->temperature = temperature / 100.0f;
 				device.reading->humidity = humidity / 100.0f;
 				device.reading->dewpoint = dewpoint / 100.0f;
 			} else {
 				device.reading = NULL;
 			}
-			if (octet_uint8_read(&db->table[index * device_row.size], device_row.metric_null) != 0x00) {
+			if (octet_uint8_read(&devices[index * device_row.size], device_row.metric_null) != 0x00) {
 				device.metric = &metric;
-				uint16_t photovoltaic = octet_uint16_read(&db->table[index * device_row.size], device_row.metric_photovoltaic);
-				uint16_t battery = octet_uint16_read(&db->table[index * device_row.size], device_row.metric_battery);
+				uint16_t photovoltaic = octet_uint16_read(&devices[index * device_row.size], device_row.metric_photovoltaic);
+				uint16_t battery = octet_uint16_read(&devices[index * device_row.size], device_row.metric_battery);
 				device.metric->photovoltaic = photovoltaic / 1000.0f;
 				device.metric->battery = battery / 1000.0f;
 			} else {
 				device.metric = NULL;
 			}
-			if (octet_uint8_read(&db->table[index * device_row.size], device_row.buffer_null) != 0x00) {
+			if (octet_uint8_read(&devices[index * device_row.size], device_row.buffer_null) != 0x00) {
 				device.buffer = &buffer;
-				device.buffer->delay = octet_uint32_read(&db->table[index * device_row.size], device_row.buffer_delay);
-				device.buffer->level = octet_uint16_read(&db->table[index * device_row.size], device_row.buffer_level);
+				device.buffer->delay = octet_uint32_read(&devices[index * device_row.size], device_row.buffer_delay);
+				device.buffer->level = octet_uint16_read(&devices[index * device_row.size], device_row.buffer_level);
 			} else {
 				device.buffer = NULL;
 			}
-			if (octet_uint8_read(&db->table[index * device_row.size], device_row.uplink_null) != 0x00) {
+			if (octet_uint8_read(&devices[index * device_row.size], device_row.uplink_null) != 0x00) {
 				device.uplink = &uplink;
-				device.uplink->frame = octet_uint16_read(&db->table[index * device_row.size], device_row.uplink_frame);
-				device.uplink->kind = octet_uint8_read(&db->table[index * device_row.size], device_row.uplink_kind);
+				device.uplink->frame = octet_uint16_read(&devices[index * device_row.size], device_row.uplink_frame);
+				device.uplink->kind = octet_uint8_read(&devices[index * device_row.size], device_row.uplink_kind);
 				device.uplink->received_at =
-						(time_t)octet_uint64_read(&db->table[index * device_row.size], device_row.uplink_received_at);
+						(time_t)octet_uint64_read(&devices[index * device_row.size], device_row.uplink_received_at);
 			} else {
 				device.uplink = NULL;
 			}
-			if (octet_uint8_read(&db->table[index * device_row.size], device_row.downlink_null) != 0x00) {
+			if (octet_uint8_read(&devices[index * device_row.size], device_row.downlink_null) != 0x00) {
 				device.downlink = &downlink;
-				device.downlink->frame = octet_uint16_read(&db->table[index * device_row.size], device_row.downlink_frame);
-				device.downlink->kind = octet_uint8_read(&db->table[index * device_row.size], device_row.downlink_kind);
-				device.downlink->sent_at = (time_t)octet_uint64_read(&db->table[index * device_row.size], device_row.downlink_sent_at);
+				device.downlink->frame = octet_uint16_read(&devices[index * device_row.size], device_row.downlink_frame);
+				device.downlink->kind = octet_uint8_read(&devices[index * device_row.size], device_row.downlink_kind);
+				device.downlink->sent_at = (time_t)octet_uint64_read(&devices[index * device_row.size], device_row.downlink_sent_at);
 			} else {
 				device.downlink = NULL;
 			}
 
+			uint8_t *alerts;
 			uint8_t alerts_len = 0;
-			if (alert_load_by_device(db, &device, &alerts_len) == -1) {
+			if (alert_load_by_device(db, &device, &alerts, &alerts_len) == -1) {
 				continue;
 			}
 
 			debug("found %hhu alerts\n", alerts_len);
 
+			uint8_t *rules;
 			uint8_t rules_len = 0;
-			if (rule_load_by_device(db, &device, &rules_len) == -1) {
+			if (rule_load_by_device(db, &device, &rules, &rules_len) == -1) {
 				continue;
 			}
 
 			debug("found %hhu rules\n", rules_len);
 			for (uint8_t ind = 0; ind < rules_len; ind++) {
 				rule_t rule = {.device_id = device.id};
-				rule.severity = octet_uint8_read(&db->bravo[ind * rule_row.size], rule_row.severity);
-				rule.field = octet_uint8_read(&db->bravo[ind * rule_row.size], rule_row.field);
-				rule.edge = octet_uint8_read(&db->bravo[ind * rule_row.size], rule_row.edge);
-				rule.activate = octet_int32_read(&db->bravo[ind * rule_row.size], rule_row.activate);
-				rule.disable = octet_int32_read(&db->bravo[ind * rule_row.size], rule_row.disable);
+				rule.severity = octet_uint8_read(&rules[ind * rule_row.size], rule_row.severity);
+				rule.field = octet_uint8_read(&rules[ind * rule_row.size], rule_row.field);
+				rule.edge = octet_uint8_read(&rules[ind * rule_row.size], rule_row.edge);
+				rule.activate = octet_int32_read(&rules[ind * rule_row.size], rule_row.activate);
+				rule.disable = octet_int32_read(&rules[ind * rule_row.size], rule_row.disable);
 
 				alert_t alert = {.device_id = device.id};
 				alert_t *existing = NULL;
 				for (uint8_t i = 0; i < alerts_len; i++) {
-					alert.severity = octet_uint8_read(&db->alpha[i * alert_row.size], alert_row.severity);
-					alert.field = octet_uint8_read(&db->alpha[i * alert_row.size], alert_row.field);
-					alert.edge = octet_uint8_read(&db->alpha[i * alert_row.size], alert_row.edge);
-					if (octet_uint8_read(&db->alpha[i * alert_row.size], alert_row.resolved_at_null) != 0x00) {
-						alert.resolved_at = (time_t[]){(time_t)octet_uint64_read(&db->alpha[i * alert_row.size], alert_row.resolved_at)};
+					alert.severity = octet_uint8_read(&alerts[i * alert_row.size], alert_row.severity);
+					alert.field = octet_uint8_read(&alerts[i * alert_row.size], alert_row.field);
+					alert.edge = octet_uint8_read(&alerts[i * alert_row.size], alert_row.edge);
+					if (octet_uint8_read(&alerts[i * alert_row.size], alert_row.resolved_at_null) != 0x00) {
+						alert.resolved_at = (time_t[]){(time_t)octet_uint64_read(&alerts[i * alert_row.size], alert_row.resolved_at)};
 					} else {
 						alert.resolved_at = NULL;
 					}
@@ -421,6 +423,10 @@ void *alerter(void *args) {
 			}
 		}
 
+		struct timespec stop;
+		clock_gettime(CLOCK_MONOTONIC, &stop);
+		stats_cycle(elapsed(&start, &stop));
+
 		unsigned int duration = (uint8_t)(alert_interval - 4) + (uint8_t)(rand() % 9);
 		trace("alerter thread sleeping for %hhus\n", duration);
 		sleep(duration);
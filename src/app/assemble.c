@@ -9,7 +9,31 @@
 #include <string.h>
 #include <unistd.h>
 
+void depend(file_t *asset, const char *path) {
+	if (asset->depends_len == UINT8_MAX) {
+		return;
+	}
+
+	uint32_t hash = fingerprint(path, (uint8_t)strlen(path));
+	for (uint8_t index = 0; index < asset->depends_len; index++) {
+		if (asset->depends[index] == hash) {
+			return;
+		}
+	}
+
+	if (asset->depends_len >= sizeof(asset->depends) / sizeof(*asset->depends)) {
+		warn("file %s depends on more than %zu files\n", asset->path, sizeof(asset->depends) / sizeof(*asset->depends));
+		asset->depends_len = UINT8_MAX;
+		return;
+	}
+
+	asset->depends[asset->depends_len] = hash;
+	asset->depends_len += 1;
+}
+
 int assemble(file_t *asset) {
+	asset->depends_len = 0;
+
 	bool recurse = false;
 
 	bool tag = false;
@@ -97,6 +121,7 @@ recursion:
 
 			sprintf(ref, "%.*s", ref_len, ref_start);
 			file_t component = {.fd = -1, .ptr = NULL, .path = ref, .lock = PTHREAD_RWLOCK_INITIALIZER};
+			depend(asset, ref);
 			if (file(&component) == -1) {
 				return -1;
 			}
@@ -247,6 +272,7 @@ recursion:
 
 			sprintf(path, "%.*s", path_len, start);
 			file_t script = {.fd = -1, .ptr = NULL, .path = path, .lock = PTHREAD_RWLOCK_INITIALIZER};
+			depend(asset, path);
 			if (file(&script) == -1) {
 				return -1;
 			}
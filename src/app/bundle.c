@@ -0,0 +1,103 @@
+#include "bundle.h"
+#include "../lib/error.h"
+#include "../lib/logger.h"
+#include "file.h"
+#include "page.h"
+#include "serve.h"
+#include <stdint.h>
+#include <stdio.h>
+
+int bundle_bytes(FILE *source, const char *name, const char *ptr, size_t len) {
+	if (fprintf(source, "const char %s[] = {", name) < 0) {
+		return -1;
+	}
+
+	for (size_t index = 0; index < len; index++) {
+		if (fprintf(source, "%s'\\x%02x',", index % 16 == 0 ? "\n\t\t" : "", (uint8_t)ptr[index]) < 0) {
+			return -1;
+		}
+	}
+
+	if (fprintf(source, "\n};\n\n") < 0) {
+		return -1;
+	}
+
+	return 0;
+}
+
+int bundle(const char *path) {
+	int status = -1;
+
+	FILE *source = fopen(path, "w");
+	if (source == NULL) {
+		error("failed to open %s because %s\n", path, errno_str());
+		return -1;
+	}
+
+	if (fprintf(source, "#include \"../../src/app/bundle.h\"\n#include <stddef.h>\n#include <stdint.h>\n\n") < 0) {
+		goto cleanup;
+	}
+
+	for (uint8_t index = 0; index < pages_len; index++) {
+		file_t *page = pages[index];
+		if (file(page) == -1 || prepare(page) == -1) {
+			error("failed to prepare %s for bundling\n", page->path);
+			goto cleanup;
+		}
+
+		char name[32];
+		sprintf(name, "bundle_%hhu", index);
+		if (bundle_bytes(source, name, page->ptr, page->len) == -1) {
+			goto write;
+		}
+
+		if (page->zipped != NULL) {
+			sprintf(name, "bundle_%hhu_zipped", index);
+			if (bundle_bytes(source, name, page->zipped, page->zipped_len) == -1) {
+				goto write;
+			}
+		}
+
+		debug("bundled %s with %zu bytes\n", page->path, page->len);
+	}
+
+	if (fprintf(source, "const bundle_t bundles[] = {\n") < 0) {
+		goto write;
+	}
+
+	for (uint8_t index = 0; index < pages_len; index++) {
+		file_t *page = pages[index];
+		int written;
+		if (page->zipped != NULL) {
+			written = fprintf(source,
+												"\t\t{.path = \"%s\", .ptr = bundle_%hhu, .len = %zu, .zipped = bundle_%hhu_zipped, .zipped_len = %zu},\n",
+												page->path, index, page->len, index, page->zipped_len);
+		} else {
+			written = fprintf(source, "\t\t{.path = \"%s\", .ptr = bundle_%hhu, .len = %zu, .zipped = NULL, .zipped_len = 0},\n",
+												page->path, index, page->len);
+		}
+		if (written < 0) {
+			goto write;
+		}
+	}
+
+	if (fprintf(source, "};\n\nconst uint8_t bundles_len = %hhu;\n", pages_len) < 0) {
+		goto write;
+	}
+
+	info("bundled %hhu pages into %s\n", pages_len, path);
+	status = 0;
+	goto cleanup;
+
+write:
+	error("failed to write bundle to %s because %s\n", path, errno_str());
+
+cleanup:
+	if (fclose(source) == EOF && status == 0) {
+		error("failed to close %s because %s\n", path, errno_str());
+		status = -1;
+	}
+	page_close();
+	page_free();
+	return status;
+}
@@ -0,0 +1,17 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+typedef struct bundle_t {
+	const char *path;
+	const char *ptr;
+	size_t len;
+	const char *zipped;
+	size_t zipped_len;
+} bundle_t;
+
+extern const bundle_t bundles[];
+extern const uint8_t bundles_len;
+
+int bundle(const char *path);
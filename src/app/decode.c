@@ -0,0 +1,171 @@
+#include "decode.h"
+#include "../api/decode.h"
+#include "../api/ingest.h"
+#include "../api/uplink.h"
+#include "../lib/arena.h"
+#include "../lib/config.h"
+#include "../lib/logger.h"
+#include "../lib/octet.h"
+#include "../lib/stats.h"
+#include "../lib/thread.h"
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+const uint16_t decoder_batch = 256;
+
+decode_queue_t decode_queue = {
+		.head = 0,
+		.tail = 0,
+		.size = 0,
+		.stopping = false,
+		.lock = PTHREAD_MUTEX_INITIALIZER,
+		.filled = PTHREAD_COND_INITIALIZER,
+		.drained = PTHREAD_COND_INITIALIZER,
+};
+
+pthread_t decoder_thread;
+octet_t decoder_octet;
+char *decoder_buffer;
+
+int decoder_push(uplink_t *uplink) {
+	pthread_mutex_lock(&decode_queue.lock);
+	while (atomic_load_explicit(&decode_queue.size, memory_order_relaxed) == decode_backlog && decode_queue.stopping == false) {
+		pthread_cond_wait(&decode_queue.drained, &decode_queue.lock);
+	}
+	if (decode_queue.stopping == true) {
+		pthread_mutex_unlock(&decode_queue.lock);
+		warn("decoder is stopping\n");
+		return -1;
+	}
+
+	pending_t *pending = &decode_queue.pending[decode_queue.tail];
+	pending->uplink = *uplink;
+	memcpy(pending->data, uplink->data, uplink->data_len);
+	memcpy(pending->device_id, uplink->device_id, sizeof(pending->device_id));
+	pending->uplink.data = pending->data;
+	pending->uplink.device_id = &pending->device_id;
+	clock_gettime(CLOCK_MONOTONIC, &pending->queued_at);
+
+	decode_queue.tail = (uint16_t)((decode_queue.tail + 1) % decode_backlog);
+	atomic_fetch_add_explicit(&decode_queue.size, 1, memory_order_relaxed);
+	pthread_cond_signal(&decode_queue.filled);
+	pthread_mutex_unlock(&decode_queue.lock);
+	return 0;
+}
+
+bool decoder_stopping(void) {
+	pthread_mutex_lock(&decode_queue.lock);
+	bool stopping = decode_queue.stopping;
+	pthread_mutex_unlock(&decode_queue.lock);
+	return stopping;
+}
+
+void decoder_stop(void) {
+	pthread_mutex_lock(&decode_queue.lock);
+	decode_queue.stopping = true;
+	pthread_cond_broadcast(&decode_queue.filled);
+	pthread_cond_broadcast(&decode_queue.drained);
+	pthread_mutex_unlock(&decode_queue.lock);
+}
+
+uint16_t decoder_take(pending_t *batch) {
+	pthread_mutex_lock(&decode_queue.lock);
+	while (atomic_load_explicit(&decode_queue.size, memory_order_relaxed) == 0 && decode_queue.stopping == false) {
+		pthread_cond_wait(&decode_queue.filled, &decode_queue.lock);
+	}
+
+	uint16_t batch_len = 0;
+	while (batch_len < decoder_batch && atomic_load_explicit(&decode_queue.size, memory_order_relaxed) > 0) {
+		batch[batch_len] = decode_queue.pending[decode_queue.head];
+		batch[batch_len].uplink.data = batch[batch_len].data;
+		batch[batch_len].uplink.device_id = &batch[batch_len].device_id;
+		decode_queue.head = (uint16_t)((decode_queue.head + 1) % decode_backlog);
+		atomic_fetch_sub_explicit(&decode_queue.size, 1, memory_order_relaxed);
+		batch_len++;
+	}
+
+	pthread_cond_broadcast(&decode_queue.drained);
+	pthread_mutex_unlock(&decode_queue.lock);
+	return batch_len;
+}
+
+void decoder_commit(octet_t *db, pending_t *batch, uint16_t *order, uint16_t start, uint16_t end) {
+	ingest_t ingest;
+	if (ingest_init(&ingest, &db->arena, batch[order[start]].uplink.device_id, end - start) == -1) {
+		error("failed to allocate ingest for %hu uplinks\n", end - start);
+		return;
+	}
+	ingest.appended = true;
+
+	for (uint16_t index = start; index < end; index++) {
+		uplink_t *uplink = &batch[order[index]].uplink;
+		ingest.uplinks[ingest.uplinks_len++] = *uplink;
+		decode_ingest(uplink, &ingest);
+	}
+
+	if (ingest_commit(db, &ingest) != 0) {
+		error("failed to commit %hu uplinks for device %02x%02x\n", end - start, (*ingest.device_id)[0],
+					(*ingest.device_id)[1]);
+	}
+
+	struct timespec now;
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	for (uint16_t index = start; index < end; index++) {
+		stats_lag(elapsed(&batch[order[index]].queued_at, &now));
+	}
+}
+
+void *decoder(void *args) {
+	octet_t *db = (octet_t *)args;
+
+	db->directory = database_directory;
+
+	db->row_len = UINT8_MAX;
+	db->row = (uint8_t *)&decoder_buffer[database_buffer - db->row_len];
+	arena_init(&db->arena, (uint8_t *)decoder_buffer, database_buffer - db->row_len);
+
+	pending_t *batch = malloc(decoder_batch * sizeof(*batch));
+	uint16_t *order = malloc(decoder_batch * sizeof(*order));
+	if (batch == NULL || order == NULL) {
+		fatal("failed to allocate decoder batch\n");
+		exit(1);
+	}
+
+	while (true) {
+		uint16_t batch_len = decoder_take(batch);
+		if (batch_len == 0) {
+			break;
+		}
+
+		trace("decoder thread committing %hu uplinks\n", batch_len);
+		arena_reset(&db->arena);
+
+		for (uint16_t index = 0; index < batch_len; index++) {
+			uint16_t ind = index;
+			while (ind > 0 && uplink_order(&batch[order[ind - 1]].uplink, &batch[index].uplink) > 0) {
+				order[ind] = order[ind - 1];
+				ind--;
+			}
+			order[ind] = index;
+		}
+
+		uint16_t start = 0;
+		while (start < batch_len) {
+			uint16_t end = start + 1;
+			while (end < batch_len && memcmp(batch[order[end]].device_id, batch[order[start]].device_id, sizeof(batch->device_id)) == 0) {
+				end++;
+			}
+			decoder_commit(db, batch, order, start, end);
+			start = end;
+		}
+	}
+
+	free(batch);
+	free(order);
+	return NULL;
+}
@@ -0,0 +1,39 @@
+#pragma once
+
+#include "../api/uplink.h"
+#include "../lib/octet.h"
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <time.h>
+
+typedef struct pending_t {
+	uplink_t uplink;
+	uint8_t data[32];
+	uint8_t device_id[8];
+	struct timespec queued_at;
+} pending_t;
+
+typedef struct decode_queue_t {
+	pending_t *pending;
+	uint16_t head;
+	uint16_t tail;
+	atomic_uint_fast16_t size;
+	bool stopping;
+	pthread_mutex_t lock;
+	pthread_cond_t filled;
+	pthread_cond_t drained;
+} decode_queue_t;
+
+extern struct decode_queue_t decode_queue;
+
+extern pthread_t decoder_thread;
+extern octet_t decoder_octet;
+extern char *decoder_buffer;
+
+int decoder_push(uplink_t *uplink);
+bool decoder_stopping(void);
+void decoder_stop(void);
+
+void *decoder(void *args);
@@ -34,6 +34,15 @@ const char *type(const char *path) {
 	return "unknown";
 }
 
+uint32_t fingerprint(const char *ptr, uint8_t len) {
+	uint32_t hash = 2166136261;
+	for (uint8_t index = 0; index < len; index++) {
+		hash ^= (uint8_t)ptr[index];
+		hash *= 16777619;
+	}
+	return hash;
+}
+
 int file(file_t *file) {
 	int status = 0;
 
@@ -1,7 +1,9 @@
 #pragma once
 
 #include <pthread.h>
+#include <stdatomic.h>
 #include <stdbool.h>
+#include <stdint.h>
 #include <stdio.h>
 #include <time.h>
 
@@ -11,10 +13,27 @@ typedef struct file_t {
 	size_t len;
 	const char *path;
 	time_t modified;
+	uint16_t status;
 	bool hydrated;
+	bool bundled;
+	atomic_bool stale;
+	uint32_t depends[128];
+	uint8_t depends_len;
+	char head[192];
+	uint8_t head_len;
+	char *zipped;
+	size_t zipped_len;
+	char zipped_head[192];
+	uint8_t zipped_head_len;
+	char *wire;
+	size_t wire_len;
+	char *zipped_wire;
+	size_t zipped_wire_len;
 	pthread_rwlock_t lock;
 } file_t;
 
 const char *type(const char *path);
 
+uint32_t fingerprint(const char *ptr, uint8_t len);
+
 int file(file_t *file);
@@ -9,21 +9,24 @@
 #include <stdlib.h>
 #include <string.h>
 
-int append(class_t (*classes)[256], uint16_t *classes_len, char *next_ptr) {
+int append(class_t (*classes)[1024], uint16_t *classes_len, uint16_t (*slots)[2048], char *next_ptr) {
 	if ((size_t)*classes_len + 1 >= sizeof(*classes) / sizeof(class_t)) {
 		error("can not handle more than %zu classes\n", sizeof(*classes) / sizeof(class_t));
 		return -1;
 	}
 
-	if ((*classes)[*classes_len].len != 0) {
-		bool unique = true;
-		for (size_t index = 0; index < *classes_len; index++) {
-			if ((*classes)[index].len == (*classes)[*classes_len].len &&
-					memcmp((*classes)[index].ptr, (*classes)[*classes_len].ptr, (*classes)[index].len) == 0) {
-				unique = false;
+	class_t *next = &(*classes)[*classes_len];
+	if (next->len != 0) {
+		uint16_t slot = (uint16_t)(fingerprint(next->ptr, next->len) & (sizeof(*slots) / sizeof(uint16_t) - 1));
+		while ((*slots)[slot] != 0) {
+			class_t *known = &(*classes)[(*slots)[slot] - 1];
+			if (known->len == next->len && memcmp(known->ptr, next->ptr, known->len) == 0) {
+				break;
 			}
+			slot = (uint16_t)((slot + 1) & (sizeof(*slots) / sizeof(uint16_t) - 1));
 		}
-		if (unique) {
+		if ((*slots)[slot] == 0) {
+			(*slots)[slot] = (uint16_t)(*classes_len + 1);
 			(*classes_len)++;
 		}
 		(*classes)[*classes_len].len = 0;
@@ -36,7 +39,10 @@ int append(class_t (*classes)[256], uint16_t *classes_len, char *next_ptr) {
 	return 0;
 }
 
-int extract(file_t *file, class_t (*classes)[256], uint16_t *classes_len) {
+int extract(file_t *file, class_t (*classes)[1024], uint16_t *classes_len) {
+	uint16_t slots[2048];
+	memset(slots, 0, sizeof(slots));
+
 	bool tag = false;
 	bool class = false;
 	bool quote = false;
@@ -67,7 +73,7 @@ int extract(file_t *file, class_t (*classes)[256], uint16_t *classes_len) {
 		} else if (*byte == '"' && tag && !quote) {
 			quote = true;
 			if (index > 6 && memcmp(&file->ptr[index - 6], "class=", 6) == 0) {
-				if (append(classes, classes_len, &file->ptr[index + 1]) == -1) {
+				if (append(classes, classes_len, &slots, &file->ptr[index + 1]) == -1) {
 					return -1;
 				}
 				class = true;
@@ -75,14 +81,14 @@ int extract(file_t *file, class_t (*classes)[256], uint16_t *classes_len) {
 		} else if (*byte == '"' && tag && quote) {
 			quote = false;
 			if (class) {
-				if (append(classes, classes_len, NULL) == -1) {
+				if (append(classes, classes_len, &slots, NULL) == -1) {
 					return -1;
 				}
 				class = false;
 			}
 		} else if (tag && class && quote) {
 			if (*byte == ' ') {
-				if (append(classes, classes_len, &file->ptr[index + 1]) == -1) {
+				if (append(classes, classes_len, &slots, &file->ptr[index + 1]) == -1) {
 					return -1;
 				}
 			} else {
@@ -102,17 +108,17 @@ int extract(file_t *file, class_t (*classes)[256], uint16_t *classes_len) {
 			tag = false;
 		} else if (*byte == '\'' && tag && !quote) {
 			quote = true;
-			if (append(classes, classes_len, &file->ptr[index + 1]) == -1) {
+			if (append(classes, classes_len, &slots, &file->ptr[index + 1]) == -1) {
 				return -1;
 			}
 		} else if (*byte == '\'' && tag && quote) {
 			quote = false;
-			if (append(classes, classes_len, NULL) == -1) {
+			if (append(classes, classes_len, &slots, NULL) == -1) {
 				return -1;
 			}
 		} else if (tag && quote) {
 			if (*byte == ',') {
-				if (append(classes, classes_len, &file->ptr[index + 1]) == -1) {
+				if (append(classes, classes_len, &slots, &file->ptr[index + 1]) == -1) {
 					return -1;
 				}
 			} else {
@@ -125,17 +131,17 @@ int extract(file_t *file, class_t (*classes)[256], uint16_t *classes_len) {
 	return 0;
 }
 
-int hydrate(file_t *file, class_t (*classes)[256], uint16_t *classes_len) {
+int hydrate(file_t *file, class_t (*classes)[1024], uint16_t *classes_len) {
 	trace("extracted %hu classes\n", *classes_len);
 
-	char global[8192];
+	char global[32768];
 	uint16_t global_len = 0;
 	breakpoint_t global_breakpoint = {
 			.tag = "",
 			.tag_len = 0,
 	};
 
-	char tiny[8192];
+	char tiny[32768];
 	uint16_t tiny_len = 0;
 	breakpoint_t tiny_breakpoint = {
 			.tag = "xs",
@@ -146,7 +152,7 @@ int hydrate(file_t *file, class_t (*classes)[256], uint16_t *classes_len) {
 			.suffix_len = 1,
 	};
 
-	char small[8192];
+	char small[32768];
 	uint16_t small_len = 0;
 	breakpoint_t small_breakpoint = {
 			.tag = "sm",
@@ -157,7 +163,7 @@ int hydrate(file_t *file, class_t (*classes)[256], uint16_t *classes_len) {
 			.suffix_len = 1,
 	};
 
-	char medium[8192];
+	char medium[32768];
 	uint16_t medium_len = 0;
 	breakpoint_t medium_breakpoint = {
 			.tag = "md",
@@ -168,7 +174,7 @@ int hydrate(file_t *file, class_t (*classes)[256], uint16_t *classes_len) {
 			.suffix_len = 1,
 	};
 
-	char large[8192];
+	char large[32768];
 	uint16_t large_len = 0;
 	breakpoint_t large_breakpoint = {
 			.tag = "lg",
@@ -179,7 +185,7 @@ int hydrate(file_t *file, class_t (*classes)[256], uint16_t *classes_len) {
 			.suffix_len = 1,
 	};
 
-	char giant[8192];
+	char giant[32768];
 	uint16_t giant_len = 0;
 	breakpoint_t giant_breakpoint = {
 			.tag = "xl",
@@ -190,7 +196,7 @@ int hydrate(file_t *file, class_t (*classes)[256], uint16_t *classes_len) {
 			.suffix_len = 1,
 	};
 
-	char dark[8192];
+	char dark[32768];
 	uint16_t dark_len = 0;
 	breakpoint_t dark_breakpoint = {
 			.tag = "dark",
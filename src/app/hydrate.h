@@ -19,6 +19,6 @@ typedef struct breakpoint_t {
 	const uint8_t suffix_len;
 } breakpoint_t;
 
-int extract(file_t *file, class_t (*classes)[256], uint16_t *classes_len);
+int extract(file_t *file, class_t (*classes)[1024], uint16_t *classes_len);
 
-int hydrate(file_t *file, class_t (*classes)[256], uint16_t *classes_len);
+int hydrate(file_t *file, class_t (*classes)[1024], uint16_t *classes_len);
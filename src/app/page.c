@@ -1,54 +1,57 @@
 #include "../lib/logger.h"
+#include "bundle.h"
 #include "file.h"
+#include "serve.h"
 #include <pthread.h>
 #include <stdbool.h>
 #include <stdint.h>
 #include <stdlib.h>
+#include <string.h>
 #include <unistd.h>
 
-file_t page_home = {.path = "./src/app/pages/home.html", .lock = PTHREAD_RWLOCK_INITIALIZER};
-file_t page_robots = {.path = "./src/app/pages/robots.txt", .lock = PTHREAD_RWLOCK_INITIALIZER};
-file_t page_security = {.path = "./src/app/pages/security.txt", .lock = PTHREAD_RWLOCK_INITIALIZER};
-file_t page_devices = {.path = "./src/app/pages/devices.html", .lock = PTHREAD_RWLOCK_INITIALIZER};
-file_t page_device = {.path = "./src/app/pages/device.html", .lock = PTHREAD_RWLOCK_INITIALIZER};
-file_t page_device_readings = {.path = "./src/app/pages/device-readings.html", .lock = PTHREAD_RWLOCK_INITIALIZER};
-file_t page_device_metrics = {.path = "./src/app/pages/device-metrics.html", .lock = PTHREAD_RWLOCK_INITIALIZER};
-file_t page_device_buffers = {.path = "./src/app/pages/device-buffers.html", .lock = PTHREAD_RWLOCK_INITIALIZER};
-file_t page_device_config = {.path = "./src/app/pages/device-config.html", .lock = PTHREAD_RWLOCK_INITIALIZER};
-file_t page_device_radio = {.path = "./src/app/pages/device-radio.html", .lock = PTHREAD_RWLOCK_INITIALIZER};
-file_t page_device_rules = {.path = "./src/app/pages/device-rules.html", .lock = PTHREAD_RWLOCK_INITIALIZER};
-file_t page_device_alerts = {.path = "./src/app/pages/device-alerts.html", .lock = PTHREAD_RWLOCK_INITIALIZER};
-file_t page_device_signals = {.path = "./src/app/pages/device-signals.html", .lock = PTHREAD_RWLOCK_INITIALIZER};
-file_t page_device_uplinks = {.path = "./src/app/pages/device-uplinks.html", .lock = PTHREAD_RWLOCK_INITIALIZER};
-file_t page_device_downlinks = {.path = "./src/app/pages/device-downlinks.html", .lock = PTHREAD_RWLOCK_INITIALIZER};
-file_t page_zones = {.path = "./src/app/pages/zones.html", .lock = PTHREAD_RWLOCK_INITIALIZER};
-file_t page_zone = {.path = "./src/app/pages/zone.html", .lock = PTHREAD_RWLOCK_INITIALIZER};
-file_t page_zone_readings = {.path = "./src/app/pages/zone-readings.html", .lock = PTHREAD_RWLOCK_INITIALIZER};
-file_t page_zone_metrics = {.path = "./src/app/pages/zone-metrics.html", .lock = PTHREAD_RWLOCK_INITIALIZER};
-file_t page_zone_buffers = {.path = "./src/app/pages/zone-buffers.html", .lock = PTHREAD_RWLOCK_INITIALIZER};
-file_t page_zone_signals = {.path = "./src/app/pages/zone-signals.html", .lock = PTHREAD_RWLOCK_INITIALIZER};
-file_t page_alerts = {.path = "./src/app/pages/alerts.html", .lock = PTHREAD_RWLOCK_INITIALIZER};
-file_t page_uplinks = {.path = "./src/app/pages/uplinks.html", .lock = PTHREAD_RWLOCK_INITIALIZER};
-file_t page_downlinks = {.path = "./src/app/pages/downlinks.html", .lock = PTHREAD_RWLOCK_INITIALIZER};
-file_t page_users = {.path = "./src/app/pages/users.html", .lock = PTHREAD_RWLOCK_INITIALIZER};
-file_t page_user = {.path = "./src/app/pages/user.html", .lock = PTHREAD_RWLOCK_INITIALIZER};
-file_t page_user_devices = {.path = "./src/app/pages/user-devices.html", .lock = PTHREAD_RWLOCK_INITIALIZER};
-file_t page_user_zones = {.path = "./src/app/pages/user-zones.html", .lock = PTHREAD_RWLOCK_INITIALIZER};
-file_t page_profile = {.path = "./src/app/pages/profile.html", .lock = PTHREAD_RWLOCK_INITIALIZER};
-file_t page_signin = {.path = "./src/app/pages/signin.html", .lock = PTHREAD_RWLOCK_INITIALIZER};
-file_t page_signup = {.path = "./src/app/pages/signup.html", .lock = PTHREAD_RWLOCK_INITIALIZER};
+file_t page_home = {.path = "./src/app/pages/home.html", .status = 200, .lock = PTHREAD_RWLOCK_INITIALIZER};
+file_t page_robots = {.path = "./src/app/pages/robots.txt", .status = 200, .lock = PTHREAD_RWLOCK_INITIALIZER};
+file_t page_security = {.path = "./src/app/pages/security.txt", .status = 200, .lock = PTHREAD_RWLOCK_INITIALIZER};
+file_t page_devices = {.path = "./src/app/pages/devices.html", .status = 200, .lock = PTHREAD_RWLOCK_INITIALIZER};
+file_t page_device = {.path = "./src/app/pages/device.html", .status = 200, .lock = PTHREAD_RWLOCK_INITIALIZER};
+file_t page_device_readings = {.path = "./src/app/pages/device-readings.html", .status = 200, .lock = PTHREAD_RWLOCK_INITIALIZER};
+file_t page_device_metrics = {.path = "./src/app/pages/device-metrics.html", .status = 200, .lock = PTHREAD_RWLOCK_INITIALIZER};
+file_t page_device_buffers = {.path = "./src/app/pages/device-buffers.html", .status = 200, .lock = PTHREAD_RWLOCK_INITIALIZER};
+file_t page_device_config = {.path = "./src/app/pages/device-config.html", .status = 200, .lock = PTHREAD_RWLOCK_INITIALIZER};
+file_t page_device_radio = {.path = "./src/app/pages/device-radio.html", .status = 200, .lock = PTHREAD_RWLOCK_INITIALIZER};
+file_t page_device_rules = {.path = "./src/app/pages/device-rules.html", .status = 200, .lock = PTHREAD_RWLOCK_INITIALIZER};
+file_t page_device_alerts = {.path = "./src/app/pages/device-alerts.html", .status = 200, .lock = PTHREAD_RWLOCK_INITIALIZER};
+file_t page_device_signals = {.path = "./src/app/pages/device-signals.html", .status = 200, .lock = PTHREAD_RWLOCK_INITIALIZER};
+file_t page_device_uplinks = {.path = "./src/app/pages/device-uplinks.html", .status = 200, .lock = PTHREAD_RWLOCK_INITIALIZER};
+file_t page_device_downlinks = {.path = "./src/app/pages/device-downlinks.html", .status = 200, .lock = PTHREAD_RWLOCK_INITIALIZER};
+file_t page_zones = {.path = "./src/app/pages/zones.html", .status = 200, .lock = PTHREAD_RWLOCK_INITIALIZER};
+file_t page_zone = {.path = "./src/app/pages/zone.html", .status = 200, .lock = PTHREAD_RWLOCK_INITIALIZER};
+file_t page_zone_readings = {.path = "./src/app/pages/zone-readings.html", .status = 200, .lock = PTHREAD_RWLOCK_INITIALIZER};
+file_t page_zone_metrics = {.path = "./src/app/pages/zone-metrics.html", .status = 200, .lock = PTHREAD_RWLOCK_INITIALIZER};
+file_t page_zone_buffers = {.path = "./src/app/pages/zone-buffers.html", .status = 200, .lock = PTHREAD_RWLOCK_INITIALIZER};
+file_t page_zone_signals = {.path = "./src/app/pages/zone-signals.html", .status = 200, .lock = PTHREAD_RWLOCK_INITIALIZER};
+file_t page_alerts = {.path = "./src/app/pages/alerts.html", .status = 200, .lock = PTHREAD_RWLOCK_INITIALIZER};
+file_t page_uplinks = {.path = "./src/app/pages/uplinks.html", .status = 200, .lock = PTHREAD_RWLOCK_INITIALIZER};
+file_t page_downlinks = {.path = "./src/app/pages/downlinks.html", .status = 200, .lock = PTHREAD_RWLOCK_INITIALIZER};
+file_t page_users = {.path = "./src/app/pages/users.html", .status = 200, .lock = PTHREAD_RWLOCK_INITIALIZER};
+file_t page_user = {.path = "./src/app/pages/user.html", .status = 200, .lock = PTHREAD_RWLOCK_INITIALIZER};
+file_t page_user_devices = {.path = "./src/app/pages/user-devices.html", .status = 200, .lock = PTHREAD_RWLOCK_INITIALIZER};
+file_t page_user_zones = {.path = "./src/app/pages/user-zones.html", .status = 200, .lock = PTHREAD_RWLOCK_INITIALIZER};
+file_t page_profile = {.path = "./src/app/pages/profile.html", .status = 200, .lock = PTHREAD_RWLOCK_INITIALIZER};
+file_t page_signin = {.path = "./src/app/pages/signin.html", .status = 200, .lock = PTHREAD_RWLOCK_INITIALIZER};
+file_t page_signup = {.path = "./src/app/pages/signup.html", .status = 200, .lock = PTHREAD_RWLOCK_INITIALIZER};
 
-file_t page_bad_request = {.path = "./src/app/pages/400.html", .lock = PTHREAD_RWLOCK_INITIALIZER};
-file_t page_unauthorized = {.path = "./src/app/pages/401.html", .lock = PTHREAD_RWLOCK_INITIALIZER};
-file_t page_forbidden = {.path = "./src/app/pages/403.html", .lock = PTHREAD_RWLOCK_INITIALIZER};
-file_t page_not_found = {.path = "./src/app/pages/404.html", .lock = PTHREAD_RWLOCK_INITIALIZER};
-file_t page_method_not_allowed = {.path = "./src/app/pages/405.html", .lock = PTHREAD_RWLOCK_INITIALIZER};
-file_t page_uri_too_long = {.path = "./src/app/pages/414.html", .lock = PTHREAD_RWLOCK_INITIALIZER};
-file_t page_request_header_fields_too_large = {.path = "./src/app/pages/431.html", .lock = PTHREAD_RWLOCK_INITIALIZER};
-file_t page_internal_server_error = {.path = "./src/app/pages/500.html", .lock = PTHREAD_RWLOCK_INITIALIZER};
-file_t page_service_unavailable = {.path = "./src/app/pages/503.html", .lock = PTHREAD_RWLOCK_INITIALIZER};
-file_t page_http_version_not_supported = {.path = "./src/app/pages/505.html", .lock = PTHREAD_RWLOCK_INITIALIZER};
-file_t page_insufficient_storage = {.path = "./src/app/pages/507.html", .lock = PTHREAD_RWLOCK_INITIALIZER};
+file_t page_bad_request = {.path = "./src/app/pages/400.html", .status = 400, .lock = PTHREAD_RWLOCK_INITIALIZER};
+file_t page_unauthorized = {.path = "./src/app/pages/401.html", .status = 401, .lock = PTHREAD_RWLOCK_INITIALIZER};
+file_t page_forbidden = {.path = "./src/app/pages/403.html", .status = 403, .lock = PTHREAD_RWLOCK_INITIALIZER};
+file_t page_not_found = {.path = "./src/app/pages/404.html", .status = 404, .lock = PTHREAD_RWLOCK_INITIALIZER};
+file_t page_method_not_allowed = {.path = "./src/app/pages/405.html", .status = 405, .lock = PTHREAD_RWLOCK_INITIALIZER};
+file_t page_uri_too_long = {.path = "./src/app/pages/414.html", .status = 414, .lock = PTHREAD_RWLOCK_INITIALIZER};
+file_t page_request_header_fields_too_large = {.path = "./src/app/pages/431.html", .status = 431, .lock = PTHREAD_RWLOCK_INITIALIZER};
+file_t page_internal_server_error = {.path = "./src/app/pages/500.html", .status = 500, .lock = PTHREAD_RWLOCK_INITIALIZER};
+file_t page_service_unavailable = {.path = "./src/app/pages/503.html", .status = 503, .lock = PTHREAD_RWLOCK_INITIALIZER};
+file_t page_http_version_not_supported = {.path = "./src/app/pages/505.html", .status = 505, .lock = PTHREAD_RWLOCK_INITIALIZER};
+file_t page_insufficient_storage = {.path = "./src/app/pages/507.html", .status = 507, .lock = PTHREAD_RWLOCK_INITIALIZER};
 
 file_t *pages[] = {
 		&page_home,
@@ -95,6 +98,8 @@ file_t *pages[] = {
 		&page_insufficient_storage,
 };
 
+const uint8_t pages_len = sizeof(pages) / sizeof(*pages);
+
 void page_init(void) {
 	trace("initialising %zu pages\n", sizeof(pages) / sizeof(*pages));
 
@@ -104,7 +109,31 @@ void page_init(void) {
 		pages[index]->len = 0;
 		pages[index]->modified = 0;
 		pages[index]->hydrated = false;
+		pages[index]->bundled = false;
+		pages[index]->stale = true;
+		pages[index]->depends_len = 0;
+		pages[index]->zipped = NULL;
+		pages[index]->zipped_len = 0;
+		pages[index]->wire = NULL;
+		pages[index]->wire_len = 0;
+		pages[index]->zipped_wire = NULL;
+		pages[index]->zipped_wire_len = 0;
+
+		for (uint8_t ind = 0; ind < bundles_len; ind++) {
+			if (strcmp(bundles[ind].path, pages[index]->path) == 0) {
+				pages[index]->ptr = (char *)bundles[ind].ptr;
+				pages[index]->len = bundles[ind].len;
+				pages[index]->zipped = (char *)bundles[ind].zipped;
+				pages[index]->zipped_len = bundles[ind].zipped_len;
+				pages[index]->hydrated = true;
+				pages[index]->bundled = true;
+				preset(pages[index]);
+				break;
+			}
+		}
 	}
+
+	trace("bundled %hhu pages\n", bundles_len);
 }
 
 void page_close(void) {
@@ -125,10 +154,20 @@ void page_free(void) {
 	uint8_t freed = 0;
 
 	for (uint8_t index = 0; index < sizeof(pages) / sizeof(*pages); index++) {
-		if (pages[index]->ptr != NULL) {
+		free(pages[index]->wire);
+		pages[index]->wire = NULL;
+		pages[index]->wire_len = 0;
+		free(pages[index]->zipped_wire);
+		pages[index]->zipped_wire = NULL;
+		pages[index]->zipped_wire_len = 0;
+
+		if (pages[index]->ptr != NULL && pages[index]->bundled == false) {
 			free(pages[index]->ptr);
 			pages[index]->ptr = NULL;
 			pages[index]->len = 0;
+			free(pages[index]->zipped);
+			pages[index]->zipped = NULL;
+			pages[index]->zipped_len = 0;
 			pages[index]->modified = 0;
 			pages[index]->hydrated = false;
 			freed += 1;
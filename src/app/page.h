@@ -46,6 +46,9 @@ extern file_t page_service_unavailable;
 extern file_t page_http_version_not_supported;
 extern file_t page_insufficient_storage;
 
+extern file_t *pages[];
+extern const uint8_t pages_len;
+
 void page_init(void);
 void page_close(void);
 void page_free(void);
@@ -5,45 +5,146 @@
 #include "../api/zone.h"
 #include "../lib/base16.h"
 #include "../lib/bwt.h"
+#include "../lib/error.h"
+#include "../lib/gzip.h"
 #include "../lib/logger.h"
 #include "../lib/octet.h"
 #include "../lib/request.h"
 #include "../lib/response.h"
+#include "../lib/status.h"
+#include "../lib/strn.h"
 #include "assemble.h"
 #include "file.h"
 #include "hydrate.h"
 #include "page.h"
+#include "watch.h"
 #include <pthread.h>
+#include <stdatomic.h>
 #include <stdbool.h>
 #include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
 
-void serve(file_t *asset, response_t *response) {
-	if (file(asset) == -1) {
-		response->status = 500;
+bool accepts(request_t *request, const char *encoding) {
+	uint16_t header_len = 0;
+	const char *header = header_find(request, "accept-encoding", &header_len);
+	if (header == NULL) {
+		return false;
+	}
+
+	size_t encoding_len = strlen(encoding);
+	const char *token = strncasestrn(header, header_len, encoding, encoding_len);
+	if (token == NULL) {
+		return false;
+	}
+
+	const char *cursor = token + encoding_len;
+	const char *stop = header + header_len;
+	while (cursor < stop && *cursor == ' ') {
+		cursor++;
+	}
+	if (cursor >= stop || *cursor != ';') {
+		return true;
+	}
+	cursor++;
+	while (cursor < stop && *cursor == ' ') {
+		cursor++;
+	}
+	if (stop - cursor < 3 || memcmp(cursor, "q=0", 3) != 0) {
+		return true;
+	}
+	cursor += 3;
+	if (cursor < stop && *cursor == '.') {
+		cursor++;
+		while (cursor < stop && *cursor == '0') {
+			cursor++;
+		}
+	}
+	return cursor < stop && *cursor >= '1' && *cursor <= '9';
+}
+
+void stitch(char **wire, size_t *wire_len, const char *head, uint8_t head_len, const char *body, size_t body_len) {
+	char *stitched = realloc(*wire, head_len + body_len);
+	if (stitched == NULL) {
+		error("failed to allocate %zu bytes for wire because %s\n", head_len + body_len, errno_str());
+		free(*wire);
+		*wire = NULL;
+		*wire_len = 0;
 		return;
 	}
 
-	pthread_rwlock_rdlock(&asset->lock);
-	if (asset->hydrated == false) {
-		pthread_rwlock_unlock(&asset->lock);
-		pthread_rwlock_wrlock(&asset->lock);
-		if (asset->hydrated == true) {
-			goto cleanup;
+	memcpy(stitched, head, head_len);
+	memcpy(&stitched[head_len], body, body_len);
+	*wire = stitched;
+	*wire_len = head_len + body_len;
+}
+
+void preset(file_t *asset) {
+	asset->head_len = (uint8_t)sprintf(
+			asset->head, "HTTP/1.1 %hu %s\r\ncontent-type:%s\r\ncontent-length:%zu\r\nvary:accept-encoding\r\n\r\n", asset->status,
+			status_text(asset->status), type(asset->path), asset->len);
+
+	if (asset->zipped != NULL) {
+		asset->zipped_head_len = (uint8_t)sprintf(
+				asset->zipped_head,
+				"HTTP/1.1 %hu %s\r\ncontent-type:%s\r\ncontent-encoding:gzip\r\ncontent-length:%zu\r\nvary:accept-encoding\r\n\r\n",
+				asset->status, status_text(asset->status), type(asset->path), asset->zipped_len);
+	}
+
+	if (asset->status != 200) {
+		stitch(&asset->wire, &asset->wire_len, asset->head, asset->head_len, asset->ptr, asset->len);
+		if (asset->zipped != NULL) {
+			stitch(&asset->zipped_wire, &asset->zipped_wire_len, asset->zipped_head, asset->zipped_head_len, asset->zipped,
+						 asset->zipped_len);
 		}
+	}
+}
 
-		if (assemble(asset) == -1) {
+int prepare(file_t *asset) {
+	if (assemble(asset) == -1) {
+		return -1;
+	}
+
+	class_t classes[1024];
+	uint16_t classes_len = 0;
+	if (extract(asset, &classes, &classes_len) == -1) {
+		return -1;
+	}
+
+	if (hydrate(asset, &classes, &classes_len) == -1) {
+		return -1;
+	}
+
+	free(asset->zipped);
+	asset->zipped = NULL;
+	asset->zipped_len = 0;
+	if (gzip(asset->ptr, asset->len, &asset->zipped, &asset->zipped_len) == 0) {
+		debug("compressed file %s from %zu to %zu bytes\n", asset->path, asset->len, asset->zipped_len);
+	}
+
+	preset(asset);
+	return 0;
+}
+
+void serve(file_t *asset, request_t *request, response_t *response) {
+	bool fresh = asset->bundled == true || (watching == true && atomic_load_explicit(&asset->stale, memory_order_acquire) == false);
+	if (fresh == false) {
+		atomic_store_explicit(&asset->stale, false, memory_order_release);
+		if (file(asset) == -1) {
 			response->status = 500;
-			goto cleanup;
+			return;
 		}
+	}
 
-		class_t classes[256];
-		uint16_t classes_len = 0;
-		if (extract(asset, &classes, &classes_len) == -1) {
-			response->status = 500;
+	pthread_rwlock_rdlock(&asset->lock);
+	if (asset->hydrated == false) {
+		pthread_rwlock_unlock(&asset->lock);
+		pthread_rwlock_wrlock(&asset->lock);
+		if (asset->hydrated == true) {
 			goto cleanup;
 		}
 
-		if (hydrate(asset, &classes, &classes_len) == -1) {
+		if (prepare(asset) == -1) {
 			response->status = 500;
 			goto cleanup;
 		}
@@ -53,20 +154,37 @@ void serve(file_t *asset, response_t *response) {
 	}
 
 	if (asset->ptr != NULL) {
-		info("sending file %s\n", asset->path);
-
-		if (asset->len > response->body.cap) {
-			error("file length %zu exceeds buffer length %u\n", asset->len, response->body.cap);
-			response->status = 500;
-			goto cleanup;
+		bool zipped = asset->zipped != NULL && accepts(request, "gzip");
+		info("sending file %s%s\n", asset->path, zipped ? " compressed" : "");
+
+		if ((response->status == 0 || response->status == asset->status) && response->header.len == 0) {
+			response->status = asset->status;
+			char *wire = zipped ? asset->zipped_wire : asset->wire;
+			if (wire != NULL && (request->method.len != 4 || memcmp(request->method.ptr, "head", 4) != 0)) {
+				response->preset = wire;
+				response->preset_len = zipped ? asset->zipped_wire_len : asset->wire_len;
+				response->preset_split = (zipped ? asset->zipped_head_len : asset->head_len) - 2u;
+				response->content_lock = &asset->lock;
+				return;
+			}
+			response->preset = zipped ? asset->zipped_head : asset->head;
+			response->preset_len = zipped ? asset->zipped_head_len : asset->head_len;
+			response->preset_split = response->preset_len - 2;
+		} else {
+			if (response->status == 0) {
+				response->status = 200;
+			}
+			header_write(response, "content-type:%s\r\n", type(asset->path));
+			if (zipped) {
+				header_write(response, "content-encoding:gzip\r\n");
+			}
+			header_write(response, "content-length:%zu\r\n", zipped ? asset->zipped_len : asset->len);
+			header_write(response, "vary:accept-encoding\r\n");
 		}
-
-		if (response->status == 0) {
-			response->status = 200;
-		}
-		header_write(response, "content-type:%s\r\n", type(asset->path));
-		header_write(response, "content-length:%zu\r\n", asset->len);
-		body_write(response, asset->ptr, asset->len);
+		response->content = zipped ? asset->zipped : asset->ptr;
+		response->content_len = zipped ? asset->zipped_len : asset->len;
+		response->content_lock = &asset->lock;
+		return;
 	}
 
 cleanup:
@@ -103,7 +221,7 @@ void serve_device(octet_t *db, bwt_t *bwt, request_t *request, response_t *respo
 		return;
 	}
 
-	serve(&page_device, response);
+	serve(&page_device, request, response);
 }
 
 void serve_device_readings(octet_t *db, bwt_t *bwt, request_t *request, response_t *response) {
@@ -136,7 +254,7 @@ void serve_device_readings(octet_t *db, bwt_t *bwt, request_t *request, response
 		return;
 	}
 
-	serve(&page_device_readings, response);
+	serve(&page_device_readings, request, response);
 }
 
 void serve_device_metrics(octet_t *db, bwt_t *bwt, request_t *request, response_t *response) {
@@ -169,7 +287,7 @@ void serve_device_metrics(octet_t *db, bwt_t *bwt, request_t *request, response_
 		return;
 	}
 
-	serve(&page_device_metrics, response);
+	serve(&page_device_metrics, request, response);
 }
 
 void serve_device_buffers(octet_t *db, bwt_t *bwt, request_t *request, response_t *response) {
@@ -202,7 +320,7 @@ void serve_device_buffers(octet_t *db, bwt_t *bwt, request_t *request, response_
 		return;
 	}
 
-	serve(&page_device_buffers, response);
+	serve(&page_device_buffers, request, response);
 }
 
 void serve_device_config(octet_t *db, bwt_t *bwt, request_t *request, response_t *response) {
@@ -235,7 +353,7 @@ void serve_device_config(octet_t *db, bwt_t *bwt, request_t *request, response_t
 		return;
 	}
 
-	serve(&page_device_config, response);
+	serve(&page_device_config, request, response);
 }
 
 void serve_device_radio(octet_t *db, bwt_t *bwt, request_t *request, response_t *response) {
@@ -268,7 +386,7 @@ void serve_device_radio(octet_t *db, bwt_t *bwt, request_t *request, response_t
 		return;
 	}
 
-	serve(&page_device_radio, response);
+	serve(&page_device_radio, request, response);
 }
 
 void serve_device_rules(octet_t *db, bwt_t *bwt, request_t *request, response_t *response) {
@@ -301,7 +419,7 @@ void serve_device_rules(octet_t *db, bwt_t *bwt, request_t *request, response_t
 		return;
 	}
 
-	serve(&page_device_rules, response);
+	serve(&page_device_rules, request, response);
 }
 
 void serve_device_alerts(octet_t *db, bwt_t *bwt, request_t *request, response_t *response) {
@@ -334,7 +452,7 @@ void serve_device_alerts(octet_t *db, bwt_t *bwt, request_t *request, response_t
 		return;
 	}
 
-	serve(&page_device_alerts, response);
+	serve(&page_device_alerts, request, response);
 }
 
 void serve_device_signals(octet_t *db, bwt_t *bwt, request_t *request, response_t *response) {
@@ -367,7 +485,7 @@ void serve_device_signals(octet_t *db, bwt_t *bwt, request_t *request, response_
 		return;
 	}
 
-	serve(&page_device_signals, response);
+	serve(&page_device_signals, request, response);
 }
 
 void serve_device_uplinks(octet_t *db, bwt_t *bwt, request_t *request, response_t *response) {
@@ -400,7 +518,7 @@ void serve_device_uplinks(octet_t *db, bwt_t *bwt, request_t *request, response_
 		return;
 	}
 
-	serve(&page_device_uplinks, response);
+	serve(&page_device_uplinks, request, response);
 }
 
 void serve_device_downlinks(octet_t *db, bwt_t *bwt, request_t *request, response_t *response) {
@@ -433,7 +551,7 @@ void serve_device_downlinks(octet_t *db, bwt_t *bwt, request_t *request, respons
 		return;
 	}
 
-	serve(&page_device_downlinks, response);
+	serve(&page_device_downlinks, request, response);
 }
 
 void serve_zone(octet_t *db, bwt_t *bwt, request_t *request, response_t *response) {
@@ -466,7 +584,7 @@ void serve_zone(octet_t *db, bwt_t *bwt, request_t *request, response_t *respons
 		return;
 	}
 
-	serve(&page_zone, response);
+	serve(&page_zone, request, response);
 }
 
 void serve_zone_readings(octet_t *db, bwt_t *bwt, request_t *request, response_t *response) {
@@ -499,7 +617,7 @@ void serve_zone_readings(octet_t *db, bwt_t *bwt, request_t *request, response_t
 		return;
 	}
 
-	serve(&page_zone_readings, response);
+	serve(&page_zone_readings, request, response);
 }
 
 void serve_zone_metrics(octet_t *db, bwt_t *bwt, request_t *request, response_t *response) {
@@ -532,7 +650,7 @@ void serve_zone_metrics(octet_t *db, bwt_t *bwt, request_t *request, response_t
 		return;
 	}
 
-	serve(&page_zone_metrics, response);
+	serve(&page_zone_metrics, request, response);
 }
 
 void serve_zone_buffers(octet_t *db, bwt_t *bwt, request_t *request, response_t *response) {
@@ -565,7 +683,7 @@ void serve_zone_buffers(octet_t *db, bwt_t *bwt, request_t *request, response_t
 		return;
 	}
 
-	serve(&page_zone_buffers, response);
+	serve(&page_zone_buffers, request, response);
 }
 
 void serve_zone_signals(octet_t *db, bwt_t *bwt, request_t *request, response_t *response) {
@@ -598,7 +716,7 @@ void serve_zone_signals(octet_t *db, bwt_t *bwt, request_t *request, response_t
 		return;
 	}
 
-	serve(&page_zone_signals, response);
+	serve(&page_zone_signals, request, response);
 }
 
 void serve_user(octet_t *db, request_t *request, response_t *response) {
@@ -624,7 +742,7 @@ void serve_user(octet_t *db, request_t *request, response_t *response) {
 		return;
 	}
 
-	serve(&page_user, response);
+	serve(&page_user, request, response);
 }
 
 void serve_user_devices(octet_t *db, request_t *request, response_t *response) {
@@ -650,7 +768,7 @@ void serve_user_devices(octet_t *db, request_t *request, response_t *response) {
 		return;
 	}
 
-	serve(&page_user_devices, response);
+	serve(&page_user_devices, request, response);
 }
 
 void serve_user_zones(octet_t *db, request_t *request, response_t *response) {
@@ -676,5 +794,5 @@ void serve_user_zones(octet_t *db, request_t *request, response_t *response) {
 		return;
 	}
 
-	serve(&page_user_zones, response);
+	serve(&page_user_zones, request, response);
 }
@@ -6,7 +6,10 @@
 #include "../lib/response.h"
 #include "file.h"
 
-void serve(file_t *asset, response_t *response);
+void preset(file_t *asset);
+int prepare(file_t *asset);
+
+void serve(file_t *asset, request_t *request, response_t *response);
 
 void serve_device(octet_t *db, bwt_t *bwt, request_t *request, response_t *response);
 void serve_device_readings(octet_t *db, bwt_t *bwt, request_t *request, response_t *response);
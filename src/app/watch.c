@@ -0,0 +1,147 @@
+#include "watch.h"
+#include "../lib/error.h"
+#include "../lib/logger.h"
+#include "file.h"
+#include "page.h"
+#include <errno.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+
+#ifdef __linux__
+#include <sys/inotify.h>
+#endif
+
+pthread_t watcher_thread;
+bool watching = false;
+
+int watcher_fd = -1;
+const char *watcher_dirs[] = {"./src/app/pages", "./src/app/components", "./src/app/scripts"};
+int watcher_wds[sizeof(watcher_dirs) / sizeof(*watcher_dirs)];
+
+int watch_init(void) {
+#ifdef __linux__
+	watcher_fd = inotify_init1(IN_CLOEXEC);
+	if (watcher_fd == -1) {
+		warn("failed to init inotify because %s\n", errno_str());
+		return -1;
+	}
+
+	for (uint8_t index = 0; index < sizeof(watcher_dirs) / sizeof(*watcher_dirs); index++) {
+		watcher_wds[index] = inotify_add_watch(watcher_fd, watcher_dirs[index], IN_CLOSE_WRITE | IN_MOVED_TO | IN_DELETE);
+		if (watcher_wds[index] == -1) {
+			warn("failed to watch %s because %s\n", watcher_dirs[index], errno_str());
+			watch_close();
+			return -1;
+		}
+		trace("watching directory %s\n", watcher_dirs[index]);
+	}
+
+	return 0;
+#else
+	warn("watching pages is not supported on this platform\n");
+	return -1;
+#endif
+}
+
+void watch_close(void) {
+	if (watcher_fd != -1) {
+		close(watcher_fd);
+		watcher_fd = -1;
+	}
+}
+
+uint8_t invalidate(const char *path) {
+	uint32_t hash = 0;
+	if (path != NULL) {
+		hash = fingerprint(path, (uint8_t)strlen(path));
+	}
+
+	uint8_t marked = 0;
+	for (uint8_t index = 0; index < pages_len; index++) {
+		file_t *page = pages[index];
+		if (page->bundled == true) {
+			continue;
+		}
+
+		pthread_rwlock_rdlock(&page->lock);
+		bool affected = path == NULL || strcmp(page->path, path) == 0 || page->depends_len == UINT8_MAX;
+		for (uint8_t ind = 0; affected == false && ind < page->depends_len; ind++) {
+			affected = page->depends[ind] == hash;
+		}
+		pthread_rwlock_unlock(&page->lock);
+
+		if (affected == false) {
+			continue;
+		}
+
+		pthread_rwlock_wrlock(&page->lock);
+		if (page->fd != -1) {
+			close(page->fd);
+			page->fd = -1;
+		}
+		page->modified = 0;
+		pthread_rwlock_unlock(&page->lock);
+
+		atomic_store_explicit(&page->stale, true, memory_order_release);
+		marked += 1;
+	}
+
+	return marked;
+}
+
+void *watcher(void *args) {
+	(void)args;
+
+#ifdef __linux__
+	_Alignas(struct inotify_event) char events[4096];
+
+	while (true) {
+		ssize_t events_len = read(watcher_fd, events, sizeof(events));
+		if (events_len == -1) {
+			if (errno == EINTR) {
+				continue;
+			}
+			error("failed to read inotify events because %s\n", errno_str());
+			break;
+		}
+
+		int state;
+		pthread_setcancelstate(PTHREAD_CANCEL_DISABLE, &state);
+
+		char *ptr = events;
+		while (ptr < events + events_len) {
+			struct inotify_event *event = (struct inotify_event *)ptr;
+			ptr += sizeof(*event) + event->len;
+
+			if (event->mask & IN_Q_OVERFLOW) {
+				warn("inotify queue overflowed invalidating %hhu pages\n", invalidate(NULL));
+				continue;
+			}
+
+			for (uint8_t index = 0; index < sizeof(watcher_dirs) / sizeof(*watcher_dirs); index++) {
+				if (event->wd != watcher_wds[index] || event->len == 0) {
+					continue;
+				}
+
+				char path[256];
+				int path_len = snprintf(path, sizeof(path), "%s/%s", watcher_dirs[index], event->name);
+				if (path_len < 0 || (size_t)path_len >= sizeof(path)) {
+					warn("changed path in %s exceeds %zu bytes\n", watcher_dirs[index], sizeof(path) - 1);
+					continue;
+				}
+
+				debug("file %s changed invalidating %hhu pages\n", path, invalidate(path));
+			}
+		}
+
+		pthread_setcancelstate(state, NULL);
+	}
+#endif
+
+	return NULL;
+}
@@ -0,0 +1,11 @@
+#pragma once
+
+#include <pthread.h>
+#include <stdbool.h>
+
+extern pthread_t watcher_thread;
+extern bool watching;
+
+int watch_init(void);
+void watch_close(void);
+void *watcher(void *args);
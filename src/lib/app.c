@@ -1,4 +1,6 @@
 #include "../api/router.h"
+#include "base16.h"
+#include "capture.h"
 #include "config.h"
 #include "error.h"
 #include "format.h"
@@ -6,12 +8,86 @@
 #include "octet.h"
 #include "request.h"
 #include "response.h"
-#include "strn.h"
+#include "span.h"
+#include "stats.h"
+#include "thread.h"
 #include <arpa/inet.h>
+#include <pthread.h>
+#include <stdarg.h>
+#include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/uio.h>
 #include <time.h>
 #include <unistd.h>
 
+void slow_append(char (*line)[512], size_t *len, const char *format, ...) {
+	if (*len >= sizeof(*line)) {
+		return;
+	}
+	va_list args;
+	va_start(args, format);
+	int written = vsnprintf(&(*line)[*len], sizeof(*line) - *len, format, args);
+	va_end(args);
+	if (written > 0) {
+		*len += (size_t)written;
+	}
+}
+
+void slow_request(request_t *request, response_t *response, uint64_t duration) {
+	char line[512];
+	size_t len = 0;
+
+	const route_t *rt = request->route == 0 ? NULL : &routes[request->route - 1];
+	if (rt != NULL) {
+		slow_append(&line, &len, "route=\"%s %s\"", rt->method, rt->pathname);
+	} else {
+		slow_append(&line, &len, "route=\"%.*s %.*s\"", (int)request->method.len, request->method.ptr, (int)request->pathname.len,
+								request->pathname.ptr);
+	}
+	slow_append(&line, &len, " status=%hu duration=%.3fms", response->status, (double)duration / 1000000);
+
+	if (span.authenticated == true) {
+		char uuid[16];
+		base16_encode(uuid, sizeof(uuid), span.user, sizeof(span.user));
+		slow_append(&line, &len, " user=%.*s", (int)sizeof(uuid), uuid);
+	}
+
+	const char *colon = rt != NULL ? strchr(rt->pathname, ':') : NULL;
+	if (colon != NULL && request->params_len > 0) {
+		const char *key = colon - 1;
+		while (key > rt->pathname && key[-1] != '/') {
+			key--;
+		}
+		slow_append(&line, &len, " %.*s=%.*s", (int)(colon - 1 - key), key, (int)request->params[0].len,
+								&request->pathname.ptr[request->params[0].offset]);
+	}
+
+	const char *keys[] = {"from", "to", "bucket", "limit", "offset"};
+	uint16_t index = 0;
+	while (index < request->search.len) {
+		const char *pair = &request->search.ptr[index];
+		const char *amp = memchr(pair, '&', request->search.len - index);
+		uint16_t pair_len = amp == NULL ? (uint16_t)(request->search.len - index) : (uint16_t)(amp - pair);
+		const char *equal = memchr(pair, '=', pair_len);
+		for (uint8_t ind = 0; equal != NULL && ind < sizeof(keys) / sizeof(*keys); ind++) {
+			if (strlen(keys[ind]) == (size_t)(equal - pair) && memcmp(keys[ind], pair, (size_t)(equal - pair)) == 0) {
+				slow_append(&line, &len, " %.*s", (int)pair_len, pair);
+				break;
+			}
+		}
+		index = (uint16_t)(index + pair_len + 1);
+	}
+
+	slow_append(&line, &len, " files=%u rows=%u bytes=%lu emitted=%u io=%.3fms lock=%.3fms\n", span.files, span.rows, span.bytes,
+							span.emitted, (double)span.io / 1000000, (double)span.lock / 1000000);
+	if (len >= sizeof(line)) {
+		line[sizeof(line) - 2] = '\n';
+	}
+	slow("%s", line);
+}
+
 void handle(octet_t *db, char *request_buffer, char *response_buffer, int *client_sock, struct sockaddr_in *client_addr) {
 	struct request_t reqs;
 	struct response_t resp;
@@ -33,12 +109,18 @@ void handle(octet_t *db, char *request_buffer, char *response_buffer, int *clien
 
 	size_t request_length = 0;
 
+	span_reset();
+	uint64_t received_at = span_clock();
+
 	size_t received_bytes = 0;
 	uint8_t received_packets = 0;
 	ssize_t received =
 			recv(*client_sock, request_buffer,
 					 (size_t)(reqs.method.cap + reqs.pathname.cap + reqs.search.cap + reqs.protocol.cap + reqs.header.cap), 0);
 
+	struct timespec arrived;
+	clock_gettime(CLOCK_REALTIME, &arrived);
+
 	if (received == -1) {
 		error("failed to receive data from client because %s\n", errno_str());
 		goto cleanup;
@@ -51,16 +133,16 @@ void handle(octet_t *db, char *request_buffer, char *response_buffer, int *clien
 	received_bytes += (size_t)received;
 	received_packets++;
 
-	const char *length_index = strncasestrn(request_buffer, received_bytes, "content-length:", 15);
-	const char *body_index = strncasestrn(request_buffer, received_bytes, "\r\n\r\n", 4);
-
-	if (length_index && body_index) {
-		length_index += 15;
-		body_index += 4;
+	uint64_t parsed_at = span_clock();
+	request(request_buffer, received_bytes, &reqs, &resp);
+	span.parse = span_clock() - parsed_at;
 
+	uint16_t length_len = 0;
+	const char *length_index = resp.status == 0 ? header_find(&reqs, "content-length", &length_len) : NULL;
+	if (length_index != NULL) {
 		const size_t content_length = (size_t)atoi(length_index);
 		if (content_length > 0) {
-			request_length = (size_t)(body_index - request_buffer) + content_length;
+			request_length = (size_t)(reqs.body.ptr - request_buffer) + content_length;
 		}
 	}
 
@@ -90,6 +172,12 @@ void handle(octet_t *db, char *request_buffer, char *response_buffer, int *clien
 		received_packets++;
 	}
 
+	span.receive = span_clock() - received_at - span.parse;
+
+	if (capture_file != NULL) {
+		capture_write((uint64_t)arrived.tv_sec * 1000000000 + (uint64_t)arrived.tv_nsec, request_buffer, received_bytes);
+	}
+
 	trace("received %zu bytes in %hhu packets from %s:%d\n", received_bytes, received_packets, inet_ntoa(client_addr->sin_addr),
 				ntohs(client_addr->sin_port));
 
@@ -103,12 +191,26 @@ void handle(octet_t *db, char *request_buffer, char *response_buffer, int *clien
 	char bytes_buffer[8];
 	human_bytes(&bytes_buffer, received_bytes);
 
-	request(request_buffer, received_bytes, &reqs, &resp);
+	if (resp.status == 0) {
+		reqs.body.len = (uint32_t)(received_bytes - (size_t)(reqs.body.ptr - request_buffer));
+	}
 	trace("method %hhub pathname %hhub search %hub header %hub body %ub\n", reqs.method.len, reqs.pathname.len, reqs.search.len,
 				reqs.header.len, reqs.body.len);
 	req("%.*s %.*s %s\n", (int)reqs.method.len, reqs.method.ptr, (int)reqs.pathname.len, reqs.pathname.ptr, bytes_buffer);
 
+	uint64_t routed_at = span_clock();
 	route(db, &reqs, &resp);
+	uint64_t routed = span_clock() - routed_at;
+	uint64_t app = routed > span.auth + span.io ? routed - span.auth - span.io : 0;
+
+	if (slow_file != NULL && routed >= (uint64_t)slow_threshold * 1000000) {
+		slow_request(&reqs, &resp, routed);
+	}
+
+	header_write(&resp,
+							 "server-timing:recv;dur=%.3f,parse;dur=%.3f,auth;dur=%.3f,io;dur=%.3f;desc=\"%u files %u rows %lu bytes\",app;dur=%.3f\r\n",
+							 (double)span.receive / 1000000, (double)span.parse / 1000000, (double)span.auth / 1000000,
+							 (double)span.io / 1000000, span.files, span.rows, span.bytes, (double)app / 1000000);
 
 	size_t response_length = response(&reqs, &resp, response_buffer);
 
@@ -119,60 +221,89 @@ void handle(octet_t *db, char *request_buffer, char *response_buffer, int *clien
 	human_duration(&duration_buffer, &start, &stop);
 	human_bytes(&bytes_buffer, response_length);
 
-	res("%d %s %s\n", resp.status, duration_buffer, bytes_buffer);
-	trace("head %hhub header %hub body %ub\n", resp.head.len, resp.header.len, resp.body.len);
-
-	size_t sent_bytes = 0;
-	uint8_t sent_packets = 0;
-	ssize_t sent = send(*client_sock, response_buffer, resp.head.len + resp.header.len, MSG_NOSIGNAL);
-
-	if (sent == -1) {
-		error("failed to send data to client because %s\n", errno_str());
-		goto cleanup;
+	stats_request(reqs.route, resp.status, elapsed(&start, &stop));
+	trace("head %hhub header %hub body %ub content %zub\n", resp.head.len, resp.header.len, resp.body.len, resp.content_len);
+
+	struct iovec iov[4];
+	uint8_t iov_len = 0;
+	if (resp.preset != NULL) {
+		iov[iov_len++] = (struct iovec){.iov_base = (void *)resp.preset, .iov_len = resp.preset_split};
+		iov[iov_len++] = (struct iovec){.iov_base = resp.header.ptr, .iov_len = resp.header.len};
+		iov[iov_len++] =
+				(struct iovec){.iov_base = (void *)&resp.preset[resp.preset_split], .iov_len = resp.preset_len - resp.preset_split};
+	} else {
+		iov[iov_len++] = (struct iovec){.iov_base = response_buffer, .iov_len = resp.head.len + resp.header.len};
 	}
-	if (sent == 0) {
-		warn("server did not send any data\n");
-		goto cleanup;
+	if (resp.content != NULL) {
+		iov[iov_len++] = (struct iovec){.iov_base = (void *)resp.content, .iov_len = resp.content_len};
+	} else {
+		iov[iov_len++] = (struct iovec){.iov_base = resp.body.ptr, .iov_len = resp.body.len};
 	}
 
-	sent_bytes += (size_t)sent;
-	sent_packets++;
-
-	while ((size_t)sent_bytes < response_length) {
+	uint64_t sent_at = span_clock();
+	size_t sent_bytes = 0;
+	uint8_t sent_packets = 0;
+	uint8_t iov_index = 0;
+	while (sent_bytes < response_length) {
 		if (sent_packets + 1 > send_packets) {
-			warn("packets sent %hhu exceeds allowed packets %hhu\n\n", sent_packets, send_packets);
-			break;
-		}
-
-		if (response_length > send_buffer) {
-			warn("response length %zu exceeds buffer length %u\n", response_length, send_buffer);
+			warn("packets sent %hhu exceeds allowed packets %hhu\n", sent_packets, send_packets);
 			break;
 		}
 
-		ssize_t sent_further = send(*client_sock, &resp.body.ptr[sent_bytes - resp.head.len - resp.header.len],
-																resp.body.len - (sent_bytes - resp.head.len - resp.header.len), MSG_NOSIGNAL);
+		struct msghdr message = {.msg_iov = &iov[iov_index], .msg_iovlen = (size_t)(iov_len - iov_index)};
+		ssize_t sent = sendmsg(*client_sock, &message, MSG_NOSIGNAL);
 
-		if (sent_further == -1) {
-			error("failed to send further data to client because %s\n", errno_str());
+		if (sent == -1) {
+			error("failed to send data to client because %s\n", errno_str());
 			goto cleanup;
 		}
-		if (sent_further == 0) {
-			warn("server did not send any further data\n");
+		if (sent == 0) {
+			warn("server did not send any data\n");
 			goto cleanup;
 		}
 
-		sent_bytes += (size_t)sent_further;
+		sent_bytes += (size_t)sent;
 		sent_packets++;
+
+		size_t advance = (size_t)sent;
+		while (iov_index < iov_len && advance >= iov[iov_index].iov_len) {
+			advance -= iov[iov_index].iov_len;
+			iov_index++;
+		}
+		if (iov_index < iov_len) {
+			iov[iov_index].iov_base = (char *)iov[iov_index].iov_base + advance;
+			iov[iov_index].iov_len -= advance;
+		}
 	}
 
+	span.send = span_clock() - sent_at;
+
 	trace("sent %zu bytes in %hhu packets to %s:%d\n", sent_bytes, sent_packets, inet_ntoa(client_addr->sin_addr),
 				ntohs(client_addr->sin_port));
 
+	char recv_buffer[8];
+	char parse_buffer[8];
+	char auth_buffer[8];
+	char io_buffer[8];
+	char app_buffer[8];
+	char sent_buffer[8];
+	human_nanoseconds(&recv_buffer, span.receive);
+	human_nanoseconds(&parse_buffer, span.parse);
+	human_nanoseconds(&auth_buffer, span.auth);
+	human_nanoseconds(&io_buffer, span.io);
+	human_nanoseconds(&app_buffer, app);
+	human_nanoseconds(&sent_buffer, span.send);
+	res("%d %s %s recv %s parse %s auth %s io %s app %s send %s files %u rows %u\n", resp.status, duration_buffer, bytes_buffer,
+			recv_buffer, parse_buffer, auth_buffer, io_buffer, app_buffer, sent_buffer, span.files, span.rows);
+
 	if (shutdown(*client_sock, SHUT_WR) == -1) {
 		error("failed to shutdown client socket writing because %s\n", errno_str());
 	}
 
 cleanup:
+	if (resp.content_lock != NULL) {
+		pthread_rwlock_unlock(resp.content_lock);
+	}
 	if (close(*client_sock) == -1) {
 		error("failed to close client socket because %s\n", errno_str());
 	}
@@ -0,0 +1,57 @@
+#include "arena.h"
+#include "error.h"
+#include "logger.h"
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+void arena_init(arena_t *arena, uint8_t *ptr, size_t cap) {
+	arena->ptr = ptr;
+	arena->len = 0;
+	arena->cap = cap;
+	arena->chunks = NULL;
+	arena->used = 0;
+	arena->peak = 0;
+}
+
+void *arena_alloc(arena_t *arena, size_t size) {
+	size = (size + _Alignof(max_align_t) - 1) & ~(_Alignof(max_align_t) - 1);
+
+	uint8_t *ptr;
+	if (arena->chunks == NULL && arena->len + size <= arena->cap) {
+		ptr = &arena->ptr[arena->len];
+		arena->len += size;
+	} else if (arena->chunks != NULL && arena->chunks->len + size <= arena->chunks->cap) {
+		ptr = &((uint8_t *)arena->chunks->data)[arena->chunks->len];
+		arena->chunks->len += size;
+	} else {
+		size_t cap = size > arena->cap ? size : arena->cap;
+		arena_chunk_t *chunk = malloc(sizeof(*chunk) + cap);
+		if (chunk == NULL) {
+			error("failed to allocate %zu bytes because %s\n", sizeof(*chunk) + cap, errno_str());
+			return NULL;
+		}
+		debug("arena grew by chunk of %zu bytes\n", cap);
+		chunk->next = arena->chunks;
+		chunk->len = size;
+		chunk->cap = cap;
+		arena->chunks = chunk;
+		ptr = (uint8_t *)chunk->data;
+	}
+
+	arena->used += size;
+	if (arena->used > arena->peak) {
+		arena->peak = arena->used;
+	}
+	return ptr;
+}
+
+void arena_reset(arena_t *arena) {
+	while (arena->chunks != NULL) {
+		arena_chunk_t *chunk = arena->chunks;
+		arena->chunks = chunk->next;
+		free(chunk);
+	}
+	arena->len = 0;
+	arena->used = 0;
+}
@@ -0,0 +1,24 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+typedef struct arena_chunk_t {
+	struct arena_chunk_t *next;
+	size_t len;
+	size_t cap;
+	max_align_t data[];
+} arena_chunk_t;
+
+typedef struct arena_t {
+	uint8_t *ptr;
+	size_t len;
+	size_t cap;
+	arena_chunk_t *chunks;
+	size_t used;
+	size_t peak;
+} arena_t;
+
+void arena_init(arena_t *arena, uint8_t *ptr, size_t cap);
+void *arena_alloc(arena_t *arena, size_t size);
+void arena_reset(arena_t *arena);
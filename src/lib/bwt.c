@@ -7,9 +7,13 @@
 #include "sha256.h"
 #include "string.h"
 #include "strn.h"
+#include <stdatomic.h>
+#include <stdbool.h>
 #include <stdint.h>
 #include <time.h>
 
+bwt_entry_t bwt_cache[256];
+
 int bwt_sign(char (*buffer)[103], uint8_t (*id)[8], uint8_t (*data)[8]) {
 	const time_t iat = time(NULL);
 	const time_t exp = iat + bwt_ttl;
@@ -37,6 +41,59 @@ int bwt_sign(char (*buffer)[103], uint8_t (*id)[8], uint8_t (*data)[8]) {
 	return 0;
 }
 
+uint32_t bwt_hash(const char *token, size_t token_len) {
+	uint32_t hash = 2166136261;
+	for (size_t index = 0; index < token_len; index++) {
+		hash ^= (uint8_t)token[index];
+		hash *= 16777619;
+	}
+	return hash;
+}
+
+bool bwt_recall(const char *token, size_t token_len, uint32_t hash, time_t now, bwt_t *bwt) {
+	const uint8_t mask = sizeof(bwt_cache) / sizeof(*bwt_cache) - 1;
+	for (uint8_t way = 0; way < 2; way++) {
+		bwt_entry_t *entry = &bwt_cache[(hash + way) & mask];
+		unsigned seq = atomic_load_explicit(&entry->seq, memory_order_acquire);
+		if (seq & 1) {
+			continue;
+		}
+
+		bool hit = entry->token_len == token_len && memcmp(entry->token, token, token_len) == 0;
+		bwt_t recalled = entry->bwt;
+		atomic_thread_fence(memory_order_acquire);
+		if (atomic_load_explicit(&entry->seq, memory_order_relaxed) != seq) {
+			continue;
+		}
+
+		if (hit == true && recalled.exp >= now) {
+			*bwt = recalled;
+			return true;
+		}
+	}
+	return false;
+}
+
+void bwt_remember(const char *token, size_t token_len, uint32_t hash, time_t now, bwt_t *bwt) {
+	const uint8_t mask = sizeof(bwt_cache) / sizeof(*bwt_cache) - 1;
+	bwt_entry_t *entry = &bwt_cache[hash & mask];
+	bwt_entry_t *other = &bwt_cache[(hash + 1) & mask];
+	if (entry->token_len != 0 && entry->bwt.exp >= now && (other->token_len == 0 || other->bwt.exp < entry->bwt.exp)) {
+		entry = other;
+	}
+
+	unsigned seq = atomic_load_explicit(&entry->seq, memory_order_relaxed);
+	if (seq & 1 || atomic_compare_exchange_strong_explicit(&entry->seq, &seq, seq + 1, memory_order_acquire,
+																												 memory_order_relaxed) == false) {
+		return;
+	}
+
+	entry->token_len = (uint8_t)token_len;
+	memcpy(entry->token, token, token_len);
+	entry->bwt = *bwt;
+	atomic_store_explicit(&entry->seq, seq + 2, memory_order_release);
+}
+
 int bwt_verify(const char *cookie, const size_t cookie_len, bwt_t *bwt) {
 	const char *buffer;
 	size_t buffer_len;
@@ -45,6 +102,12 @@ int bwt_verify(const char *cookie, const size_t cookie_len, bwt_t *bwt) {
 		return -1;
 	}
 
+	time_t now = time(NULL);
+	uint32_t hash = bwt_hash(buffer, buffer_len);
+	if (bwt_recall(buffer, buffer_len, hash, now, bwt) == true) {
+		return 0;
+	}
+
 	uint8_t binary[64];
 	if (base32_decode(binary, sizeof(binary), buffer, buffer_len) == -1) {
 		error("failed to decode bwt from base 32\n");
@@ -72,7 +135,6 @@ int bwt_verify(const char *cookie, const size_t cookie_len, bwt_t *bwt) {
 	bwt->iat = (time_t)ntoh64((uint64_t)bwt->iat);
 	bwt->exp = (time_t)ntoh64((uint64_t)bwt->exp);
 
-	time_t now = time(NULL);
 	if (bwt->exp < now) {
 		char time_buffer[8];
 		human_time(&time_buffer, now - bwt->exp);
@@ -80,5 +142,7 @@ int bwt_verify(const char *cookie, const size_t cookie_len, bwt_t *bwt) {
 		return -1;
 	}
 
+	bwt_remember(buffer, buffer_len, hash, now, bwt);
+
 	return 0;
 }
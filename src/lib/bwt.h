@@ -1,5 +1,6 @@
 #pragma once
 
+#include <stdatomic.h>
 #include <stdint.h>
 #include <time.h>
 
@@ -10,5 +11,14 @@ typedef struct bwt_t {
 	uint8_t data[8];
 } bwt_t;
 
+typedef struct bwt_entry_t {
+	atomic_uint seq;
+	uint8_t token_len;
+	char token[103];
+	bwt_t bwt;
+} bwt_entry_t;
+
+extern bwt_entry_t bwt_cache[256];
+
 int bwt_sign(char (*buffer)[103], uint8_t (*id)[8], uint8_t (*data)[8]);
 int bwt_verify(const char *cookie, const size_t cookie_len, bwt_t *bwt);
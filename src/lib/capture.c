@@ -0,0 +1,45 @@
+#include "capture.h"
+#include "endian.h"
+#include <stdint.h>
+#include <stdio.h>
+
+FILE *capture_file = NULL;
+
+const char capture_magic[8] = {'w', 'c', 'a', 'p', 0x00, 0x00, 0x00, 0x01};
+
+int capture_open(const char *path) {
+	capture_file = fopen(path, "a");
+	if (capture_file == NULL) {
+		return -1;
+	}
+
+	if (ftell(capture_file) == 0 && fwrite(capture_magic, sizeof(capture_magic), 1, capture_file) != 1) {
+		fclose(capture_file);
+		capture_file = NULL;
+		return -1;
+	}
+
+	return 0;
+}
+
+void capture_write(uint64_t arrived_at, const char *buffer, size_t buffer_len) {
+	if (capture_file == NULL) {
+		return;
+	}
+
+	uint64_t arrived = hton64(arrived_at);
+	uint32_t length = hton32((uint32_t)buffer_len);
+	flockfile(capture_file);
+	fwrite(&arrived, sizeof(arrived), 1, capture_file);
+	fwrite(&length, sizeof(length), 1, capture_file);
+	fwrite(buffer, buffer_len, 1, capture_file);
+	fflush(capture_file);
+	funlockfile(capture_file);
+}
+
+void capture_close(void) {
+	if (capture_file != NULL) {
+		fclose(capture_file);
+		capture_file = NULL;
+	}
+}
@@ -0,0 +1,12 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+
+extern FILE *capture_file;
+extern const char capture_magic[8];
+
+int capture_open(const char *path);
+void capture_write(uint64_t arrived_at, const char *buffer, size_t buffer_len);
+void capture_close(void);
@@ -18,9 +18,14 @@ bool emit_alerts = false;
 uint8_t alert_interval = 60;
 uint32_t alert_lookback = 604800;
 
+bool defer_decode = false;
+uint16_t decode_backlog = 1024;
+
 uint8_t devices_size = 64;
 uint8_t zones_size = 16;
 
+bool watch_pages = true;
+
 const char *bwt_key = "w77a61r72d64e65n6e";
 uint32_t bwt_ttl = 2764800;
 
@@ -38,6 +43,17 @@ uint8_t log_level = 4;
 bool log_requests = true;
 bool log_responses = true;
 
+const char *slow_log = "";
+uint16_t slow_threshold = 500;
+
+const char *capture = "";
+
+const char *bundle_file = "";
+
+uint16_t seed_devices = 0;
+uint16_t seed_days = 2;
+uint16_t seed_cadence = 60;
+
 bool match_arg(const char *flag, const char *verbose, const char *concise) {
 	return strcmp(flag, verbose) == 0 || strcmp(flag, concise) == 0;
 }
@@ -173,6 +189,11 @@ int parse_log_level(const char *arg, uint8_t *value) {
 		return 1;
 	}
 
+	if (*value > log_floor) {
+		warn("log level %s is not compiled into this build\n", arg);
+		*value = log_floor;
+	}
+
 	return 0;
 }
 
@@ -181,7 +202,11 @@ int configure(int argc, char *argv[], uint8_t *cmds) {
 
 	for (int ind = 1; ind < argc; ind++) {
 		const char *flag = argv[ind];
-		if (match_arg(flag, "--init", "-i")) {
+		if (match_arg(flag, "--bundle", "-bd")) {
+			*cmds |= 0x08;
+			const char *value = next_arg(argc, argv, &ind);
+			errors += parse_str(value, "bundle", 1, 128, &bundle_file);
+		} else if (match_arg(flag, "--init", "-i")) {
 			*cmds |= 0x10;
 		} else if (match_arg(flag, "--seed", "-s")) {
 			*cmds |= 0x20;
@@ -219,12 +244,21 @@ int configure(int argc, char *argv[], uint8_t *cmds) {
 		} else if (match_arg(flag, "--alert-lookback", "-al")) {
 			const char *value = next_arg(argc, argv, &ind);
 			errors += parse_uint32(value, "alert lookback", 86400, 2592000, &alert_lookback);
+		} else if (match_arg(flag, "--defer-decode", "-dc")) {
+			const char *value = next_arg(argc, argv, &ind);
+			errors += parse_bool(value, "defer decode", &defer_decode);
+		} else if (match_arg(flag, "--decode-backlog", "-dq")) {
+			const char *value = next_arg(argc, argv, &ind);
+			errors += parse_uint16(value, "decode backlog", 16, 16384, &decode_backlog);
 		} else if (match_arg(flag, "--devices-size", "-ds")) {
 			const char *value = next_arg(argc, argv, &ind);
 			errors += parse_uint8(value, "devices size", 4, 128, &devices_size);
 		} else if (match_arg(flag, "--zones-size", "-zs")) {
 			const char *value = next_arg(argc, argv, &ind);
 			errors += parse_uint8(value, "zones size", 2, 32, &zones_size);
+		} else if (match_arg(flag, "--watch-pages", "-wp")) {
+			const char *value = next_arg(argc, argv, &ind);
+			errors += parse_bool(value, "watch pages", &watch_pages);
 		} else if (match_arg(flag, "--bwt-key", "-bk")) {
 			const char *value = next_arg(argc, argv, &ind);
 			errors += parse_str(value, "bwt key", 16, 64, &bwt_key);
@@ -236,7 +270,7 @@ int configure(int argc, char *argv[], uint8_t *cmds) {
 			errors += parse_str(value, "database directory", 4, 64, &database_directory);
 		} else if (match_arg(flag, "--database-buffer", "-db")) {
 			const char *value = next_arg(argc, argv, &ind);
-			errors += parse_uint32(value, "database buffer", 16384, 1048576, &database_buffer);
+			errors += parse_uint32(value, "database buffer", 4096, 1048576, &database_buffer);
 		} else if (match_arg(flag, "--receive-timeout", "-rt")) {
 			const char *value = next_arg(argc, argv, &ind);
 			errors += parse_uint8(value, "receive timeout", 2, 240, &receive_timeout);
@@ -264,6 +298,24 @@ int configure(int argc, char *argv[], uint8_t *cmds) {
 		} else if (match_arg(flag, "--log-responses", "-ls")) {
 			const char *value = next_arg(argc, argv, &ind);
 			errors += parse_bool(value, "log responses", &log_responses);
+		} else if (match_arg(flag, "--slow-log", "-sl")) {
+			const char *value = next_arg(argc, argv, &ind);
+			errors += parse_str(value, "slow log", 1, 128, &slow_log);
+		} else if (match_arg(flag, "--slow-threshold", "-sq")) {
+			const char *value = next_arg(argc, argv, &ind);
+			errors += parse_uint16(value, "slow threshold", 0, 60000, &slow_threshold);
+		} else if (match_arg(flag, "--seed-devices", "-sd")) {
+			const char *value = next_arg(argc, argv, &ind);
+			errors += parse_uint16(value, "seed devices", 0, 8192, &seed_devices);
+		} else if (match_arg(flag, "--seed-days", "-sy")) {
+			const char *value = next_arg(argc, argv, &ind);
+			errors += parse_uint16(value, "seed days", 1, 3650, &seed_days);
+		} else if (match_arg(flag, "--seed-cadence", "-sc")) {
+			const char *value = next_arg(argc, argv, &ind);
+			errors += parse_uint16(value, "seed cadence", 1, 3600, &seed_cadence);
+		} else if (match_arg(flag, "--capture", "-cp")) {
+			const char *value = next_arg(argc, argv, &ind);
+			errors += parse_str(value, "capture", 1, 128, &capture);
 		} else {
 			errors++;
 			error("unknown argument %s\n", flag);
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <stdbool.h>
+#include <stddef.h>
 #include <stdint.h>
 
 extern const char *name;
@@ -17,9 +18,14 @@ extern bool emit_alerts;
 extern uint8_t alert_interval;
 extern uint32_t alert_lookback;
 
+extern bool defer_decode;
+extern uint16_t decode_backlog;
+
 extern uint8_t devices_size;
 extern uint8_t zones_size;
 
+extern bool watch_pages;
+
 extern const char *bwt_key;
 extern uint32_t bwt_ttl;
 
@@ -37,4 +43,23 @@ extern uint8_t log_level;
 extern bool log_requests;
 extern bool log_responses;
 
+extern const char *slow_log;
+extern uint16_t slow_threshold;
+
+extern const char *capture;
+
+extern const char *bundle_file;
+
+extern uint16_t seed_devices;
+extern uint16_t seed_days;
+extern uint16_t seed_cadence;
+
+bool match_arg(const char *flag, const char *verbose, const char *concise);
+const char *next_arg(const int argc, char *argv[], int *ind);
+int parse_bool(const char *arg, const char *key, bool *value);
+int parse_uint8(const char *arg, const char *key, const uint8_t min, const uint8_t max, uint8_t *value);
+int parse_uint16(const char *arg, const char *key, const uint16_t min, const uint16_t max, uint16_t *value);
+int parse_uint32(const char *arg, const char *key, const uint32_t min, const uint32_t max, uint32_t *value);
+int parse_str(const char *arg, const char *key, size_t min, size_t max, const char **value);
+
 int configure(int argc, char *argv[], uint8_t *cmds);
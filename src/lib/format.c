@@ -47,10 +47,7 @@ void human_bytes(char (*buffer)[8], size_t bytes) {
 	}
 }
 
-void human_duration(char (*buffer)[8], struct timespec *start, struct timespec *stop) {
-	time_t start_nanoseconds = start->tv_sec * 1000000000 + start->tv_nsec;
-	time_t stop_nanoseconds = stop->tv_sec * 1000000000 + stop->tv_nsec;
-	time_t nanoseconds = stop_nanoseconds - start_nanoseconds;
+void human_nanoseconds(char (*buffer)[8], uint64_t nanoseconds) {
 	if (nanoseconds < 1000) {
 		sprintf(*buffer, "%luns", nanoseconds);
 	} else if (nanoseconds < 10000) {
@@ -68,6 +65,12 @@ void human_duration(char (*buffer)[8], struct timespec *start, struct timespec *
 	}
 }
 
+void human_duration(char (*buffer)[8], struct timespec *start, struct timespec *stop) {
+	time_t start_nanoseconds = start->tv_sec * 1000000000 + start->tv_nsec;
+	time_t stop_nanoseconds = stop->tv_sec * 1000000000 + stop->tv_nsec;
+	human_nanoseconds(buffer, (uint64_t)(stop_nanoseconds - start_nanoseconds));
+}
+
 void human_time(char (*buffer)[8], time_t seconds) {
 	if (seconds < 60) {
 		sprintf(*buffer, "%lus", seconds);
@@ -0,0 +1,459 @@
+#include "gzip.h"
+#include "error.h"
+#include "logger.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define deflate_window 32768
+#define deflate_chain 128
+
+typedef struct deflate_bits_t {
+	uint8_t *ptr;
+	size_t len;
+	size_t cap;
+	uint64_t bits;
+	uint8_t bits_len;
+	bool overflow;
+} deflate_bits_t;
+
+const uint16_t deflate_length_base[29] = {3,  4,  5,  6,  7,  8,  9,  10, 11,  13,  15,  17,  19,  23, 27,
+																					31, 35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258};
+const uint8_t deflate_length_extra[29] = {0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2, 3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0};
+const uint16_t deflate_distance_base[30] = {1,   2,   3,   4,   5,   7,    9,    13,   17,   25,   33,   49,   65,    97,    129,
+																						193, 257, 385, 513, 769, 1025, 1537, 2049, 3073, 4097, 6145, 8193, 12289, 16385, 24577};
+const uint8_t deflate_distance_extra[30] = {0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6, 7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13};
+const uint8_t deflate_code_order[19] = {16, 17, 18, 0, 8, 7, 9, 6, 10, 5, 11, 4, 12, 3, 13, 2, 14, 1, 15};
+
+void deflate_put(deflate_bits_t *bits, uint32_t value, uint8_t value_len) {
+	bits->bits |= (uint64_t)value << bits->bits_len;
+	bits->bits_len += value_len;
+	while (bits->bits_len >= 8) {
+		if (bits->len < bits->cap) {
+			bits->ptr[bits->len] = (uint8_t)bits->bits;
+			bits->len += 1;
+		} else {
+			bits->overflow = true;
+		}
+		bits->bits >>= 8;
+		bits->bits_len -= 8;
+	}
+}
+
+void deflate_flush(deflate_bits_t *bits) {
+	if (bits->bits_len > 0) {
+		deflate_put(bits, 0, (uint8_t)(8 - bits->bits_len));
+	}
+}
+
+void deflate_tree(const uint32_t *freqs, uint16_t symbols, uint8_t *lengths) {
+	uint32_t weights[572];
+	uint16_t parents[572];
+	bool active[572];
+	uint16_t nodes = symbols;
+
+	uint16_t used = 0;
+	for (uint16_t index = 0; index < symbols; index++) {
+		weights[index] = freqs[index];
+		active[index] = freqs[index] > 0;
+		parents[index] = 0;
+		lengths[index] = 0;
+		if (freqs[index] > 0) {
+			used += 1;
+		}
+	}
+
+	if (used == 0) {
+		return;
+	}
+	if (used == 1) {
+		for (uint16_t index = 0; index < symbols; index++) {
+			if (freqs[index] > 0) {
+				lengths[index] = 1;
+				lengths[index == 0 ? 1 : 0] = 1;
+			}
+		}
+		return;
+	}
+
+	while (used > 1) {
+		int32_t first = -1;
+		int32_t second = -1;
+		for (uint16_t index = 0; index < nodes; index++) {
+			if (active[index] == false) {
+				continue;
+			}
+			if (first == -1 || weights[index] < weights[first]) {
+				second = first;
+				first = index;
+			} else if (second == -1 || weights[index] < weights[second]) {
+				second = index;
+			}
+		}
+		weights[nodes] = weights[first] + weights[second];
+		active[nodes] = true;
+		parents[nodes] = 0;
+		active[first] = false;
+		active[second] = false;
+		parents[first] = nodes;
+		parents[second] = nodes;
+		nodes += 1;
+		used -= 1;
+	}
+
+	for (uint16_t index = 0; index < symbols; index++) {
+		if (freqs[index] == 0) {
+			continue;
+		}
+		uint8_t depth = 0;
+		for (uint16_t node = index; node != nodes - 1; node = parents[node]) {
+			depth += 1;
+		}
+		lengths[index] = depth;
+	}
+}
+
+void deflate_lengths(const uint32_t *freqs, uint16_t symbols, uint8_t limit, uint8_t *lengths) {
+	uint32_t scaled[286];
+	memcpy(scaled, freqs, symbols * sizeof(*freqs));
+
+	while (true) {
+		deflate_tree(scaled, symbols, lengths);
+		uint8_t longest = 0;
+		for (uint16_t index = 0; index < symbols; index++) {
+			if (lengths[index] > longest) {
+				longest = lengths[index];
+			}
+		}
+		if (longest <= limit) {
+			return;
+		}
+		for (uint16_t index = 0; index < symbols; index++) {
+			scaled[index] = (scaled[index] + 1) / 2;
+		}
+	}
+}
+
+void deflate_codes(const uint8_t *lengths, uint16_t symbols, uint16_t *codes) {
+	uint16_t counts[16] = {0};
+	for (uint16_t index = 0; index < symbols; index++) {
+		counts[lengths[index]] += 1;
+	}
+	counts[0] = 0;
+
+	uint16_t next[16] = {0};
+	uint16_t code = 0;
+	for (uint8_t bits = 1; bits < 16; bits++) {
+		code = (uint16_t)((code + counts[bits - 1]) << 1);
+		next[bits] = code;
+	}
+
+	for (uint16_t index = 0; index < symbols; index++) {
+		codes[index] = 0;
+		if (lengths[index] == 0) {
+			continue;
+		}
+		uint16_t value = next[lengths[index]];
+		next[lengths[index]] += 1;
+		uint16_t reversed = 0;
+		for (uint8_t bit = 0; bit < lengths[index]; bit++) {
+			reversed = (uint16_t)((reversed << 1) | ((value >> bit) & 1));
+		}
+		codes[index] = reversed;
+	}
+}
+
+uint8_t deflate_length_code(uint16_t length) {
+	uint8_t code = 0;
+	while (code < 28 && deflate_length_base[code + 1] <= length) {
+		code += 1;
+	}
+	return code;
+}
+
+uint8_t deflate_distance_code(uint16_t distance) {
+	uint8_t code = 0;
+	while (code < 29 && deflate_distance_base[code + 1] <= distance) {
+		code += 1;
+	}
+	return code;
+}
+
+uint32_t deflate_hash(const uint8_t *data) { return ((uint32_t)data[0] << 10 ^ (uint32_t)data[1] << 5 ^ data[2]) & 0x7fff; }
+
+uint16_t deflate_match(const uint8_t *data, size_t data_len, size_t pos, uint32_t *heads, uint32_t *prevs, uint16_t *distance) {
+	uint16_t best = 0;
+	size_t most = data_len - pos < 258 ? data_len - pos : 258;
+	if (most < 3) {
+		return 0;
+	}
+
+	uint32_t candidate = heads[deflate_hash(&data[pos])];
+	uint8_t chain = deflate_chain;
+	while (candidate != UINT32_MAX && candidate < pos && pos - candidate <= deflate_window && chain > 0) {
+		if (data[candidate + best] == data[pos + best]) {
+			uint16_t length = 0;
+			while (length < most && data[candidate + length] == data[pos + length]) {
+				length += 1;
+			}
+			if (length > best) {
+				best = length;
+				*distance = (uint16_t)(pos - candidate);
+				if (length == most) {
+					break;
+				}
+			}
+		}
+		uint32_t next = prevs[candidate & (deflate_window - 1)];
+		if (next >= candidate) {
+			break;
+		}
+		candidate = next;
+		chain -= 1;
+	}
+
+	return best >= 3 ? best : 0;
+}
+
+void deflate_insert(const uint8_t *data, size_t data_len, size_t pos, uint32_t *heads, uint32_t *prevs) {
+	if (pos + 2 >= data_len) {
+		return;
+	}
+	uint32_t hash = deflate_hash(&data[pos]);
+	prevs[pos & (deflate_window - 1)] = heads[hash];
+	heads[hash] = (uint32_t)pos;
+}
+
+size_t deflate_tokenize(const uint8_t *data, size_t data_len, uint32_t *tokens, uint32_t *heads, uint32_t *prevs) {
+	size_t tokens_len = 0;
+	size_t pos = 0;
+
+	while (pos < data_len) {
+		uint16_t distance = 0;
+		uint16_t length = deflate_match(data, data_len, pos, heads, prevs, &distance);
+		deflate_insert(data, data_len, pos, heads, prevs);
+
+		if (length != 0 && length < 258 && pos + 1 < data_len) {
+			uint16_t next_distance = 0;
+			uint16_t next_length = deflate_match(data, data_len, pos + 1, heads, prevs, &next_distance);
+			if (next_length > length) {
+				tokens[tokens_len++] = data[pos];
+				pos += 1;
+				deflate_insert(data, data_len, pos, heads, prevs);
+				length = next_length;
+				distance = next_distance;
+			}
+		}
+
+		if (length == 0) {
+			tokens[tokens_len++] = data[pos];
+			pos += 1;
+			continue;
+		}
+
+		tokens[tokens_len++] = 0x80000000 | (uint32_t)length << 16 | distance;
+		for (size_t index = 1; index < length; index++) {
+			deflate_insert(data, data_len, pos + index, heads, prevs);
+		}
+		pos += length;
+	}
+
+	return tokens_len;
+}
+
+void deflate_block(deflate_bits_t *bits, const uint32_t *tokens, size_t tokens_len) {
+	uint32_t literal_freqs[286] = {0};
+	uint32_t distance_freqs[30] = {0};
+	for (size_t index = 0; index < tokens_len; index++) {
+		if (tokens[index] & 0x80000000) {
+			literal_freqs[257 + deflate_length_code((uint16_t)(tokens[index] >> 16 & 0x1ff))] += 1;
+			distance_freqs[deflate_distance_code((uint16_t)(tokens[index] & 0xffff))] += 1;
+		} else {
+			literal_freqs[tokens[index]] += 1;
+		}
+	}
+	literal_freqs[256] = 1;
+	uint32_t distance_total = 0;
+	for (uint8_t index = 0; index < 30; index++) {
+		distance_total += distance_freqs[index];
+	}
+	if (distance_total == 0) {
+		distance_freqs[0] = 1;
+	}
+
+	uint8_t literal_lengths[286];
+	uint8_t distance_lengths[30];
+	uint16_t literal_codes[286];
+	uint16_t distance_codes[30];
+	deflate_lengths(literal_freqs, 286, 15, literal_lengths);
+	deflate_lengths(distance_freqs, 30, 15, distance_lengths);
+	deflate_codes(literal_lengths, 286, literal_codes);
+	deflate_codes(distance_lengths, 30, distance_codes);
+
+	uint16_t literals = 286;
+	while (literals > 257 && literal_lengths[literals - 1] == 0) {
+		literals -= 1;
+	}
+	uint8_t distances = 30;
+	while (distances > 1 && distance_lengths[distances - 1] == 0) {
+		distances -= 1;
+	}
+
+	uint8_t lengths[316];
+	uint16_t lengths_len = 0;
+	memcpy(&lengths[lengths_len], literal_lengths, literals);
+	lengths_len += literals;
+	memcpy(&lengths[lengths_len], distance_lengths, distances);
+	lengths_len += distances;
+
+	uint8_t runs[316];
+	uint8_t extras[316];
+	uint16_t runs_len = 0;
+	uint32_t run_freqs[19] = {0};
+	for (uint16_t index = 0; index < lengths_len;) {
+		uint8_t length = lengths[index];
+		uint16_t run = 1;
+		while (index + run < lengths_len && lengths[index + run] == length) {
+			run += 1;
+		}
+		index += run;
+
+		if (length == 0) {
+			while (run >= 11) {
+				uint16_t take = run < 138 ? run : 138;
+				runs[runs_len] = 18;
+				extras[runs_len++] = (uint8_t)(take - 11);
+				run -= take;
+			}
+			if (run >= 3) {
+				runs[runs_len] = 17;
+				extras[runs_len++] = (uint8_t)(run - 3);
+				run = 0;
+			}
+		} else {
+			runs[runs_len] = length;
+			extras[runs_len++] = 0;
+			run -= 1;
+			while (run >= 3) {
+				uint16_t take = run < 6 ? run : 6;
+				runs[runs_len] = 16;
+				extras[runs_len++] = (uint8_t)(take - 3);
+				run -= take;
+			}
+		}
+		while (run > 0) {
+			runs[runs_len] = length;
+			extras[runs_len++] = 0;
+			run -= 1;
+		}
+	}
+	for (uint16_t index = 0; index < runs_len; index++) {
+		run_freqs[runs[index]] += 1;
+	}
+
+	uint8_t run_lengths[19];
+	uint16_t run_codes[19];
+	deflate_lengths(run_freqs, 19, 7, run_lengths);
+	deflate_codes(run_lengths, 19, run_codes);
+
+	uint8_t orders = 19;
+	while (orders > 4 && run_lengths[deflate_code_order[orders - 1]] == 0) {
+		orders -= 1;
+	}
+
+	deflate_put(bits, 1, 1);
+	deflate_put(bits, 2, 2);
+	deflate_put(bits, (uint32_t)(literals - 257), 5);
+	deflate_put(bits, (uint32_t)(distances - 1), 5);
+	deflate_put(bits, (uint32_t)(orders - 4), 4);
+	for (uint8_t index = 0; index < orders; index++) {
+		deflate_put(bits, run_lengths[deflate_code_order[index]], 3);
+	}
+	for (uint16_t index = 0; index < runs_len; index++) {
+		deflate_put(bits, run_codes[runs[index]], run_lengths[runs[index]]);
+		if (runs[index] == 16) {
+			deflate_put(bits, extras[index], 2);
+		} else if (runs[index] == 17) {
+			deflate_put(bits, extras[index], 3);
+		} else if (runs[index] == 18) {
+			deflate_put(bits, extras[index], 7);
+		}
+	}
+
+	for (size_t index = 0; index < tokens_len; index++) {
+		if (tokens[index] & 0x80000000) {
+			uint16_t length = (uint16_t)(tokens[index] >> 16 & 0x1ff);
+			uint16_t distance = (uint16_t)(tokens[index] & 0xffff);
+			uint8_t length_code = deflate_length_code(length);
+			uint8_t distance_code = deflate_distance_code(distance);
+			deflate_put(bits, literal_codes[257 + length_code], literal_lengths[257 + length_code]);
+			deflate_put(bits, (uint32_t)(length - deflate_length_base[length_code]), deflate_length_extra[length_code]);
+			deflate_put(bits, distance_codes[distance_code], distance_lengths[distance_code]);
+			deflate_put(bits, (uint32_t)(distance - deflate_distance_base[distance_code]), deflate_distance_extra[distance_code]);
+		} else {
+			deflate_put(bits, literal_codes[tokens[index]], literal_lengths[tokens[index]]);
+		}
+	}
+	deflate_put(bits, literal_codes[256], literal_lengths[256]);
+	deflate_flush(bits);
+}
+
+uint32_t gzip_crc32(const uint8_t *data, size_t data_len) {
+	uint32_t crc = 0xffffffff;
+	for (size_t index = 0; index < data_len; index++) {
+		crc ^= data[index];
+		for (uint8_t bit = 0; bit < 8; bit++) {
+			crc = (crc >> 1) ^ (0xedb88320 & (0 - (crc & 1)));
+		}
+	}
+	return ~crc;
+}
+
+int gzip(const char *data, size_t data_len, char **buffer, size_t *buffer_len) {
+	int status = -1;
+
+	uint32_t *tokens = malloc((data_len + 1) * sizeof(*tokens));
+	uint32_t *heads = malloc(deflate_window * sizeof(*heads));
+	uint32_t *prevs = malloc(deflate_window * sizeof(*prevs));
+	uint8_t *ptr = malloc(data_len);
+	if (tokens == NULL || heads == NULL || prevs == NULL || ptr == NULL) {
+		error("failed to allocate buffers to compress %zu bytes because %s\n", data_len, errno_str());
+		free(ptr);
+		goto cleanup;
+	}
+	memset(heads, 0xff, deflate_window * sizeof(*heads));
+	memset(prevs, 0xff, deflate_window * sizeof(*prevs));
+
+	deflate_bits_t bits = {.ptr = ptr, .len = 0, .cap = data_len, .bits = 0, .bits_len = 0, .overflow = false};
+	const uint8_t header[10] = {0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x03};
+	for (uint8_t index = 0; index < sizeof(header); index++) {
+		deflate_put(&bits, header[index], 8);
+	}
+
+	size_t tokens_len = deflate_tokenize((const uint8_t *)data, data_len, tokens, heads, prevs);
+	deflate_block(&bits, tokens, tokens_len);
+
+	uint32_t crc = gzip_crc32((const uint8_t *)data, data_len);
+	deflate_put(&bits, crc & 0xffff, 16);
+	deflate_put(&bits, crc >> 16, 16);
+	deflate_put(&bits, (uint32_t)data_len & 0xffff, 16);
+	deflate_put(&bits, (uint32_t)data_len >> 16, 16);
+
+	if (bits.overflow == true) {
+		debug("compressed length exceeds original length %zu\n", data_len);
+		free(ptr);
+		goto cleanup;
+	}
+
+	*buffer = (char *)ptr;
+	*buffer_len = bits.len;
+	status = 0;
+
+cleanup:
+	free(tokens);
+	free(heads);
+	free(prevs);
+	return status;
+}
@@ -0,0 +1,5 @@
+#pragma once
+
+#include <stddef.h>
+
+int gzip(const char *data, size_t data_len, char **buffer, size_t *buffer_len);
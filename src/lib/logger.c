@@ -1,7 +1,14 @@
+#include "logger.h"
 #include "config.h"
+#include <errno.h>
+#include <pthread.h>
 #include <stdarg.h>
+#include <stdatomic.h>
+#include <stdbool.h>
 #include <stdint.h>
 #include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
 #include <time.h>
 #include <unistd.h>
 
@@ -15,6 +22,55 @@ static const char *bold = "\x1b[1m";
 static const char *normal = "\x1b[22m";
 static const char *reset = "\x1b[39m";
 
+pthread_t scribe_thread;
+FILE *slow_file = NULL;
+atomic_bool scribing = false;
+
+const uint8_t logger_threads = 8;
+
+ring_t **rings = NULL;
+uint16_t rings_size = 0;
+atomic_uint_fast16_t rings_len = 0;
+atomic_uint_fast32_t rings_dropped = 0;
+atomic_uint_fast64_t records_seq = 0;
+pthread_mutex_t rings_lock = PTHREAD_MUTEX_INITIALIZER;
+pthread_mutex_t drain_lock = PTHREAD_MUTEX_INITIALIZER;
+pthread_key_t ring_key;
+
+_Thread_local ring_t *ring_own = NULL;
+_Thread_local bool ring_failed = false;
+_Thread_local bool ring_busy = false;
+_Thread_local time_t clock_second = -1;
+_Thread_local char clock_buffer[9];
+
+void ring_release(void *ring) { atomic_store_explicit(&((ring_t *)ring)->owned, false, memory_order_release); }
+
+ring_t *ring_claim(void) {
+	pthread_mutex_lock(&rings_lock);
+	ring_t *ring = NULL;
+	uint16_t len = (uint16_t)atomic_load_explicit(&rings_len, memory_order_relaxed);
+	for (uint16_t index = 0; index < len && ring == NULL; index++) {
+		bool owned = false;
+		if (atomic_compare_exchange_strong(&rings[index]->owned, &owned, true) == true) {
+			ring = rings[index];
+		}
+	}
+	if (ring == NULL && len < rings_size) {
+		ring = calloc(1, sizeof(*ring));
+		if (ring != NULL) {
+			atomic_store_explicit(&ring->owned, true, memory_order_relaxed);
+			rings[len] = ring;
+			atomic_store_explicit(&rings_len, len + 1, memory_order_release);
+		}
+	}
+	pthread_mutex_unlock(&rings_lock);
+
+	if (ring != NULL) {
+		pthread_setspecific(ring_key, ring);
+	}
+	return ring;
+}
+
 void logger_init(void) {
 	if (isatty(fileno(stdout)) == 0 || isatty(fileno(stderr)) == 0) {
 		purple = "";
@@ -27,30 +83,217 @@ void logger_init(void) {
 		normal = "";
 		reset = "";
 	}
+
+	pthread_key_create(&ring_key, &ring_release);
+	atexit(&logger_flush);
 }
 
 void timestamp(char (*buffer)[9]) {
 	time_t now = time(NULL);
-	time_t elapsed = now % 86400;
-	uint8_t seconds = (uint8_t)(elapsed % 60);
-	uint8_t minutes = (uint8_t)(elapsed / 60 % 60);
-	uint8_t hours = (uint8_t)(elapsed / 3600);
-	(*buffer)[0] = (char)(hours / 10 + '0');
-	(*buffer)[1] = (char)(hours % 10 + '0');
-	(*buffer)[2] = ':';
-	(*buffer)[3] = (char)(minutes / 10 + '0');
-	(*buffer)[4] = (char)(minutes % 10 + '0');
-	(*buffer)[5] = ':';
-	(*buffer)[6] = (char)(seconds / 10 + '0');
-	(*buffer)[7] = (char)(seconds % 10 + '0');
-	(*buffer)[8] = '\0';
+	if (now != clock_second) {
+		time_t elapsed = now % 86400;
+		uint8_t seconds = (uint8_t)(elapsed % 60);
+		uint8_t minutes = (uint8_t)(elapsed / 60 % 60);
+		uint8_t hours = (uint8_t)(elapsed / 3600);
+		clock_buffer[0] = (char)(hours / 10 + '0');
+		clock_buffer[1] = (char)(hours % 10 + '0');
+		clock_buffer[2] = ':';
+		clock_buffer[3] = (char)(minutes / 10 + '0');
+		clock_buffer[4] = (char)(minutes % 10 + '0');
+		clock_buffer[5] = ':';
+		clock_buffer[6] = (char)(seconds / 10 + '0');
+		clock_buffer[7] = (char)(seconds % 10 + '0');
+		clock_buffer[8] = '\0';
+		clock_second = now;
+	}
+	memcpy(*buffer, clock_buffer, sizeof(clock_buffer));
+}
+
+uint32_t drain(void) {
+	pthread_mutex_lock(&drain_lock);
+
+	uint32_t drained = 0;
+	uint32_t dropped = (uint32_t)atomic_exchange_explicit(&rings_dropped, 0, memory_order_relaxed);
+	uint16_t len = (uint16_t)atomic_load_explicit(&rings_len, memory_order_acquire);
+	for (uint16_t index = 0; index < len; index++) {
+		rings[index]->drain_head = atomic_load_explicit(&rings[index]->head, memory_order_relaxed);
+		rings[index]->drain_tail = atomic_load_explicit(&rings[index]->tail, memory_order_acquire);
+		dropped += (uint32_t)atomic_exchange_explicit(&rings[index]->dropped, 0, memory_order_relaxed);
+	}
+
+	const uint_fast16_t size = sizeof(rings[0]->records) / sizeof(*rings[0]->records);
+	while (true) {
+		record_t *earliest = NULL;
+		uint16_t earliest_index = 0;
+		for (uint16_t index = 0; index < len; index++) {
+			ring_t *ring = rings[index];
+			if (ring->drain_head == ring->drain_tail) {
+				continue;
+			}
+			record_t *record = &ring->records[ring->drain_head % size];
+			if (earliest == NULL || record->seq < earliest->seq) {
+				earliest = record;
+				earliest_index = index;
+			}
+		}
+		if (earliest == NULL) {
+			break;
+		}
+		fwrite(earliest->text, 1, earliest->len, earliest->error == true ? stderr : stdout);
+		rings[earliest_index]->drain_head++;
+		drained++;
+	}
+
+	for (uint16_t index = 0; index < len; index++) {
+		atomic_store_explicit(&rings[index]->head, rings[index]->drain_head, memory_order_release);
+	}
+
+	if (dropped > 0) {
+		char buffer[9];
+		timestamp(&buffer);
+		fprintf(stderr, "%s%s%s%s%s %s %s%s%s%s%s dropped %u log records\n", bold, blue, name, reset, normal, buffer, bold, yellow,
+						"warn", reset, normal, dropped);
+	}
+	if (drained > 0 || dropped > 0) {
+		fflush(stdout);
+		fflush(stderr);
+	}
+
+	pthread_mutex_unlock(&drain_lock);
+	return drained;
+}
+
+void logger_flush(void) { drain(); }
+
+void *scribe(void *args) {
+	(void)args;
+
+	useconds_t idle = 1000;
+	while (atomic_load_explicit(&scribing, memory_order_acquire) == true) {
+		if (drain() > 0) {
+			idle = 1000;
+		} else if (idle < 64000) {
+			idle *= 2;
+		}
+		usleep(idle);
+	}
+
+	drain();
+	return NULL;
+}
+
+int logger_start(void) {
+	rings_size = (uint16_t)(most_workers + logger_threads);
+	rings = calloc(rings_size, sizeof(*rings));
+	if (rings == NULL) {
+		return -1;
+	}
+
+	atomic_store_explicit(&scribing, true, memory_order_release);
+	if ((errno = pthread_create(&scribe_thread, NULL, &scribe, NULL)) != 0) {
+		atomic_store_explicit(&scribing, false, memory_order_release);
+		return -1;
+	}
+	return 0;
+}
+
+void logger_close(void) {
+	if (atomic_exchange_explicit(&scribing, false, memory_order_acq_rel) == true) {
+		pthread_join(scribe_thread, NULL);
+	}
+	if (slow_file != NULL) {
+		fclose(slow_file);
+		slow_file = NULL;
+	}
+}
+
+int slow_open(const char *path) {
+	slow_file = fopen(path, "a");
+	if (slow_file == NULL) {
+		return -1;
+	}
+	return 0;
+}
+
+void slow(const char *message, ...) {
+	if (slow_file == NULL) {
+		return;
+	}
+
+	time_t now = time(NULL);
+	struct tm tm;
+	char buffer[24];
+	strftime(buffer, sizeof(buffer), "%Y-%m-%dT%H:%M:%SZ", gmtime_r(&now, &tm));
+
+	va_list args;
+	va_start(args, message);
+	flockfile(slow_file);
+	fprintf(slow_file, "time=%s ", buffer);
+	vfprintf(slow_file, message, args);
+	fflush(slow_file);
+	funlockfile(slow_file);
+	va_end(args);
 }
 
 void print(FILE *file, const char *time, const char *level, const char *color, const char *message, va_list args) {
-	flockfile(file);
-	fprintf(file, "%s%s%s%s%s %s %s%s%s%s%s ", bold, blue, name, reset, normal, time, bold, color, level, reset, normal);
-	vfprintf(file, message, args);
-	funlockfile(file);
+	if (ring_busy == true) {
+		if (ring_own != NULL) {
+			atomic_fetch_add_explicit(&ring_own->dropped, 1, memory_order_relaxed);
+		}
+		return;
+	}
+	ring_busy = true;
+
+	if (ring_own == NULL && ring_failed == false && rings != NULL) {
+		ring_own = ring_claim();
+		ring_failed = ring_own == NULL;
+	}
+
+	ring_t *ring = ring_own;
+	if (ring == NULL && rings != NULL) {
+		atomic_fetch_add_explicit(&rings_dropped, 1, memory_order_relaxed);
+		ring_busy = false;
+		return;
+	}
+	if (ring == NULL) {
+		flockfile(file);
+		fprintf(file, "%s%s%s%s%s %s %s%s%s%s%s ", bold, blue, name, reset, normal, time, bold, color, level, reset, normal);
+		vfprintf(file, message, args);
+		funlockfile(file);
+		ring_busy = false;
+		return;
+	}
+
+	const uint_fast16_t size = sizeof(ring->records) / sizeof(*ring->records);
+	uint_fast16_t tail = atomic_load_explicit(&ring->tail, memory_order_relaxed);
+	uint_fast16_t head = atomic_load_explicit(&ring->head, memory_order_acquire);
+	if ((uint_fast16_t)(tail - head) >= size) {
+		atomic_fetch_add_explicit(&ring->dropped, 1, memory_order_relaxed);
+		ring_busy = false;
+		return;
+	}
+
+	record_t *record = &ring->records[tail % size];
+	int prefix = snprintf(record->text, sizeof(record->text), "%s%s%s%s%s %s %s%s%s%s%s ", bold, blue, name, reset, normal, time,
+												bold, color, level, reset, normal);
+	size_t len = prefix > 0 && (size_t)prefix < sizeof(record->text) ? (size_t)prefix : 0;
+	int body = vsnprintf(&record->text[len], sizeof(record->text) - len, message, args);
+	if (body > 0) {
+		len += (size_t)body;
+	}
+	if (len >= sizeof(record->text)) {
+		len = sizeof(record->text) - 1;
+		record->text[len - 1] = '\n';
+	}
+	record->seq = atomic_fetch_add_explicit(&records_seq, 1, memory_order_relaxed);
+	record->len = (uint16_t)len;
+	record->error = file == stderr;
+	atomic_store_explicit(&ring->tail, (uint_fast16_t)(tail + 1), memory_order_release);
+	ring_busy = false;
+
+	if (atomic_load_explicit(&scribing, memory_order_acquire) == false) {
+		drain();
+	}
 }
 
 void req(const char *message, ...) {
@@ -75,7 +318,7 @@ void res(const char *message, ...) {
 	}
 }
 
-void trace(const char *message, ...) {
+void (trace)(const char *message, ...) {
 	if (log_level >= 6) {
 		char buffer[9];
 		timestamp(&buffer);
@@ -86,7 +329,7 @@ void trace(const char *message, ...) {
 	}
 }
 
-void debug(const char *message, ...) {
+void (debug)(const char *message, ...) {
 	if (log_level >= 5) {
 		char buffer[9];
 		timestamp(&buffer);
@@ -97,7 +340,7 @@ void debug(const char *message, ...) {
 	}
 }
 
-void info(const char *message, ...) {
+void (info)(const char *message, ...) {
 	if (log_level >= 4) {
 		char buffer[9];
 		timestamp(&buffer);
@@ -108,7 +351,7 @@ void info(const char *message, ...) {
 	}
 }
 
-void warn(const char *message, ...) {
+void (warn)(const char *message, ...) {
 	if (log_level >= 3) {
 		char buffer[9];
 		timestamp(&buffer);
@@ -119,7 +362,7 @@ void warn(const char *message, ...) {
 	}
 }
 
-void error(const char *message, ...) {
+void (error)(const char *message, ...) {
 	if (log_level >= 2) {
 		char buffer[9];
 		timestamp(&buffer);
@@ -130,7 +373,7 @@ void error(const char *message, ...) {
 	}
 }
 
-void fatal(const char *message, ...) {
+void (fatal)(const char *message, ...) {
 	if (log_level >= 1) {
 		char buffer[9];
 		timestamp(&buffer);
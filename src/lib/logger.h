@@ -1,13 +1,61 @@
 #pragma once
 
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+
+typedef struct record_t {
+	uint64_t seq;
+	bool error;
+	uint16_t len;
+	char text[501];
+} record_t;
+
+typedef struct ring_t {
+	record_t records[128];
+	atomic_uint_fast16_t head;
+	atomic_uint_fast16_t tail;
+	atomic_uint_fast32_t dropped;
+	atomic_bool owned;
+	uint_fast16_t drain_head;
+	uint_fast16_t drain_tail;
+} ring_t;
+
+extern uint8_t log_level;
+extern pthread_t scribe_thread;
+
 void logger_init(void);
+int logger_start(void);
+void logger_close(void);
+void logger_flush(void);
+void *scribe(void *args);
+
+extern FILE *slow_file;
+
+int slow_open(const char *path);
+void slow(const char *message, ...) __attribute__((format(printf, 1, 2)));
 
 void req(const char *message, ...) __attribute__((format(printf, 1, 2)));
 void res(const char *message, ...) __attribute__((format(printf, 1, 2)));
 
-void trace(const char *message, ...) __attribute__((format(printf, 1, 2)));
-void debug(const char *message, ...) __attribute__((format(printf, 1, 2)));
-void info(const char *message, ...) __attribute__((format(printf, 1, 2)));
-void warn(const char *message, ...) __attribute__((format(printf, 1, 2)));
-void error(const char *message, ...) __attribute__((format(printf, 1, 2)));
-void fatal(const char *message, ...) __attribute__((format(printf, 1, 2)));
+#ifndef log_floor
+#define log_floor 6
+#endif
+
+void (trace)(const char *message, ...) __attribute__((format(printf, 1, 2)));
+void (debug)(const char *message, ...) __attribute__((format(printf, 1, 2)));
+void (info)(const char *message, ...) __attribute__((format(printf, 1, 2)));
+void (warn)(const char *message, ...) __attribute__((format(printf, 1, 2)));
+void (error)(const char *message, ...) __attribute__((format(printf, 1, 2)));
+void (fatal)(const char *message, ...) __attribute__((format(printf, 1, 2)));
+
+#define logged(level, call) (log_floor >= (level) && log_level >= (level) ? (void)(call) : (void)0)
+
+#define trace(...) logged(6, (trace)(__VA_ARGS__))
+#define debug(...) logged(5, (debug)(__VA_ARGS__))
+#define info(...) logged(4, (info)(__VA_ARGS__))
+#define warn(...) logged(3, (warn)(__VA_ARGS__))
+#define error(...) logged(2, (error)(__VA_ARGS__))
+#define fatal(...) logged(1, (fatal)(__VA_ARGS__))
@@ -1,6 +1,8 @@
 #include "octet.h"
 #include "error.h"
 #include "logger.h"
+#include "span.h"
+#include "stats.h"
 #include <errno.h>
 #include <fcntl.h>
 #include <stdbool.h>
@@ -69,9 +71,11 @@ int octet_unlink(const char *file) {
 	return 0;
 }
 
-int octet_open(octet_stmt_t *stmt, const char *file, int open_flags, short lock_type) {
+int (octet_open)(octet_stmt_t *stmt, const char *file, int open_flags, short lock_type, const char *site) {
 	trace("opening file %s\n", file);
 
+	uint64_t started_at = span_clock();
+	stmt->series = stats_series_find(file);
 	stmt->fd = open(file, open_flags);
 	if (stmt->fd == -1) {
 		error("failed to open %s because %s\n", file, errno_str());
@@ -79,16 +83,22 @@ int octet_open(octet_stmt_t *stmt, const char *file, int open_flags, short lock_
 	}
 
 	struct flock flock = {.l_type = lock_type, .l_whence = SEEK_SET, .l_start = 0, .l_len = 0};
+	uint64_t locked_at = span_clock();
 	if (fcntl(stmt->fd, F_SETLKW, &flock) == -1) {
 		error("failed to lock %s because %s\n", file, errno_str());
 		return -1;
 	}
+	uint64_t wait = span_clock() - locked_at;
+	span.lock += wait;
+	stats_lock(site, file, stmt->series, lock_type == F_WRLCK, wait / 1000);
 
 	if (fstat(stmt->fd, &stmt->stat) == -1) {
 		error("failed to stat %s because %s\n", file, errno_str());
 		return -1;
 	}
 
+	span.io += span_clock() - started_at;
+	span.files++;
 	return 0;
 }
 
@@ -112,6 +122,8 @@ void octet_close(octet_stmt_t *stmt, const char *file) {
 }
 
 ssize_t octet_row_read(octet_stmt_t *stmt, const char *file, off_t offset, uint8_t *row, uint8_t row_size) {
+	uint64_t started_at = span_clock();
+
 	if (lseek(stmt->fd, offset, SEEK_SET) == -1) {
 		error("failed to seek to offset %zu on file %s because %s\n", (size_t)offset, file, errno_str());
 		return -1;
@@ -128,12 +140,17 @@ ssize_t octet_row_read(octet_stmt_t *stmt, const char *file, off_t offset, uint8
 		return -1;
 	}
 
+	span.io += span_clock() - started_at;
+	span.rows += 1;
+	span.bytes += (uint64_t)bytes;
+	stats_read(stmt->series, (size_t)bytes);
 	return bytes;
 }
 
 ssize_t octet_row_read_all(octet_stmt_t *stmt, const char *file, off_t offset, uint8_t *row, uint8_t row_size, uint8_t rows) {
 	uint16_t rows_size = row_size * rows;
 
+	uint64_t started_at = span_clock();
 	if (lseek(stmt->fd, offset, SEEK_SET) == -1) {
 		error("failed to seek to offset %zu on file %s because %s\n", (size_t)offset, file, errno_str());
 		return -1;
@@ -163,10 +180,16 @@ ssize_t octet_row_read_all(octet_stmt_t *stmt, const char *file, off_t offset, u
 		return -1;
 	}
 
+	span.io += span_clock() - started_at;
+	span.rows += rows;
+	span.bytes += (uint64_t)bytes;
+	stats_read(stmt->series, (size_t)bytes);
 	return bytes;
 }
 
 ssize_t octet_row_write(octet_stmt_t *stmt, const char *file, off_t offset, uint8_t *row, uint8_t row_size) {
+	uint64_t started_at = span_clock();
+
 	if (lseek(stmt->fd, offset, SEEK_SET) == -1) {
 		error("failed to seek to offset %zu on file %s because %s\n", (size_t)offset, file, errno_str());
 		return -1;
@@ -183,12 +206,14 @@ ssize_t octet_row_write(octet_stmt_t *stmt, const char *file, off_t offset, uint
 		return -1;
 	}
 
+	span.io += span_clock() - started_at;
 	return bytes;
 }
 
 ssize_t octet_row_write_all(octet_stmt_t *stmt, const char *file, off_t offset, uint8_t *row, uint8_t row_size, uint8_t rows) {
 	uint16_t rows_size = row_size * rows;
 
+	uint64_t started_at = span_clock();
 	if (lseek(stmt->fd, offset, SEEK_SET) == -1) {
 		error("failed to seek to offset %zu on file %s because %s\n", (size_t)offset, file, errno_str());
 		return -1;
@@ -218,9 +243,32 @@ ssize_t octet_row_write_all(octet_stmt_t *stmt, const char *file, off_t offset,
 		return -1;
 	}
 
+	span.io += span_clock() - started_at;
 	return bytes;
 }
 
+ssize_t octet_bulk_write(octet_stmt_t *stmt, const char *file, off_t offset, uint8_t *rows, size_t rows_size) {
+	uint64_t started_at = span_clock();
+	if (lseek(stmt->fd, offset, SEEK_SET) == -1) {
+		error("failed to seek to offset %zu on file %s because %s\n", (size_t)offset, file, errno_str());
+		return -1;
+	}
+
+	size_t bytes = 0;
+	while (bytes < rows_size) {
+		ssize_t bytes_further = write(stmt->fd, &rows[bytes], rows_size - bytes);
+		if (bytes_further == -1 || bytes_further == 0) {
+			error("failed write %zu bytes from %s because %s\n", rows_size - bytes, file, errno_str());
+			return -1;
+		}
+
+		bytes += (size_t)bytes_further;
+	}
+
+	span.io += span_clock() - started_at;
+	return (ssize_t)bytes;
+}
+
 bool octet_bool_read(uint8_t *row, uint8_t row_ind) {
 	bool value = row[row_ind];
 	return value;
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "arena.h"
 #include <stdbool.h>
 #include <stdint.h>
 #include <sys/stat.h>
@@ -9,24 +10,12 @@ typedef struct octet_t {
 	const char *directory;
 	uint8_t *row;
 	uint8_t row_len;
-	uint8_t *alpha;
-	uint16_t alpha_len;
-	uint8_t *bravo;
-	uint16_t bravo_len;
-	uint8_t *charlie;
-	uint16_t charlie_len;
-	uint8_t *delta;
-	uint16_t delta_len;
-	uint8_t *echo;
-	uint16_t echo_len;
-	uint8_t *chunk;
-	uint16_t chunk_len;
-	uint8_t *table;
-	uint32_t table_len;
+	arena_t arena;
 } octet_t;
 
 typedef struct octet_stmt_t {
 	int fd;
+	uint8_t series;
 	struct stat stat;
 } octet_stmt_t;
 
@@ -37,7 +26,9 @@ int octet_rmdir(const char *directory);
 int octet_creat(const char *file);
 int octet_unlink(const char *file);
 
-int octet_open(octet_stmt_t *stmt, const char *file, int open_flags, short lock_type);
+int (octet_open)(octet_stmt_t *stmt, const char *file, int open_flags, short lock_type, const char *site);
+
+#define octet_open(stmt, file, open_flags, lock_type) (octet_open)(stmt, file, open_flags, lock_type, __func__)
 int octet_trunc(octet_stmt_t *stmt, const char *file, off_t offset);
 void octet_close(octet_stmt_t *stmt, const char *file);
 
@@ -45,6 +36,7 @@ ssize_t octet_row_read(octet_stmt_t *stmt, const char *file, off_t offset, uint8
 ssize_t octet_row_read_all(octet_stmt_t *stmt, const char *file, off_t offset, uint8_t *row, uint8_t row_size, uint8_t rows);
 ssize_t octet_row_write(octet_stmt_t *stmt, const char *file, off_t offset, uint8_t *row, uint8_t row_size);
 ssize_t octet_row_write_all(octet_stmt_t *stmt, const char *file, off_t offset, uint8_t *row, uint8_t row_size, uint8_t rows);
+ssize_t octet_bulk_write(octet_stmt_t *stmt, const char *file, off_t offset, uint8_t *rows, size_t rows_size);
 
 bool octet_bool_read(uint8_t *row, uint8_t row_ind);
 
@@ -1,11 +1,14 @@
 #include "request.h"
 #include "config.h"
 #include "response.h"
-#include "strn.h"
 #include <stdbool.h>
 #include <stdint.h>
 #include <string.h>
 
+#if defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
 void request_init(request_t *request) {
 	uint32_t offset = 0;
 
@@ -32,6 +35,90 @@ void request_init(request_t *request) {
 	request->body.len = 0;
 	request->body.cap = receive_buffer - offset;
 	offset += request->body.cap;
+
+	request->params_len = 0;
+
+	memset(request->headers, 0, sizeof(request->headers));
+	request->headers_len = 0;
+
+	request->route = 0;
+}
+
+size_t delimit(const char *buffer, size_t length, char one, char two) {
+	size_t index = 0;
+
+#if defined(__AVX2__)
+	const __m256i control32 = _mm256_set1_epi8(' ');
+	const __m256i one32 = _mm256_set1_epi8(one);
+	const __m256i two32 = _mm256_set1_epi8(two);
+	while (index + 32 <= length) {
+		__m256i chunk = _mm256_loadu_si256((const __m256i *)&buffer[index]);
+		__m256i hits = _mm256_or_si256(_mm256_cmpgt_epi8(control32, chunk),
+																	 _mm256_or_si256(_mm256_cmpeq_epi8(chunk, one32), _mm256_cmpeq_epi8(chunk, two32)));
+		uint32_t mask = (uint32_t)_mm256_movemask_epi8(hits);
+		if (mask != 0) {
+			return index + (size_t)__builtin_ctz(mask);
+		}
+		index += 32;
+	}
+#endif
+
+#if defined(__SSE2__)
+	const __m128i control16 = _mm_set1_epi8(' ');
+	const __m128i one16 = _mm_set1_epi8(one);
+	const __m128i two16 = _mm_set1_epi8(two);
+	while (index + 16 <= length) {
+		__m128i chunk = _mm_loadu_si128((const __m128i *)&buffer[index]);
+		__m128i hits =
+				_mm_or_si128(_mm_cmplt_epi8(chunk, control16), _mm_or_si128(_mm_cmpeq_epi8(chunk, one16), _mm_cmpeq_epi8(chunk, two16)));
+		uint32_t mask = (uint32_t)_mm_movemask_epi8(hits);
+		if (mask != 0) {
+			return index + (size_t)__builtin_ctz(mask);
+		}
+		index += 16;
+	}
+#endif
+
+	while (index < length && buffer[index] > '\037' && buffer[index] != one && buffer[index] != two) {
+		index++;
+	}
+
+	return index;
+}
+
+uint32_t header_hash(const char *key, size_t key_len) {
+	uint32_t hash = 2166136261;
+	for (size_t index = 0; index < key_len; index++) {
+		hash ^= (uint8_t)key[index];
+		hash *= 16777619;
+	}
+	return hash;
+}
+
+void header_record(request_t *req, const char *key, size_t key_len, const char *value, size_t value_len) {
+	if (key_len == 0 || req->headers_len >= sizeof(req->headers) / sizeof(*req->headers) * 3 / 4) {
+		return;
+	}
+
+	const uint8_t mask = sizeof(req->headers) / sizeof(*req->headers) - 1;
+	uint32_t hash = header_hash(key, key_len);
+	uint8_t slot = (uint8_t)(hash & mask);
+	while (req->headers[slot].key_len != 0) {
+		header_t *header = &req->headers[slot];
+		if (header->hash == hash && header->key_len == key_len && memcmp(&req->header.ptr[header->key], key, key_len) == 0) {
+			return;
+		}
+		slot = (slot + 1) & mask;
+	}
+
+	req->headers[slot] = (header_t){
+			.hash = hash,
+			.key = (uint16_t)(key - req->header.ptr),
+			.key_len = (uint16_t)key_len,
+			.value = (uint16_t)(value - req->header.ptr),
+			.value_len = (uint16_t)value_len,
+	};
+	req->headers_len++;
 }
 
 void request(char *buffer, size_t length, request_t *req, response_t *res) {
@@ -61,44 +148,38 @@ void request(char *buffer, size_t length, request_t *req, response_t *res) {
 	}
 
 	const size_t pathname_index = index;
-	while (stage == 1 && req->pathname.len < req->pathname.cap && index < length) {
-		char *byte = &buffer[index];
-		if (*byte == '?') {
-			stage = 2;
-		} else if (*byte == ' ') {
-			stage = 3;
-		} else if (*byte <= '\037') {
-			res->status = 400;
-			return;
-		} else {
-			req->pathname.len++;
-		}
-		index++;
-	}
+	const size_t pathname_end = index + req->pathname.cap < length ? index + req->pathname.cap : length;
+	index += delimit(&buffer[index], pathname_end - index, '?', ' ');
+	req->pathname.len = (uint8_t)(index - pathname_index);
 	req->pathname.ptr = &buffer[pathname_index];
-	if (stage == 1 || req->pathname.len == 0) {
+	if (index < pathname_end && buffer[index] <= '\037') {
+		res->status = 400;
+		return;
+	}
+	if (index == pathname_end || req->pathname.len == 0) {
 		res->status = 414;
 		return;
 	}
+	stage = buffer[index] == '?' ? 2 : 3;
+	index++;
 
 	const size_t search_index = index;
-	while (stage == 2 && req->search.len < req->search.cap && index < length) {
-		char *byte = &buffer[index];
-		if (*byte == ' ') {
-			stage = 3;
-		} else if (*byte <= '\037') {
+	if (stage == 2) {
+		const size_t search_end = index + req->search.cap < length ? index + req->search.cap : length;
+		index += delimit(&buffer[index], search_end - index, ' ', ' ');
+		req->search.len = (uint16_t)(index - search_index);
+		if (index < search_end && buffer[index] <= '\037') {
 			res->status = 400;
 			return;
-		} else {
-			req->search.len++;
 		}
+		if (index == search_end) {
+			res->status = 414;
+			return;
+		}
+		stage = 3;
 		index++;
 	}
 	req->search.ptr = &buffer[search_index];
-	if (stage == 2) {
-		res->status = 414;
-		return;
-	}
 
 	const size_t protocol_index = index;
 	while ((stage == 3 || stage == 4) && req->protocol.len < req->protocol.cap && index < length) {
@@ -126,34 +207,48 @@ void request(char *buffer, size_t length, request_t *req, response_t *res) {
 		return;
 	}
 
-	bool header_key = true;
+	uint8_t breaks = 2;
 	const size_t header_index = index;
-	while ((stage >= 3 && stage <= 6) && req->header.len < req->header.cap && index < length) {
-		char *byte = &buffer[index];
-		if (header_key == true && *byte >= 'A' && *byte <= 'Z') {
-			*byte += 32;
-		}
-		if (*byte == ':') {
-			header_key = false;
+	const size_t header_end = index + req->header.cap < length ? index + req->header.cap : length;
+	req->header.ptr = &buffer[header_index];
+	while (breaks < 4 && index < header_end) {
+		if (buffer[index] == '\r' || buffer[index] == '\n') {
+			breaks++;
+			index++;
+			continue;
 		}
-		if (*byte == '\r' || *byte == '\n') {
-			header_key = true;
-			stage += 1;
-		} else if (*byte <= '\037') {
+		if (buffer[index] <= '\037') {
 			res->status = 400;
 			return;
-		} else {
-			stage = 3;
 		}
-		req->header.len++;
+		breaks = 0;
+
+		const size_t key_index = index;
+		index += delimit(&buffer[index], header_end - index, ':', ':');
+		for (size_t cursor = key_index; cursor < index; cursor++) {
+			if (buffer[cursor] >= 'A' && buffer[cursor] <= 'Z') {
+				buffer[cursor] += 32;
+			}
+		}
+		if (index == header_end || buffer[index] != ':') {
+			continue;
+		}
+		const size_t key_len = index - key_index;
 		index++;
+
+		if (index < header_end && buffer[index] == ' ') {
+			index++;
+		}
+		const size_t value_index = index;
+		index += delimit(&buffer[index], header_end - index, '\0', '\0');
+		header_record(req, &buffer[key_index], key_len, &buffer[value_index], index - value_index);
 	}
-	req->header.ptr = &buffer[header_index];
-	if (stage >= 3 && stage <= 5) {
+	req->header.len = (uint16_t)(index - header_index);
+	if (breaks < 3) {
 		res->status = 431;
 		return;
 	}
-	if (stage == 6) {
+	if (breaks == 3) {
 		res->status = 400;
 		return;
 	}
@@ -163,6 +258,13 @@ void request(char *buffer, size_t length, request_t *req, response_t *res) {
 }
 
 const char *param_find(request_t *request, uint8_t offset, uint8_t *length) {
+	for (uint8_t index = 0; index < request->params_len; index++) {
+		if (request->params[index].offset == offset) {
+			*length += request->params[index].len;
+			return &request->pathname.ptr[offset];
+		}
+	}
+
 	if (request->pathname.len < offset) {
 		return NULL;
 	}
@@ -177,21 +279,21 @@ const char *param_find(request_t *request, uint8_t offset, uint8_t *length) {
 	return &request->pathname.ptr[offset];
 }
 
-const char *header_find(request_t *request, const char *key) {
-	const char *header = strncasestrn(request->header.ptr, request->header.len, key, strlen(key));
-	if (header == NULL) {
-		return NULL;
-	}
-
-	header += strlen(key);
-	if (header[0] == ':') {
-		header += 1;
-	}
-	if (header[0] == ' ') {
-		header += 1;
+const char *header_find(request_t *request, const char *key, uint16_t *length) {
+	const uint8_t mask = sizeof(request->headers) / sizeof(*request->headers) - 1;
+	size_t key_len = strlen(key);
+	uint32_t hash = header_hash(key, key_len);
+	uint8_t slot = (uint8_t)(hash & mask);
+	while (request->headers[slot].key_len != 0) {
+		header_t *header = &request->headers[slot];
+		if (header->hash == hash && header->key_len == key_len && memcmp(&request->header.ptr[header->key], key, key_len) == 0) {
+			*length = header->value_len;
+			return &request->header.ptr[header->value];
+		}
+		slot = (slot + 1) & mask;
 	}
 
-	return header;
+	return NULL;
 }
 
 const char *body_read(request_t *request, uint32_t length) {
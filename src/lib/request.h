@@ -6,6 +6,19 @@
 
 typedef struct response_t response_t;
 
+typedef struct param_t {
+	uint8_t offset;
+	uint8_t len;
+} param_t;
+
+typedef struct header_t {
+	uint32_t hash;
+	uint16_t key;
+	uint16_t key_len;
+	uint16_t value;
+	uint16_t value_len;
+} header_t;
+
 typedef struct request_t {
 	strn8_t method;
 	strn8_t pathname;
@@ -13,11 +26,17 @@ typedef struct request_t {
 	strn8_t protocol;
 	strn16_t header;
 	strn32_t body;
+	param_t params[4];
+	uint8_t params_len;
+	header_t headers[64];
+	uint8_t headers_len;
+	uint8_t route;
 } request_t;
 
 void request_init(request_t *request);
+size_t delimit(const char *buffer, size_t length, char one, char two);
 void request(char *buffer, size_t length, request_t *req, response_t *res);
 
 const char *param_find(request_t *request, uint8_t offset, uint8_t *length);
-const char *header_find(request_t *request, const char *key);
+const char *header_find(request_t *request, const char *key, uint16_t *length);
 const char *body_read(request_t *request, uint32_t length);
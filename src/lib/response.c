@@ -25,19 +25,32 @@ void response_init(response_t *response, char *buffer) {
 	response->body.len = 0;
 	response->body.cap = send_buffer - offset;
 	offset += response->body.cap;
+
+	response->preset = NULL;
+	response->preset_len = 0;
+	response->preset_split = 0;
+	response->content = NULL;
+	response->content_len = 0;
+	response->content_lock = NULL;
 }
 
 size_t response(request_t *req, response_t *res, char *buffer) {
+	if (req->method.len == 4 && memcmp(req->method.ptr, "head", req->method.len) == 0) {
+		if (res->preset == NULL) {
+			res->body.len = 0;
+		}
+		res->content_len = 0;
+	}
+	if (res->preset != NULL) {
+		return res->preset_len + res->header.len + res->body.len + res->content_len;
+	}
 	res->head.len += (uint8_t)sprintf(res->head.ptr, "HTTP/1.1 %hu %s\r\n", res->status, status_text(res->status));
 	if (res->header.len > 0) {
 		memmove(&buffer[res->head.len], res->header.ptr, res->header.len);
 	}
 	memcpy(&buffer[res->head.len + res->header.len], "\r\n", 2);
 	res->header.len += 2;
-	if (req->method.len == 4 && memcmp(req->method.ptr, "head", req->method.len) == 0) {
-		res->body.len = 0;
-	}
-	return res->head.len + res->header.len + res->body.len;
+	return res->head.len + res->header.len + res->body.len + res->content_len;
 }
 
 void header_write(response_t *response, const char *format, ...) {
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "strn.h"
+#include <pthread.h>
 #include <stdint.h>
 #include <stdio.h>
 
@@ -11,6 +12,12 @@ typedef struct response_t {
 	strn8_t head;
 	strn16_t header;
 	strn32_t body;
+	const char *preset;
+	size_t preset_len;
+	size_t preset_split;
+	const char *content;
+	size_t content_len;
+	pthread_rwlock_t *content_lock;
 } response_t;
 
 void response_init(response_t *response, char *buffer);
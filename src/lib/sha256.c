@@ -1,7 +1,18 @@
+#include "sha256.h"
 #include <memory.h>
+#include <stdbool.h>
 #include <stdint.h>
 #include <stdlib.h>
 
+#if defined(__x86_64__)
+#include <immintrin.h>
+#endif
+
+#if defined(__aarch64__)
+#include <arm_neon.h>
+#include <sys/auxv.h>
+#endif
+
 typedef struct sha256_ctx {
 	uint32_t state[8];
 	uint8_t data[64];
@@ -43,65 +54,172 @@ void sha256_init(sha256_ctx *ctx) {
 	ctx->state[7] = 0x5be0cd19;
 }
 
-void sha256_transform(sha256_ctx *ctx, const uint8_t *data) {
+void sha256_compress_scalar(uint32_t (*state)[8], const uint8_t *data, size_t blocks) {
 	uint32_t alpha, bravo, charlie, delta, echo, foxtrot, golf, hotel;
 	uint32_t india, juliet;
 	uint32_t store1, store2;
 	uint32_t message[64];
 
-	india = 0;
-	juliet = 0;
-	for (; india < 16; india++, juliet += 4)
-		message[india] = ((uint32_t)(data[juliet] << 24)) | ((uint32_t)(data[juliet + 1]) << 16) |
-										 ((uint32_t)(data[juliet + 2]) << 8) | ((uint32_t)(data[juliet + 3]));
-	for (; india < 64; india++)
-		message[india] = sigma1(message[india - 2]) + message[india - 7] + sigma0(message[india - 15]) + message[india - 16];
-
-	alpha = ctx->state[0];
-	bravo = ctx->state[1];
-	charlie = ctx->state[2];
-	delta = ctx->state[3];
-	echo = ctx->state[4];
-	foxtrot = ctx->state[5];
-	golf = ctx->state[6];
-	hotel = ctx->state[7];
-
-	india = 0;
-	for (; india < 64; india++) {
-		store1 = hotel + epsilon1(echo) + choose(echo, foxtrot, golf) + constants[india] + message[india];
-		store2 = epsilon0(alpha) + majority(alpha, bravo, charlie);
-		hotel = golf;
-		golf = foxtrot;
-		foxtrot = echo;
-		echo = delta + store1;
-		delta = charlie;
-		charlie = bravo;
-		bravo = alpha;
-		alpha = store1 + store2;
+	for (size_t block = 0; block < blocks; block++, data += 64) {
+		india = 0;
+		juliet = 0;
+		for (; india < 16; india++, juliet += 4)
+			message[india] = ((uint32_t)(data[juliet] << 24)) | ((uint32_t)(data[juliet + 1]) << 16) |
+											 ((uint32_t)(data[juliet + 2]) << 8) | ((uint32_t)(data[juliet + 3]));
+		for (; india < 64; india++)
+			message[india] = sigma1(message[india - 2]) + message[india - 7] + sigma0(message[india - 15]) + message[india - 16];
+
+		alpha = (*state)[0];
+		bravo = (*state)[1];
+		charlie = (*state)[2];
+		delta = (*state)[3];
+		echo = (*state)[4];
+		foxtrot = (*state)[5];
+		golf = (*state)[6];
+		hotel = (*state)[7];
+
+		india = 0;
+		for (; india < 64; india++) {
+			store1 = hotel + epsilon1(echo) + choose(echo, foxtrot, golf) + constants[india] + message[india];
+			store2 = epsilon0(alpha) + majority(alpha, bravo, charlie);
+			hotel = golf;
+			golf = foxtrot;
+			foxtrot = echo;
+			echo = delta + store1;
+			delta = charlie;
+			charlie = bravo;
+			bravo = alpha;
+			alpha = store1 + store2;
+		}
+
+		(*state)[0] += alpha;
+		(*state)[1] += bravo;
+		(*state)[2] += charlie;
+		(*state)[3] += delta;
+		(*state)[4] += echo;
+		(*state)[5] += foxtrot;
+		(*state)[6] += golf;
+		(*state)[7] += hotel;
 	}
+}
+
+#if defined(__x86_64__)
+__attribute__((target("sha,sse4.1"))) void sha256_compress_shani(uint32_t (*state)[8], const uint8_t *data, size_t blocks) {
+	const __m128i shuffle = _mm_set_epi64x(0x0c0d0e0f08090a0b, 0x0405060700010203);
 
-	ctx->state[0] += alpha;
-	ctx->state[1] += bravo;
-	ctx->state[2] += charlie;
-	ctx->state[3] += delta;
-	ctx->state[4] += echo;
-	ctx->state[5] += foxtrot;
-	ctx->state[6] += golf;
-	ctx->state[7] += hotel;
+	__m128i swap = _mm_shuffle_epi32(_mm_loadu_si128((const __m128i *)&(*state)[0]), 0xb1);
+	__m128i state1 = _mm_shuffle_epi32(_mm_loadu_si128((const __m128i *)&(*state)[4]), 0x1b);
+	__m128i state0 = _mm_alignr_epi8(swap, state1, 8);
+	state1 = _mm_blend_epi16(state1, swap, 0xf0);
+
+	for (size_t block = 0; block < blocks; block++, data += 64) {
+		const __m128i save0 = state0;
+		const __m128i save1 = state1;
+
+		__m128i message[4];
+		for (uint8_t index = 0; index < 4; index++) {
+			message[index] = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *)&data[index * 16]), shuffle);
+		}
+
+		for (uint8_t index = 0; index < 16; index++) {
+			__m128i words = _mm_add_epi32(message[index & 3], _mm_loadu_si128((const __m128i *)&constants[index * 4]));
+			state1 = _mm_sha256rnds2_epu32(state1, state0, words);
+			state0 = _mm_sha256rnds2_epu32(state0, state1, _mm_shuffle_epi32(words, 0x0e));
+			if (index < 12) {
+				__m128i next = _mm_sha256msg1_epu32(message[index & 3], message[(index + 1) & 3]);
+				next = _mm_add_epi32(next, _mm_alignr_epi8(message[(index + 3) & 3], message[(index + 2) & 3], 4));
+				message[index & 3] = _mm_sha256msg2_epu32(next, message[(index + 3) & 3]);
+			}
+		}
+
+		state0 = _mm_add_epi32(state0, save0);
+		state1 = _mm_add_epi32(state1, save1);
+	}
+
+	swap = _mm_shuffle_epi32(state0, 0x1b);
+	state1 = _mm_shuffle_epi32(state1, 0xb1);
+	_mm_storeu_si128((__m128i *)&(*state)[0], _mm_blend_epi16(swap, state1, 0xf0));
+	_mm_storeu_si128((__m128i *)&(*state)[4], _mm_alignr_epi8(state1, swap, 8));
+}
+#endif
+
+#if defined(__aarch64__)
+__attribute__((target("+sha2"))) void sha256_compress_armv8(uint32_t (*state)[8], const uint8_t *data, size_t blocks) {
+	uint32x4_t state0 = vld1q_u32(&(*state)[0]);
+	uint32x4_t state1 = vld1q_u32(&(*state)[4]);
+
+	for (size_t block = 0; block < blocks; block++, data += 64) {
+		const uint32x4_t save0 = state0;
+		const uint32x4_t save1 = state1;
+
+		uint32x4_t message[4];
+		for (uint8_t index = 0; index < 4; index++) {
+			message[index] = vreinterpretq_u32_u8(vrev32q_u8(vld1q_u8(&data[index * 16])));
+		}
+
+		for (uint8_t index = 0; index < 16; index++) {
+			uint32x4_t words = vaddq_u32(message[index & 3], vld1q_u32(&constants[index * 4]));
+			uint32x4_t previous = state0;
+			state0 = vsha256hq_u32(state0, state1, words);
+			state1 = vsha256h2q_u32(state1, previous, words);
+			if (index < 12) {
+				uint32x4_t next = vsha256su0q_u32(message[index & 3], message[(index + 1) & 3]);
+				message[index & 3] = vsha256su1q_u32(next, message[(index + 2) & 3], message[(index + 3) & 3]);
+			}
+		}
+
+		state0 = vaddq_u32(state0, save0);
+		state1 = vaddq_u32(state1, save1);
+	}
+
+	vst1q_u32(&(*state)[0], state0);
+	vst1q_u32(&(*state)[4], state1);
+}
+#endif
+
+void sha256_compress_detect(uint32_t (*state)[8], const uint8_t *data, size_t blocks) {
+	sha256_compress = &sha256_compress_scalar;
+#if defined(__x86_64__)
+	if (__builtin_cpu_supports("sha") && __builtin_cpu_supports("sse4.1")) {
+		sha256_compress = &sha256_compress_shani;
+	}
+#endif
+#if defined(__aarch64__)
+	if (getauxval(AT_HWCAP) & HWCAP_SHA2) {
+		sha256_compress = &sha256_compress_armv8;
+	}
+#endif
+	sha256_compress(state, data, blocks);
 }
 
+void (*sha256_compress)(uint32_t (*state)[8], const uint8_t *data, size_t blocks) = &sha256_compress_detect;
+
 void sha256_update(sha256_ctx *ctx, const uint8_t *data, size_t data_len) {
 	size_t index = 0;
 
-	for (; index < data_len; index++) {
-		ctx->data[ctx->data_len] = data[index];
-		ctx->data_len++;
-		if (ctx->data_len == 64) {
-			sha256_transform(ctx, ctx->data);
-			ctx->bit_len += 512;
-			ctx->data_len = 0;
+	if (ctx->data_len > 0) {
+		while (ctx->data_len < 64 && index < data_len) {
+			ctx->data[ctx->data_len] = data[index];
+			ctx->data_len++;
+			index++;
 		}
+		if (ctx->data_len < 64) {
+			return;
+		}
+		sha256_compress(&ctx->state, ctx->data, 1);
+		ctx->bit_len += 512;
+		ctx->data_len = 0;
+	}
+
+	size_t blocks = (data_len - index) / 64;
+	if (blocks > 0) {
+		sha256_compress(&ctx->state, &data[index], blocks);
+		ctx->bit_len += 512 * blocks;
+		index += 64 * blocks;
 	}
+
+	memcpy(ctx->data, &data[index], data_len - index);
+	ctx->data_len = data_len - index;
 }
 
 void sha256_final(sha256_ctx *ctx, uint8_t (*hash)[32]) {
@@ -115,7 +233,7 @@ void sha256_final(sha256_ctx *ctx, uint8_t (*hash)[32]) {
 		ctx->data[index++] = 0x80;
 		while (index < 64)
 			ctx->data[index++] = 0x00;
-		sha256_transform(ctx, ctx->data);
+		sha256_compress(&ctx->state, ctx->data, 1);
 		memset(ctx->data, 0x00, 56);
 	}
 
@@ -128,7 +246,7 @@ void sha256_final(sha256_ctx *ctx, uint8_t (*hash)[32]) {
 	ctx->data[58] = (uint8_t)(ctx->bit_len >> 40);
 	ctx->data[57] = (uint8_t)(ctx->bit_len >> 48);
 	ctx->data[56] = (uint8_t)(ctx->bit_len >> 56);
-	sha256_transform(ctx, ctx->data);
+	sha256_compress(&ctx->state, ctx->data, 1);
 
 	for (index = 0; index < 4; index++) {
 		(*hash)[index] = (ctx->state[0] >> (24 - index * 8)) & 0x000000ff;
@@ -150,6 +268,138 @@ void sha256(const void *data, const size_t data_len, uint8_t (*hash)[32]) {
 	sha256_final(&ctx, hash);
 }
 
+#if defined(__x86_64__)
+__attribute__((target("avx2"))) __m256i sha256_rotate8(__m256i value, int bits) {
+	return _mm256_or_si256(_mm256_srli_epi32(value, bits), _mm256_slli_epi32(value, 32 - bits));
+}
+
+__attribute__((target("avx2"))) void sha256_many_avx2(const uint8_t *const *data, const size_t *data_len, uint8_t (*hashes)[32],
+																											size_t count) {
+	for (size_t first = 0; first < count; first += 8) {
+		uint8_t lanes = count - first < 8 ? (uint8_t)(count - first) : 8;
+
+		uint8_t tails[8][128];
+		size_t blocks[8] = {0};
+		size_t most = 0;
+		for (uint8_t lane = 0; lane < lanes; lane++) {
+			size_t len = data_len[first + lane];
+			size_t full = len / 64;
+			size_t rest = len - full * 64;
+			size_t tail = rest < 56 ? 64 : 128;
+			memset(tails[lane], 0x00, tail);
+			memcpy(tails[lane], &data[first + lane][full * 64], rest);
+			tails[lane][rest] = 0x80;
+			uint64_t bit_len = (uint64_t)len * 8;
+			for (uint8_t index = 0; index < 8; index++) {
+				tails[lane][tail - 1 - index] = (uint8_t)(bit_len >> (index * 8));
+			}
+			blocks[lane] = full + tail / 64;
+			if (blocks[lane] > most) {
+				most = blocks[lane];
+			}
+		}
+
+		__m256i state[8];
+		const uint32_t initial[8] = {0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a, 0x510e527f, 0x9b05688c, 0x1f83d9ab,
+																 0x5be0cd19};
+		for (uint8_t index = 0; index < 8; index++) {
+			state[index] = _mm256_set1_epi32((int)initial[index]);
+		}
+
+		for (size_t block = 0; block < most; block++) {
+			uint32_t words[16][8] = {{0}};
+			uint32_t active[8] = {0};
+			for (uint8_t lane = 0; lane < lanes; lane++) {
+				if (block >= blocks[lane]) {
+					continue;
+				}
+				size_t full = data_len[first + lane] / 64;
+				const uint8_t *ptr = block < full ? &data[first + lane][block * 64] : &tails[lane][(block - full) * 64];
+				for (uint8_t index = 0; index < 16; index++) {
+					words[index][lane] = (uint32_t)ptr[index * 4] << 24 | (uint32_t)ptr[index * 4 + 1] << 16 |
+															 (uint32_t)ptr[index * 4 + 2] << 8 | (uint32_t)ptr[index * 4 + 3];
+				}
+				active[lane] = 0xffffffff;
+			}
+
+			__m256i message[64];
+			for (uint8_t index = 0; index < 16; index++) {
+				message[index] = _mm256_loadu_si256((const __m256i *)words[index]);
+			}
+			for (uint8_t index = 16; index < 64; index++) {
+				__m256i low = message[index - 15];
+				__m256i high = message[index - 2];
+				__m256i small0 = _mm256_xor_si256(_mm256_xor_si256(sha256_rotate8(low, 7), sha256_rotate8(low, 18)),
+																					_mm256_srli_epi32(low, 3));
+				__m256i small1 =
+						_mm256_xor_si256(_mm256_xor_si256(sha256_rotate8(high, 17), sha256_rotate8(high, 19)), _mm256_srli_epi32(high, 10));
+				message[index] =
+						_mm256_add_epi32(_mm256_add_epi32(small1, message[index - 7]), _mm256_add_epi32(small0, message[index - 16]));
+			}
+
+			__m256i alpha = state[0], bravo = state[1], charlie = state[2], delta = state[3];
+			__m256i echo = state[4], foxtrot = state[5], golf = state[6], hotel = state[7];
+			for (uint8_t index = 0; index < 64; index++) {
+				__m256i big1 = _mm256_xor_si256(_mm256_xor_si256(sha256_rotate8(echo, 6), sha256_rotate8(echo, 11)),
+																				sha256_rotate8(echo, 25));
+				__m256i chosen = _mm256_xor_si256(_mm256_and_si256(echo, foxtrot), _mm256_andnot_si256(echo, golf));
+				__m256i store1 = _mm256_add_epi32(_mm256_add_epi32(hotel, big1), _mm256_add_epi32(chosen, message[index]));
+				store1 = _mm256_add_epi32(store1, _mm256_set1_epi32((int)constants[index]));
+				__m256i big0 =
+						_mm256_xor_si256(_mm256_xor_si256(sha256_rotate8(alpha, 2), sha256_rotate8(alpha, 13)), sha256_rotate8(alpha, 22));
+				__m256i major = _mm256_xor_si256(_mm256_xor_si256(_mm256_and_si256(alpha, bravo), _mm256_and_si256(alpha, charlie)),
+																				 _mm256_and_si256(bravo, charlie));
+				__m256i store2 = _mm256_add_epi32(big0, major);
+				hotel = golf;
+				golf = foxtrot;
+				foxtrot = echo;
+				echo = _mm256_add_epi32(delta, store1);
+				delta = charlie;
+				charlie = bravo;
+				bravo = alpha;
+				alpha = _mm256_add_epi32(store1, store2);
+			}
+
+			const __m256i mask = _mm256_loadu_si256((const __m256i *)active);
+			__m256i rounds[8] = {alpha, bravo, charlie, delta, echo, foxtrot, golf, hotel};
+			for (uint8_t index = 0; index < 8; index++) {
+				state[index] = _mm256_add_epi32(state[index], _mm256_and_si256(rounds[index], mask));
+			}
+		}
+
+		for (uint8_t index = 0; index < 8; index++) {
+			uint32_t words[8];
+			_mm256_storeu_si256((__m256i *)words, state[index]);
+			for (uint8_t lane = 0; lane < lanes; lane++) {
+				hashes[first + lane][index * 4] = (uint8_t)(words[lane] >> 24);
+				hashes[first + lane][index * 4 + 1] = (uint8_t)(words[lane] >> 16);
+				hashes[first + lane][index * 4 + 2] = (uint8_t)(words[lane] >> 8);
+				hashes[first + lane][index * 4 + 3] = (uint8_t)words[lane];
+			}
+		}
+	}
+}
+#endif
+
+void sha256_many_scalar(const uint8_t *const *data, const size_t *data_len, uint8_t (*hashes)[32], size_t count) {
+	for (size_t index = 0; index < count; index++) {
+		sha256(data[index], data_len[index], &hashes[index]);
+	}
+}
+
+void sha256_many_detect(const uint8_t *const *data, const size_t *data_len, uint8_t (*hashes)[32], size_t count) {
+	sha256_many = &sha256_many_scalar;
+#if defined(__x86_64__)
+	if (__builtin_cpu_supports("avx2")) {
+		sha256_many = &sha256_many_avx2;
+	}
+#endif
+	sha256_many(data, data_len, hashes, count);
+}
+
+void (*sha256_many)(const uint8_t *const *data, const size_t *data_len, uint8_t (*hashes)[32], size_t count) =
+		&sha256_many_detect;
+
 void sha256_hmac(const uint8_t *key, const size_t key_len, const void *data, const size_t data_len, uint8_t (*hmac)[32]) {
 	uint8_t key_block[64] = {0x00};
 	uint8_t outer_padding[64];
@@ -3,5 +3,18 @@
 #include <stdint.h>
 #include <stdlib.h>
 
+extern void (*sha256_compress)(uint32_t (*state)[8], const uint8_t *data, size_t blocks);
+extern void (*sha256_many)(const uint8_t *const *data, const size_t *data_len, uint8_t (*hashes)[32], size_t count);
+
+void sha256_compress_scalar(uint32_t (*state)[8], const uint8_t *data, size_t blocks);
+#if defined(__x86_64__)
+void sha256_compress_shani(uint32_t (*state)[8], const uint8_t *data, size_t blocks);
+void sha256_many_avx2(const uint8_t *const *data, const size_t *data_len, uint8_t (*hashes)[32], size_t count);
+#endif
+#if defined(__aarch64__)
+void sha256_compress_armv8(uint32_t (*state)[8], const uint8_t *data, size_t blocks);
+#endif
+void sha256_many_scalar(const uint8_t *const *data, const size_t *data_len, uint8_t (*hashes)[32], size_t count);
+
 void sha256(const void *data, size_t data_len, uint8_t (*hash)[32]);
 void sha256_hmac(const uint8_t *key, const size_t key_len, const void *data, const size_t data_len, uint8_t (*hmac)[32]);
@@ -0,0 +1,14 @@
+#include "span.h"
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+
+_Thread_local span_t span;
+
+void span_reset(void) { memset(&span, 0, sizeof(span)); }
+
+uint64_t span_clock(void) {
+	struct timespec now;
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	return (uint64_t)now.tv_sec * 1000000000 + (uint64_t)now.tv_nsec;
+}
@@ -0,0 +1,24 @@
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+
+typedef struct span_t {
+	uint64_t receive;
+	uint64_t parse;
+	uint64_t auth;
+	uint64_t io;
+	uint64_t lock;
+	uint64_t send;
+	uint32_t files;
+	uint32_t rows;
+	uint64_t bytes;
+	uint32_t emitted;
+	uint8_t user[8];
+	bool authenticated;
+} span_t;
+
+extern _Thread_local span_t span;
+
+void span_reset(void);
+uint64_t span_clock(void);
@@ -0,0 +1,315 @@
+#include "stats.h"
+#include "error.h"
+#include "logger.h"
+#include <errno.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+const char *stats_series[17] = {
+		"device", "zone", "user", "user-device", "user-zone", "host", "email", "config", "radio",
+		"rule", "alert", "reading", "metric", "buffer", "uplink", "downlink", "other",
+};
+
+const char *stats_locks[4] = {"catalog read", "catalog write", "series read", "series write"};
+
+atomic_uintptr_t lock_sites[128];
+lock_file_t lock_files[64];
+atomic_uint_fast64_t lock_files_dropped = 0;
+const uint8_t series_catalogs = 7;
+const uint64_t lock_contended = 50;
+
+shard_t *shards[64];
+atomic_uint_fast8_t shards_len = 0;
+shard_t *shard_spill = NULL;
+uint8_t shard_routes = 0;
+pthread_mutex_t shards_lock = PTHREAD_MUTEX_INITIALIZER;
+pthread_key_t shard_key;
+
+_Thread_local shard_t *shard_own = NULL;
+
+void shard_release(void *shard) { atomic_store_explicit(&((shard_t *)shard)->owned, false, memory_order_release); }
+
+shard_t *shard_claim(void) {
+	if (shard_spill == NULL) {
+		return NULL;
+	}
+
+	pthread_mutex_lock(&shards_lock);
+	shard_t *shard = NULL;
+	uint8_t len = (uint8_t)atomic_load_explicit(&shards_len, memory_order_relaxed);
+	for (uint8_t index = 0; index < len && shard == NULL; index++) {
+		bool owned = false;
+		if (atomic_compare_exchange_strong(&shards[index]->owned, &owned, true) == true) {
+			shard = shards[index];
+		}
+	}
+	if (shard == NULL && len < sizeof(shards) / sizeof(*shards)) {
+		shard = calloc(1, sizeof(*shard) + shard_routes * sizeof(*shard->routes));
+		if (shard != NULL) {
+			atomic_store_explicit(&shard->owned, true, memory_order_relaxed);
+			shards[len] = shard;
+			atomic_store_explicit(&shards_len, len + 1, memory_order_release);
+		}
+	}
+	pthread_mutex_unlock(&shards_lock);
+
+	if (shard == NULL) {
+		return shard_spill;
+	}
+	pthread_setspecific(shard_key, shard);
+	return shard;
+}
+
+int stats_init(uint8_t routes_len) {
+	if ((errno = pthread_key_create(&shard_key, &shard_release)) != 0) {
+		error("failed to create stats key because %s\n", errno_str());
+		return -1;
+	}
+
+	shard_routes = routes_len + 1;
+	shard_spill = calloc(1, sizeof(*shard_spill) + shard_routes * sizeof(*shard_spill->routes));
+	if (shard_spill == NULL) {
+		error("failed to allocate stats shard because %s\n", errno_str());
+		return -1;
+	}
+
+	atomic_store_explicit(&shard_spill->owned, true, memory_order_relaxed);
+	return 0;
+}
+
+shard_t *stats_shard(void) {
+	if (shard_own == NULL) {
+		shard_own = shard_claim();
+	}
+	return shard_own;
+}
+
+void stats_count(shard_t *owner, atomic_uint_fast64_t *counter, uint64_t value) {
+	if (owner == shard_spill) {
+		atomic_fetch_add_explicit(counter, value, memory_order_relaxed);
+	} else {
+		atomic_store_explicit(counter, atomic_load_explicit(counter, memory_order_relaxed) + value, memory_order_relaxed);
+	}
+}
+
+void stats_max(atomic_uint_fast64_t *max, uint64_t value) {
+	uint64_t current = atomic_load_explicit(max, memory_order_relaxed);
+	while (value > current) {
+		if (atomic_compare_exchange_weak_explicit(max, &current, value, memory_order_relaxed, memory_order_relaxed) == true) {
+			break;
+		}
+	}
+}
+
+uint8_t histogram_bucket(uint64_t value) {
+	if (value < 8) {
+		return (uint8_t)value;
+	}
+	uint8_t msb = (uint8_t)(63 - __builtin_clzll(value));
+	if (msb > 31) {
+		return 239;
+	}
+	return (uint8_t)((uint64_t)(msb - 2) * 8 + ((value >> (msb - 3)) & 7));
+}
+
+uint64_t histogram_value(uint8_t bucket) {
+	if (bucket < 8) {
+		return bucket;
+	}
+	uint8_t msb = bucket / 8 + 2;
+	return ((uint64_t)(8 + bucket % 8 + 1) << (msb - 3)) - 1;
+}
+
+void histogram_record(shard_t *owner, histogram_t *histogram, uint64_t value) {
+	atomic_uint_fast32_t *bucket = &histogram->buckets[histogram_bucket(value)];
+	if (owner == shard_spill) {
+		atomic_fetch_add_explicit(bucket, 1, memory_order_relaxed);
+		stats_max(&histogram->max, value);
+	} else {
+		atomic_store_explicit(bucket, atomic_load_explicit(bucket, memory_order_relaxed) + 1, memory_order_relaxed);
+		if (value > atomic_load_explicit(&histogram->max, memory_order_relaxed)) {
+			atomic_store_explicit(&histogram->max, value, memory_order_relaxed);
+		}
+	}
+	stats_count(owner, &histogram->count, 1);
+	stats_count(owner, &histogram->sum, value);
+}
+
+void stats_request(uint8_t route, uint16_t status, uint64_t duration) {
+	shard_t *owner = stats_shard();
+	if (owner == NULL || route >= shard_routes) {
+		return;
+	}
+
+	stats_route_t *stats_route = &owner->routes[route];
+	stats_count(owner, &stats_route->statuses[status >= 100 && status < 600 ? status / 100 - 1 : 4], 1);
+	histogram_record(owner, &stats_route->latency, duration);
+}
+
+void stats_wait(uint64_t duration) {
+	shard_t *owner = stats_shard();
+	if (owner != NULL) {
+		histogram_record(owner, &owner->queue_wait, duration);
+	}
+}
+
+void stats_cycle(uint64_t duration) {
+	shard_t *owner = stats_shard();
+	if (owner != NULL) {
+		histogram_record(owner, &owner->alerter_cycle, duration);
+	}
+}
+
+void stats_lag(uint64_t duration) {
+	shard_t *owner = stats_shard();
+	if (owner != NULL) {
+		histogram_record(owner, &owner->decode_lag, duration);
+	}
+}
+
+void stats_device_cache(bool hit) {
+	shard_t *owner = stats_shard();
+	if (owner != NULL) {
+		stats_count(owner, hit == true ? &owner->device_hits : &owner->device_misses, 1);
+	}
+}
+
+void stats_zone_cache(bool hit) {
+	shard_t *owner = stats_shard();
+	if (owner != NULL) {
+		stats_count(owner, hit == true ? &owner->zone_hits : &owner->zone_misses, 1);
+	}
+}
+
+uint8_t stats_series_find(const char *file) {
+	const char *base = strrchr(file, '/');
+	base = base == NULL ? file : base + 1;
+	size_t base_len = strcspn(base, ".");
+
+	uint8_t index = 0;
+	while (index < sizeof(stats_series) / sizeof(*stats_series) - 1) {
+		if (strlen(stats_series[index]) == base_len && memcmp(stats_series[index], base, base_len) == 0) {
+			break;
+		}
+		index++;
+	}
+	return index;
+}
+
+void stats_read(uint8_t series, size_t bytes) {
+	shard_t *owner = stats_shard();
+	if (owner != NULL && series < sizeof(owner->series_bytes) / sizeof(*owner->series_bytes)) {
+		stats_count(owner, &owner->series_bytes[series], bytes);
+	}
+}
+
+uint8_t lock_site_find(const char *site) {
+	uintptr_t name = (uintptr_t)site;
+	uint8_t size = sizeof(lock_sites) / sizeof(*lock_sites);
+	uint8_t slot = (uint8_t)((name >> 3) % size);
+	for (uint8_t probe = 0; probe < size; probe++) {
+		uint8_t index = (uint8_t)((slot + probe) % size);
+		uintptr_t current = atomic_load_explicit(&lock_sites[index], memory_order_acquire);
+		if (current == name) {
+			return index;
+		}
+		if (current == 0) {
+			if (atomic_compare_exchange_strong(&lock_sites[index], &current, name) == true || current == name) {
+				return index;
+			}
+		}
+	}
+	return size;
+}
+
+lock_file_t *lock_file_find(const char *file) {
+	uint64_t hash = 14695981039346656037lu;
+	for (const char *ptr = file; *ptr != '\0'; ptr++) {
+		hash = (hash ^ (uint8_t)*ptr) * 1099511628211lu;
+	}
+	hash |= 2;
+
+	uint8_t size = sizeof(lock_files) / sizeof(*lock_files);
+	uint8_t slot = (uint8_t)(hash % size);
+	for (uint8_t probe = 0; probe < 8; probe++) {
+		lock_file_t *lock_file = &lock_files[(slot + probe) % size];
+		uint64_t current = atomic_load_explicit(&lock_file->hash, memory_order_acquire);
+		if (current == hash) {
+			return lock_file;
+		}
+		if (current == 0 && atomic_compare_exchange_strong(&lock_file->hash, &current, 1) == true) {
+			snprintf(lock_file->path, sizeof(lock_file->path), "%s", file);
+			atomic_store_explicit(&lock_file->hash, hash, memory_order_release);
+			return lock_file;
+		}
+	}
+	return NULL;
+}
+
+void stats_lock(const char *site, const char *file, uint8_t series, bool write, uint64_t wait) {
+	shard_t *owner = stats_shard();
+	if (owner == NULL) {
+		return;
+	}
+
+	histogram_record(owner, &owner->locks[(series < series_catalogs ? 0 : 2) + (write == true ? 1 : 0)], wait);
+
+	uint8_t index = lock_site_find(site);
+	if (index < sizeof(owner->sites) / sizeof(*owner->sites)) {
+		histogram_record(owner, &owner->sites[index], wait);
+	}
+
+	if (wait < lock_contended) {
+		return;
+	}
+	lock_file_t *lock_file = lock_file_find(file);
+	if (lock_file == NULL) {
+		atomic_fetch_add_explicit(&lock_files_dropped, 1, memory_order_relaxed);
+		return;
+	}
+	atomic_fetch_add_explicit(&lock_file->waits, 1, memory_order_relaxed);
+	atomic_fetch_add_explicit(&lock_file->wait, wait, memory_order_relaxed);
+	stats_max(&lock_file->max, wait);
+}
+
+void summary_merge(summary_t *summary, histogram_t *histogram) {
+	for (uint8_t index = 0; index < sizeof(summary->buckets) / sizeof(*summary->buckets); index++) {
+		summary->buckets[index] += atomic_load_explicit(&histogram->buckets[index], memory_order_relaxed);
+	}
+	summary->count += atomic_load_explicit(&histogram->count, memory_order_relaxed);
+	summary->sum += atomic_load_explicit(&histogram->sum, memory_order_relaxed);
+	uint64_t max = atomic_load_explicit(&histogram->max, memory_order_relaxed);
+	if (max > summary->max) {
+		summary->max = max;
+	}
+}
+
+uint64_t summary_quantile(summary_t *summary, double quantile) {
+	uint64_t total = 0;
+	for (uint8_t index = 0; index < sizeof(summary->buckets) / sizeof(*summary->buckets); index++) {
+		total += summary->buckets[index];
+	}
+	if (total == 0) {
+		return 0;
+	}
+
+	uint64_t rank = (uint64_t)(quantile * (double)total + 0.5);
+	if (rank == 0) {
+		rank = 1;
+	}
+
+	uint64_t seen = 0;
+	for (uint8_t index = 0; index < sizeof(summary->buckets) / sizeof(*summary->buckets); index++) {
+		seen += summary->buckets[index];
+		if (seen >= rank) {
+			uint64_t value = histogram_value(index);
+			return value < summary->max ? value : summary->max;
+		}
+	}
+	return summary->max;
+}
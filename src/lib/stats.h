@@ -0,0 +1,78 @@
+#pragma once
+
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+typedef struct histogram_t {
+	atomic_uint_fast32_t buckets[240];
+	atomic_uint_fast64_t count;
+	atomic_uint_fast64_t sum;
+	atomic_uint_fast64_t max;
+} histogram_t;
+
+typedef struct stats_route_t {
+	atomic_uint_fast64_t statuses[5];
+	histogram_t latency;
+} stats_route_t;
+
+typedef struct shard_t {
+	atomic_bool owned;
+	atomic_uint_fast64_t device_hits;
+	atomic_uint_fast64_t device_misses;
+	atomic_uint_fast64_t zone_hits;
+	atomic_uint_fast64_t zone_misses;
+	atomic_uint_fast64_t series_bytes[17];
+	histogram_t queue_wait;
+	histogram_t alerter_cycle;
+	histogram_t decode_lag;
+	histogram_t locks[4];
+	histogram_t sites[128];
+	stats_route_t routes[];
+} shard_t;
+
+typedef struct summary_t {
+	uint64_t buckets[240];
+	uint64_t count;
+	uint64_t sum;
+	uint64_t max;
+} summary_t;
+
+typedef struct lock_file_t {
+	atomic_uint_fast64_t hash;
+	char path[96];
+	atomic_uint_fast64_t waits;
+	atomic_uint_fast64_t wait;
+	atomic_uint_fast64_t max;
+} lock_file_t;
+
+extern const char *stats_series[17];
+extern const char *stats_locks[4];
+
+extern atomic_uintptr_t lock_sites[128];
+extern lock_file_t lock_files[64];
+extern atomic_uint_fast64_t lock_files_dropped;
+
+extern shard_t *shards[64];
+extern atomic_uint_fast8_t shards_len;
+extern shard_t *shard_spill;
+extern uint8_t shard_routes;
+
+int stats_init(uint8_t routes_len);
+
+void stats_request(uint8_t route, uint16_t status, uint64_t duration);
+void stats_wait(uint64_t duration);
+void stats_cycle(uint64_t duration);
+void stats_lag(uint64_t duration);
+void stats_device_cache(bool hit);
+void stats_zone_cache(bool hit);
+uint8_t stats_series_find(const char *file);
+void stats_read(uint8_t series, size_t bytes);
+void stats_lock(const char *site, const char *file, uint8_t series, bool write, uint64_t wait);
+
+void stats_max(atomic_uint_fast64_t *max, uint64_t value);
+uint8_t histogram_bucket(uint64_t value);
+
+void summary_merge(summary_t *summary, histogram_t *histogram);
+uint64_t summary_quantile(summary_t *summary, double quantile);
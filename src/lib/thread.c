@@ -1,13 +1,16 @@
 #include "thread.h"
 #include "app.h"
+#include "arena.h"
 #include "config.h"
 #include "error.h"
 #include "logger.h"
+#include "stats.h"
 #include <errno.h>
 #include <stdatomic.h>
 #include <stdbool.h>
 #include <stdint.h>
 #include <stdlib.h>
+#include <time.h>
 
 queue_t queue = {
 		.head = 0,
@@ -20,14 +23,23 @@ queue_t queue = {
 
 thread_pool_t thread_pool = {
 		.size = 0,
+		.spawned = 0,
 		.load = 0,
+		.busy = 0,
+		.wait = 0,
+		.waits = 0,
+		.utilization = 0,
+		.delay = 0,
 		.lock = PTHREAD_MUTEX_INITIALIZER,
 		.scale = PTHREAD_COND_INITIALIZER,
+		.parked = PTHREAD_COND_INITIALIZER,
 		.available = PTHREAD_COND_INITIALIZER,
 		.stopping = false,
 };
 
-void cancel(void *lock) { pthread_mutex_unlock((pthread_mutex_t *)lock); }
+uint64_t elapsed(struct timespec *start, struct timespec *end) {
+	return (uint64_t)((end->tv_sec - start->tv_sec) * 1000000 + (end->tv_nsec - start->tv_nsec) / 1000);
+}
 
 int spawn(worker_t *worker, uint8_t id, void *(*function)(void *),
 					void (*logger)(const char *message, ...) __attribute__((format(printf, 1, 2)))) {
@@ -42,39 +54,9 @@ int spawn(worker_t *worker, uint8_t id, void *(*function)(void *),
 		return -1;
 	}
 
-	uint32_t offset = 0;
-
-	worker->arg.db.row = (uint8_t *)&worker->arg.database_buffer[offset];
 	worker->arg.db.row_len = UINT8_MAX;
-	offset += worker->arg.db.row_len;
-
-	worker->arg.db.alpha = (uint8_t *)&worker->arg.database_buffer[offset];
-	worker->arg.db.alpha_len = (uint16_t)(database_buffer / 16);
-	offset += worker->arg.db.alpha_len;
-
-	worker->arg.db.bravo = (uint8_t *)&worker->arg.database_buffer[offset];
-	worker->arg.db.bravo_len = (uint16_t)(database_buffer / 16);
-	offset += worker->arg.db.bravo_len;
-
-	worker->arg.db.charlie = (uint8_t *)&worker->arg.database_buffer[offset];
-	worker->arg.db.charlie_len = (uint16_t)(database_buffer / 16);
-	offset += worker->arg.db.charlie_len;
-
-	worker->arg.db.delta = (uint8_t *)&worker->arg.database_buffer[offset];
-	worker->arg.db.delta_len = (uint16_t)(database_buffer / 16);
-	offset += worker->arg.db.delta_len;
-
-	worker->arg.db.echo = (uint8_t *)&worker->arg.database_buffer[offset];
-	worker->arg.db.echo_len = (uint16_t)(database_buffer / 16);
-	offset += worker->arg.db.echo_len;
-
-	worker->arg.db.chunk = (uint8_t *)&worker->arg.database_buffer[offset];
-	worker->arg.db.chunk_len = (uint16_t)(database_buffer / 16);
-	offset += worker->arg.db.chunk_len;
-
-	worker->arg.db.table = (uint8_t *)&worker->arg.database_buffer[offset];
-	worker->arg.db.table_len = database_buffer - offset;
-	offset += worker->arg.db.table_len;
+	worker->arg.db.row = (uint8_t *)&worker->arg.database_buffer[database_buffer - worker->arg.db.row_len];
+	arena_init(&worker->arg.db.arena, (uint8_t *)worker->arg.database_buffer, database_buffer - worker->arg.db.row_len);
 
 	worker->arg.request_buffer = malloc(receive_buffer * sizeof(char));
 	if (worker->arg.request_buffer == NULL) {
@@ -99,12 +81,7 @@ int spawn(worker_t *worker, uint8_t id, void *(*function)(void *),
 int join(worker_t *worker, uint8_t id) {
 	trace("joining worker thread %hhu\n", id);
 
-	if (pthread_cancel(worker->thread) == -1) {
-		error("failed to cancel worker thread %hhu because %s\n", id, errno_str());
-		return -1;
-	};
-
-	if (pthread_join(worker->thread, NULL) == -1) {
+	if ((errno = pthread_join(worker->thread, NULL)) != 0) {
 		error("failed to join worker thread %hhu because %s\n", id, errno_str());
 		return -1;
 	}
@@ -120,20 +97,32 @@ void *thread(void *args) {
 	arg_t *arg = (arg_t *)args;
 
 	while (true) {
+		if (arg->id >= atomic_load_explicit(&thread_pool.size, memory_order_acquire)) {
+			trace("worker thread %hhu parking\n", arg->id);
+			pthread_mutex_lock(&thread_pool.lock);
+			while (arg->id >= atomic_load_explicit(&thread_pool.size, memory_order_acquire) &&
+						 atomic_load_explicit(&thread_pool.stopping, memory_order_acquire) == false) {
+				pthread_cond_wait(&thread_pool.parked, &thread_pool.lock);
+			}
+			pthread_mutex_unlock(&thread_pool.lock);
+			trace("worker thread %hhu unparking\n", arg->id);
+		}
+
 		uint8_t head = atomic_load_explicit(&queue.head, memory_order_relaxed);
 		uint8_t tail = atomic_load_explicit(&queue.tail, memory_order_acquire);
 
 		if (head == tail) {
-			pthread_mutex_lock(&queue.lock);
-			pthread_cleanup_push(cancel, &queue.lock);
+			if (atomic_load_explicit(&thread_pool.stopping, memory_order_acquire) == true) {
+				break;
+			}
 
+			pthread_mutex_lock(&queue.lock);
 			while ((head = atomic_load_explicit(&queue.head, memory_order_relaxed)) ==
-						 (tail = atomic_load_explicit(&queue.tail, memory_order_acquire))) {
+								 (tail = atomic_load_explicit(&queue.tail, memory_order_acquire)) &&
+						 arg->id < atomic_load_explicit(&thread_pool.size, memory_order_acquire) &&
+						 atomic_load_explicit(&thread_pool.stopping, memory_order_acquire) == false) {
 				pthread_cond_wait(&queue.filled, &queue.lock);
 			}
-
-			pthread_setcancelstate(PTHREAD_CANCEL_DISABLE, NULL);
-			pthread_cleanup_pop(false);
 			pthread_mutex_unlock(&queue.lock);
 			continue;
 		}
@@ -153,53 +142,134 @@ void *thread(void *args) {
 			pthread_mutex_unlock(&queue.lock);
 		}
 
-		pthread_setcancelstate(PTHREAD_CANCEL_DISABLE, NULL);
+		struct timespec started_at;
+		clock_gettime(CLOCK_MONOTONIC, &started_at);
+		uint64_t wait = elapsed(&task.queued_at, &started_at);
+		atomic_fetch_add_explicit(&thread_pool.wait, wait, memory_order_relaxed);
+		stats_wait(wait);
+		atomic_fetch_add_explicit(&thread_pool.waits, 1, memory_order_relaxed);
+
 		uint8_t load = atomic_fetch_add_explicit(&thread_pool.load, 1, memory_order_relaxed);
 		trace("worker thread %hhu increased thread pool load to %hhu\n", arg->id, load + 1);
 
 		handle(&arg->db, arg->request_buffer, arg->response_buffer, &task.client_sock, &task.client_addr);
 
+		trace("worker thread %hhu used %zu arena bytes peaking at %zu\n", arg->id, arg->db.arena.used, arg->db.arena.peak);
+		arena_reset(&arg->db.arena);
+
 		load = atomic_fetch_sub_explicit(&thread_pool.load, 1, memory_order_release);
 		trace("worker thread %hhu decreased thread pool load to %hhu\n", arg->id, load - 1);
 
+		struct timespec finished_at;
+		clock_gettime(CLOCK_MONOTONIC, &finished_at);
+		atomic_fetch_add_explicit(&thread_pool.busy, elapsed(&started_at, &finished_at), memory_order_relaxed);
+
 		if (atomic_load_explicit(&thread_pool.stopping, memory_order_acquire) == true) {
 			pthread_mutex_lock(&thread_pool.lock);
 			pthread_cond_signal(&thread_pool.available);
 			pthread_mutex_unlock(&thread_pool.lock);
 		}
+	}
 
-		pthread_setcancelstate(PTHREAD_CANCEL_ENABLE, NULL);
-		pthread_testcancel();
+	debug("worker thread %hhu arena peaked at %zu bytes\n", arg->id, arg->db.arena.peak);
+	trace("worker thread %hhu retiring\n", arg->id);
+	return NULL;
+}
+
+int resize(uint8_t size, uint8_t new_size) {
+	if (new_size > size && new_size > atomic_load_explicit(&thread_pool.spawned, memory_order_acquire)) {
+		if (spawn(&thread_pool.workers[size], size, &thread, &error) == -1) {
+			return -1;
+		}
+		atomic_fetch_add_explicit(&thread_pool.spawned, 1, memory_order_release);
 	}
+
+	pthread_mutex_lock(&thread_pool.lock);
+	atomic_store_explicit(&thread_pool.size, new_size, memory_order_release);
+	pthread_cond_broadcast(&thread_pool.parked);
+	pthread_mutex_unlock(&thread_pool.lock);
+
+	if (new_size < size) {
+		pthread_mutex_lock(&queue.lock);
+		pthread_cond_broadcast(&queue.filled);
+		pthread_mutex_unlock(&queue.lock);
+	}
+
+	info("scaled threads from %hhu to %hhu\n", size, new_size);
+	return 0;
 }
 
 void *scaler(void *args) {
 	(void)args;
 
-	while (true) {
+	const float weight = 0.25f;
+	const float grow_utilization = 0.75f;
+	const float shrink_utilization = 0.25f;
+	const float grow_delay = 2000;
+	const float shrink_delay = 500;
+	const uint8_t calm_ticks = 8;
+
+	uint8_t calm = 0;
+	struct timespec ticked_at;
+	clock_gettime(CLOCK_MONOTONIC, &ticked_at);
+	struct timespec deadline;
+	clock_gettime(CLOCK_REALTIME, &deadline);
+	deadline.tv_sec += 1;
+
+	while (atomic_load_explicit(&thread_pool.stopping, memory_order_acquire) == false) {
 		pthread_mutex_lock(&thread_pool.lock);
-		pthread_cond_wait(&thread_pool.scale, &thread_pool.lock);
+		int result = pthread_cond_timedwait(&thread_pool.scale, &thread_pool.lock, &deadline);
 		pthread_mutex_unlock(&thread_pool.lock);
 
+		if (atomic_load_explicit(&thread_pool.stopping, memory_order_acquire) == true) {
+			break;
+		}
+
 		uint8_t load = atomic_load_explicit(&thread_pool.load, memory_order_acquire);
 		uint8_t size = atomic_load_explicit(&thread_pool.size, memory_order_acquire);
 
-		if (load >= size && size < most_workers) {
-			debug("all worker threads currently busy\n");
-			uint8_t new_size = size + 1;
-			if (spawn(&thread_pool.workers[size], size, &thread, &error) == 0) {
-				info("scaled threads from %hhu to %hhu\n", size, new_size);
-				atomic_store_explicit(&thread_pool.size, new_size, memory_order_release);
+		if (result != ETIMEDOUT) {
+			if (load >= size && size < most_workers) {
+				debug("all worker threads currently busy\n");
+				resize(size, size + 1);
+				calm = 0;
 			}
+			continue;
 		}
 
-		if (load <= size / 2 && size > least_workers) {
-			debug("half worker threads currently idle\n");
-			uint8_t new_size = size - 1;
-			if (join(&thread_pool.workers[new_size], new_size) == 0) {
-				info("scaled threads from %hhu to %hhu\n", size, new_size);
-				atomic_store_explicit(&thread_pool.size, new_size, memory_order_release);
+		struct timespec now;
+		clock_gettime(CLOCK_MONOTONIC, &now);
+		uint64_t interval = elapsed(&ticked_at, &now);
+		ticked_at = now;
+		clock_gettime(CLOCK_REALTIME, &deadline);
+		deadline.tv_sec += 1;
+
+		uint64_t busy = atomic_exchange_explicit(&thread_pool.busy, 0, memory_order_relaxed);
+		uint64_t wait = atomic_exchange_explicit(&thread_pool.wait, 0, memory_order_relaxed);
+		uint64_t waits = atomic_exchange_explicit(&thread_pool.waits, 0, memory_order_relaxed);
+
+		float utilization = interval == 0 || size == 0 ? 0 : (float)busy / (float)(interval * size);
+		float delay = waits == 0 ? 0 : (float)wait / (float)waits;
+		thread_pool.utilization += weight * (utilization - thread_pool.utilization);
+		thread_pool.delay += weight * (delay - thread_pool.delay);
+		trace("thread pool utilization %.2f delay %.0fus\n", thread_pool.utilization, thread_pool.delay);
+
+		if (waits > 0 && (thread_pool.utilization > grow_utilization || thread_pool.delay > grow_delay) && size < most_workers) {
+			debug("worker threads saturated\n");
+			resize(size, size + 1);
+			calm = 0;
+		} else if (thread_pool.utilization < shrink_utilization && thread_pool.delay < shrink_delay && size > least_workers) {
+			calm += 1;
+			if (calm >= calm_ticks) {
+				debug("worker threads mostly idle\n");
+				resize(size, size - 1);
+				calm = 0;
 			}
+		} else {
+			calm = 0;
 		}
 	}
+
+	trace("scaler thread retiring\n");
+	return NULL;
 }
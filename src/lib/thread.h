@@ -5,10 +5,12 @@
 #include <pthread.h>
 #include <stdatomic.h>
 #include <stdint.h>
+#include <time.h>
 
 typedef struct task_t {
 	int client_sock;
 	struct sockaddr_in client_addr;
+	struct timespec queued_at;
 } task_t;
 
 typedef struct queue_t {
@@ -40,15 +42,24 @@ typedef struct thread_pool_t {
 	pthread_t scaler;
 	worker_t *workers;
 	atomic_uint_fast8_t size;
+	atomic_uint_fast8_t spawned;
 	atomic_uint_fast8_t load;
+	atomic_uint_fast64_t busy;
+	atomic_uint_fast64_t wait;
+	atomic_uint_fast32_t waits;
+	float utilization;
+	float delay;
 	pthread_mutex_t lock;
 	pthread_cond_t scale;
+	pthread_cond_t parked;
 	pthread_cond_t available;
 	atomic_bool stopping;
 } thread_pool_t;
 
 extern struct thread_pool_t thread_pool;
 
+uint64_t elapsed(struct timespec *start, struct timespec *end);
+
 int spawn(worker_t *worker, uint8_t id, void *(*function)(void *),
 					void (*logger)(const char *message, ...) __attribute__((format(printf, 1, 2))));
 
@@ -1,15 +1,22 @@
 #include "api/cache.h"
 #include "api/drop.h"
 #include "api/init.h"
+#include "api/router.h"
 #include "api/seed.h"
 #include "api/wipe.h"
 #include "app/alert.h"
+#include "app/bundle.h"
+#include "app/decode.h"
 #include "app/page.h"
+#include "app/watch.h"
+#include "lib/arena.h"
+#include "lib/capture.h"
 #include "lib/config.h"
 #include "lib/error.h"
 #include "lib/format.h"
 #include "lib/logger.h"
 #include "lib/octet.h"
+#include "lib/stats.h"
 #include "lib/thread.h"
 #include <arpa/inet.h>
 #include <errno.h>
@@ -17,6 +24,7 @@
 #include <signal.h>
 #include <stdatomic.h>
 #include <stdbool.h>
+#include <stddef.h>
 #include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
@@ -58,12 +66,15 @@ int main(int argc, char *argv[]) {
 		info("--emit-alerts         -ea  evaluate and emit alerts         (%s)\n", human_bool(emit_alerts));
 		info("--alert-interval      -ai  seconds between alert checks     (%hhu)\n", alert_interval);
 		info("--alert-lookback      -al  seconds to look back for alerts  (%u)\n", alert_lookback);
+		info("--defer-decode        -dc  ack uplinks before decoding      (%s)\n", human_bool(defer_decode));
+		info("--decode-backlog      -dq  most uplinks awaiting decode     (%hu)\n", decode_backlog);
 		info("--devices-size        -ds  most devices in cache            (%hhu)\n", devices_size);
 		info("--zones-size          -zs  most zones in cache              (%hhu)\n", zones_size);
+		info("--watch-pages         -wp  reload pages on file changes     (%s)\n", human_bool(watch_pages));
 		info("--bwt-key             -bk  random bytes for bwt signing     (%s)\n", bwt_key);
 		info("--bwt-ttl             -bt  time to live for bwt expiry      (%u)\n", bwt_ttl);
 		info("--database-directory  -dd  path to database directory       (%s)\n", database_directory);
-		info("--database-buffer     -db  most bytes in database buffer    (%u)\n", database_buffer);
+		info("--database-buffer     -db  bytes in database arena block    (%u)\n", database_buffer);
 		info("--receive-timeout     -rt  seconds to wait for receiving    (%hhu)\n", receive_timeout);
 		info("--send-timeout        -st  seconds to wait for sending      (%hhu)\n", send_timeout);
 		info("--receive-packets     -rp  most packets allowed to receive  (%hhu)\n", receive_packets);
@@ -73,6 +84,13 @@ int main(int argc, char *argv[]) {
 		info("--log-level           -ll  logging verbosity to print       (%s)\n", human_log_level(log_level));
 		info("--log-requests        -lq  log incoming requests            (%s)\n", human_bool(log_requests));
 		info("--log-responses       -ls  log outgoing responses           (%s)\n", human_bool(log_responses));
+		info("--slow-log            -sl  file to append slow requests to  (%s)\n", slow_log[0] == '\0' ? "none" : slow_log);
+		info("--slow-threshold      -sq  milliseconds for a slow request  (%hu)\n", slow_threshold);
+		info("--capture             -cp  file to record raw requests to   (%s)\n", capture[0] == '\0' ? "none" : capture);
+		info("--seed-devices        -sd  devices to seed or 0 for random  (%hu)\n", seed_devices);
+		info("--seed-days           -sy  days of history to seed          (%hu)\n", seed_days);
+		info("--seed-cadence        -sc  seconds between seeded rows      (%hu)\n", seed_cadence);
+		info("--bundle              -bd  file to write bundled pages to   (%s)\n", bundle_file[0] == '\0' ? "none" : bundle_file);
 		exit(0);
 	}
 
@@ -89,19 +107,23 @@ int main(int argc, char *argv[]) {
 		exit(1);
 	}
 
+	if (cmds & 0x08) {
+		page_init();
+		if (bundle(bundle_file) != 0) {
+			fatal("failed to bundle pages\n");
+			exit(1);
+		}
+	}
+
 	if (cmds != 0x00) {
 		uint8_t row[255];
-		uint8_t chunk[2048];
-		uint8_t table[16384];
+		_Alignas(max_align_t) uint8_t buffer[16384];
 		octet_t db = {
 				.directory = database_directory,
 				.row = row,
 				.row_len = sizeof(row),
-				.chunk = chunk,
-				.chunk_len = sizeof(chunk),
-				.table = table,
-				.table_len = sizeof(table),
 		};
+		arena_init(&db.arena, buffer, sizeof(buffer));
 
 		if (cmds & 0x10 && init(&db) != 0) {
 			fatal("failed to init database\n");
@@ -128,8 +150,43 @@ int main(int argc, char *argv[]) {
 
 	page_init();
 
+	if (route_init() == -1) {
+		fatal("failed to compile routes\n");
+		exit(1);
+	}
+
+	if (slow_log[0] != '\0' && slow_open(slow_log) == -1) {
+		fatal("failed to open slow log %s because %s\n", slow_log, errno_str());
+		exit(1);
+	}
+
+	if (capture[0] != '\0' && capture_open(capture) == -1) {
+		fatal("failed to open capture %s because %s\n", capture, errno_str());
+		exit(1);
+	}
+
+	if (stats_init(routes_len) == -1) {
+		fatal("failed to initialize stats\n");
+		exit(1);
+	}
+
+	trace("spawning scribe thread\n");
+	if (logger_start() == -1) {
+		fatal("failed to spawn scribe because %s\n", errno_str());
+		exit(1);
+	}
+
 	info("starting warden application\n");
 
+	if (watch_pages == true && bundles_len < pages_len && watch_init() == 0) {
+		trace("spawning watcher thread\n");
+		if ((errno = pthread_create(&watcher_thread, NULL, &watcher, NULL)) != 0) {
+			fatal("failed to spawn watcher because %s\n", errno_str());
+			exit(1);
+		}
+		watching = true;
+	}
+
 	cache.devices = malloc(devices_size * sizeof(*cache.devices));
 	if (cache.devices == NULL) {
 		fatal("failed to allocate %zu bytes for cache because %s\n", devices_size * sizeof(*cache.devices), errno_str());
@@ -166,11 +223,12 @@ int main(int argc, char *argv[]) {
 		exit(1);
 	}
 
+	atomic_store_explicit(&thread_pool.size, least_workers, memory_order_release);
 	for (uint8_t index = 0; index < least_workers; index++) {
-		if (spawn(&thread_pool.workers[index], thread_pool.size, &thread, &fatal) == -1) {
+		if (spawn(&thread_pool.workers[index], index, &thread, &fatal) == -1) {
 			exit(1);
 		}
-		thread_pool.size++;
+		thread_pool.spawned++;
 	}
 
 	info("spawned %hhu worker threads\n", least_workers);
@@ -189,6 +247,22 @@ int main(int argc, char *argv[]) {
 		}
 	}
 
+	if (defer_decode == true) {
+		decode_queue.pending = malloc(decode_backlog * sizeof(*decode_queue.pending));
+		decoder_buffer = malloc(database_buffer * sizeof(char));
+		if (decode_queue.pending == NULL || decoder_buffer == NULL) {
+			fatal("failed to allocate %zu bytes for decoder because %s\n",
+						decode_backlog * sizeof(*decode_queue.pending) + database_buffer, errno_str());
+			exit(1);
+		}
+
+		trace("spawning decoder thread\n");
+		if ((errno = pthread_create(&decoder_thread, NULL, &decoder, (void *)&decoder_octet)) != 0) {
+			fatal("failed to spawn decoder because %s\n", errno_str());
+			exit(1);
+		}
+	}
+
 	if ((server_sock = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP)) == -1) {
 		fatal("failed to create socket because %s\n", errno_str());
 		exit(1);
@@ -215,7 +289,6 @@ int main(int argc, char *argv[]) {
 
 	info("listening on %s:%d\n", inet_ntoa(server_addr.sin_addr), ntohs(server_addr.sin_port));
 
-	time_t scaled = 0;
 	while (true) {
 		uint8_t tail = atomic_load_explicit(&queue.tail, memory_order_relaxed);
 		uint8_t head = atomic_load_explicit(&queue.head, memory_order_acquire);
@@ -233,8 +306,6 @@ int main(int argc, char *argv[]) {
 			tail = atomic_load_explicit(&queue.tail, memory_order_relaxed);
 		}
 
-		time_t now = time(NULL);
-
 		uint8_t pool_load = atomic_load_explicit(&thread_pool.load, memory_order_relaxed);
 		uint8_t pool_size = atomic_load_explicit(&thread_pool.size, memory_order_relaxed);
 
@@ -242,14 +313,6 @@ int main(int argc, char *argv[]) {
 			pthread_mutex_lock(&thread_pool.lock);
 			pthread_cond_signal(&thread_pool.scale);
 			pthread_mutex_unlock(&thread_pool.lock);
-			scaled = now;
-		}
-
-		if (pool_load <= pool_size / 2 && pool_size > least_workers && now - scaled >= 2) {
-			pthread_mutex_lock(&thread_pool.lock);
-			pthread_cond_signal(&thread_pool.scale);
-			pthread_mutex_unlock(&thread_pool.lock);
-			scaled = now;
 		}
 
 		struct sockaddr_in client_addr;
@@ -269,6 +332,7 @@ int main(int argc, char *argv[]) {
 
 		queue.tasks[tail].client_sock = client_sock;
 		memcpy(&queue.tasks[tail].client_addr, &client_addr, sizeof(client_addr));
+		clock_gettime(CLOCK_MONOTONIC, &queue.tasks[tail].queued_at);
 		atomic_store_explicit(&queue.tail, (uint8_t)((tail + 1) % queue_size), memory_order_relaxed);
 
 		uint8_t size = atomic_fetch_add_explicit(&queue.size, 1, memory_order_relaxed);
@@ -300,15 +364,36 @@ int main(int argc, char *argv[]) {
 		free(alerter_buffer);
 	}
 
+	if (watching == true) {
+		trace("joining watcher thread\n");
+		pthread_cancel(watcher_thread);
+		pthread_join(watcher_thread, NULL);
+
+		watch_close();
+	}
+
+	pthread_mutex_lock(&thread_pool.lock);
+	pthread_cond_broadcast(&thread_pool.scale);
+	pthread_cond_broadcast(&thread_pool.parked);
+	pthread_mutex_unlock(&thread_pool.lock);
+
 	trace("joining scaler thread\n");
-	pthread_cancel(thread_pool.scaler);
 	pthread_join(thread_pool.scaler, NULL);
 
-	for (uint8_t index = 0; index < thread_pool.size; index++) {
+	for (uint8_t index = 0; index < thread_pool.spawned; index++) {
 		join(&thread_pool.workers[index], index);
 	}
 	free(thread_pool.workers);
 
+	if (defer_decode == true) {
+		trace("draining %u pending uplinks\n", (uint16_t)atomic_load_explicit(&decode_queue.size, memory_order_relaxed));
+		decoder_stop();
+		pthread_join(decoder_thread, NULL);
+
+		free(decode_queue.pending);
+		free(decoder_buffer);
+	}
+
 	free(cache.devices);
 	free(cache.zones);
 
@@ -318,5 +403,10 @@ int main(int argc, char *argv[]) {
 	page_free();
 
 	info("graceful shutdown complete\n");
+
+	capture_close();
+
+	trace("joining scribe thread\n");
+	logger_close();
 	exit(0);
 }